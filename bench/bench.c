@@ -0,0 +1,1590 @@
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cymb/assembly.h"
+#include "cymb/diagnostic.h"
+#include "cymb/elf.h"
+#include "cymb/lex.h"
+#include "cymb/memory.h"
+#include "cymb/tree.h"
+#include "cymb/version.h"
+
+/*
+ * A growable string used to generate corpora.
+ *
+ * Fields:
+ * - string: The string.
+ * - length: The length of the string.
+ * - capacity: The capacity of the string.
+ */
+typedef struct CymbBenchString
+{
+	char* string;
+	size_t length;
+	size_t capacity;
+} CymbBenchString;
+
+/*
+ * A corpus generator.
+ *
+ * Parameters:
+ * - string: The string to append to.
+ * - size: The approximate size of the corpus.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if the string could not be grown.
+ */
+typedef CymbResult (*CymbBenchGenerator)(CymbBenchString* string, size_t size);
+
+/*
+ * A corpus.
+ *
+ * Fields:
+ * - name: The name of the corpus.
+ * - generator: The generator of the corpus.
+ * - isAssembly: Flag indicating if the source is assembly code.
+ * - isPunctuators: Flag indicating if the source only has punctuators, which cannot be parsed.
+ * - string: The source.
+ * - length: The length of the source.
+ * - tokens: The tokens of the source, for C corpora.
+ * - codes: The codes of the source, for assembly corpora.
+ * - codeCount: The number of codes.
+ * - keys: The lines of the source, for key corpora.
+ * - keyCount: The number of keys, 0 for other corpora.
+ */
+typedef struct CymbBenchCorpus
+{
+	const char* name;
+	CymbBenchGenerator generator;
+	bool isAssembly;
+	bool isPunctuators;
+
+	char* string;
+	size_t length;
+
+	CymbTokenList tokens;
+
+	uint32_t* codes;
+	size_t codeCount;
+
+	CymbStringView* keys;
+	size_t keyCount;
+} CymbBenchCorpus;
+
+/*
+ * The amounts of work done by a run.
+ *
+ * Fields:
+ * - bytes: The number of bytes of input.
+ * - tokens: The number of tokens.
+ * - nodes: The number of nodes.
+ * - codes: The number of codes.
+ * - keys: The number of map keys.
+ */
+typedef struct CymbBenchCounts
+{
+	size_t bytes;
+	size_t tokens;
+	size_t nodes;
+	size_t codes;
+	size_t keys;
+} CymbBenchCounts;
+
+/*
+ * A benchmark function.
+ *
+ * Parameters:
+ * - corpus: The corpus.
+ * - threadCount: The maximum number of threads, 0 for the serial version.
+ * - arena: An arena, cleared after each run.
+ * - seconds: Set to the time of the measured section.
+ * - counts: Set to the amounts of work done.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - An error code otherwise.
+ */
+typedef CymbResult (*CymbBenchFunction)(const CymbBenchCorpus* corpus, unsigned int threadCount, CymbArena* arena, double* seconds, CymbBenchCounts* counts);
+
+/*
+ * The benchmark options.
+ *
+ * Fields:
+ * - size: The approximate size of each corpus.
+ * - warmupCount: The number of runs before measuring.
+ * - repetitionCount: The number of measured runs.
+ * - maxThreadCount: The maximum number of threads for the parallel lexer and parser.
+ */
+typedef struct CymbBenchOptions
+{
+	size_t size;
+	unsigned int warmupCount;
+	unsigned int repetitionCount;
+	unsigned int maxThreadCount;
+} CymbBenchOptions;
+
+/*
+ * Append a formatted string.
+ *
+ * Parameters:
+ * - string: The string.
+ * - format: The format string.
+ * - The arguments of the format string.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if the string could not be grown.
+ */
+static CymbResult cymbBenchAppend(CymbBenchString* const string, const char* const format, ...)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	va_list lengthArguments, stringArguments;
+	va_start(lengthArguments);
+	va_copy(stringArguments, lengthArguments);
+
+	const int length = vsnprintf(nullptr, 0, format, lengthArguments);
+	va_end(lengthArguments);
+
+	if(length < 0)
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto end;
+	}
+
+	if(string->capacity - string->length <= (size_t)length)
+	{
+		size_t capacity = string->capacity == 0 ? 0x10000 : string->capacity;
+		while(capacity - string->length <= (size_t)length)
+		{
+			capacity *= 2;
+		}
+
+		char* const newString = realloc(string->string, capacity);
+		if(!newString)
+		{
+			result = CYMB_OUT_OF_MEMORY;
+			goto end;
+		}
+
+		string->string = newString;
+		string->capacity = capacity;
+	}
+
+	vsnprintf(string->string + string->length, string->capacity - string->length, format, stringArguments);
+	string->length += length;
+
+	end:
+	va_end(stringArguments);
+	return result;
+}
+
+/*
+ * Get the next pseudo-random number.
+ *
+ * Parameters:
+ * - state: The generator state.
+ *
+ * Returns:
+ * - A pseudo-random number.
+ */
+static uint32_t cymbBenchRandom(uint32_t* const state)
+{
+	*state = *state * 1664525 + 1013904223;
+
+	return *state >> 8;
+}
+
+/*
+ * Generate many small functions.
+ */
+static CymbResult cymbBenchGenerateFunctions(CymbBenchString* const string, const size_t size)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	uint32_t state = 1;
+	for(unsigned int index = 0; result == CYMB_SUCCESS && string->length < size; ++index)
+	{
+		const uint32_t value = cymbBenchRandom(&state) % 1000;
+
+		result = cymbBenchAppend(
+			string,
+			"int function_%u(int a, int b)\n"
+			"{\n"
+			"\t/* Accumulate the arguments. */\n"
+			"\tint c = a * %u + b;\n"
+			"\twhile(c > %u)\n"
+			"\t{\n"
+			"\t\tc -= b + 0x%X;\n"
+			"\t\tvalues[c %% 8] = c;\n"
+			"\t}\n"
+			"\treturn c + function_%u(a, b);\n"
+			"}\n\n",
+			index, value, value * 3, value + 1, index / 2
+		);
+	}
+
+	return result;
+}
+
+/*
+ * Generate deeply nested statements and expressions.
+ */
+static CymbResult cymbBenchGenerateNesting(CymbBenchString* const string, const size_t size)
+{
+	constexpr int depth = 32;
+
+	CymbResult result = CYMB_SUCCESS;
+
+	for(unsigned int index = 0; result == CYMB_SUCCESS && string->length < size; ++index)
+	{
+		result = cymbBenchAppend(string, "int nested_%u(int a, int b)\n{\n", index);
+
+		for(int level = 0; result == CYMB_SUCCESS && level < depth; ++level)
+		{
+			result = cymbBenchAppend(string, "%*swhile(a > %d)\n%*s{\n", level, "", level, level, "");
+		}
+
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, "%*sa = %.*sa", depth, "", depth, "((((((((((((((((((((((((((((((((");
+		}
+		for(int level = 0; result == CYMB_SUCCESS && level < depth; ++level)
+		{
+			result = cymbBenchAppend(string, " + %d) * b", level);
+		}
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, ";\n");
+		}
+
+		for(int level = depth - 1; result == CYMB_SUCCESS && level >= 0; --level)
+		{
+			result = cymbBenchAppend(string, "%*s}\n", level, "");
+		}
+
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, "return a;\n}\n\n");
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Generate functions made of a single, very deep nest of blocks and calls.
+ * Parsing them is linear only if matching delimiters are not searched for again at each level.
+ *
+ * Parameters:
+ * - string: The string to append to.
+ * - size: The minimum size of the string.
+ * - depth: The nesting depth.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if the string could not be grown.
+ */
+static CymbResult cymbBenchGenerateDeepNesting(CymbBenchString* const string, const size_t size, const unsigned int depth)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	for(unsigned int index = 0; result == CYMB_SUCCESS && string->length < size; ++index)
+	{
+		result = cymbBenchAppend(string, "int deep_%u(int a)\n{\n", index);
+
+		for(unsigned int level = 0; result == CYMB_SUCCESS && level < depth; ++level)
+		{
+			result = cymbBenchAppend(string, "while(a > %u) {\n", level);
+		}
+
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, "a = ");
+		}
+		for(unsigned int level = 0; result == CYMB_SUCCESS && level < depth; ++level)
+		{
+			result = cymbBenchAppend(string, "f(a, ");
+		}
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, "a");
+		}
+		for(unsigned int level = 0; result == CYMB_SUCCESS && level < depth; ++level)
+		{
+			result = cymbBenchAppend(string, ")");
+		}
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, ";\n");
+		}
+
+		for(unsigned int level = 0; result == CYMB_SUCCESS && level < depth; ++level)
+		{
+			result = cymbBenchAppend(string, "}\n");
+		}
+
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, "return a;\n}\n\n");
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Generate functions nested 1000 levels deep.
+ */
+static CymbResult cymbBenchGenerateDeepNesting1000(CymbBenchString* const string, const size_t size)
+{
+	return cymbBenchGenerateDeepNesting(string, size, 1000);
+}
+
+/*
+ * Generate functions nested 10000 levels deep.
+ */
+static CymbResult cymbBenchGenerateDeepNesting10000(CymbBenchString* const string, const size_t size)
+{
+	return cymbBenchGenerateDeepNesting(string, size, 10000);
+}
+
+/*
+ * Generate long expressions.
+ */
+static CymbResult cymbBenchGenerateExpressions(CymbBenchString* const string, const size_t size)
+{
+	constexpr unsigned int termCount = 256;
+	static const char* const operators[] = {"+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^", "<", ">=", "==", "&&", "||"};
+
+	CymbResult result = CYMB_SUCCESS;
+
+	uint32_t state = 2;
+	for(unsigned int index = 0; result == CYMB_SUCCESS && string->length < size; ++index)
+	{
+		result = cymbBenchAppend(string, "int expression_%u(int a, int b)\n{\n\treturn a", index);
+
+		for(unsigned int term = 0; result == CYMB_SUCCESS && term < termCount; ++term)
+		{
+			const uint32_t value = cymbBenchRandom(&state);
+			const char* const operator = operators[value % CYMB_LENGTH(operators)];
+
+			switch(value >> 4 & 0b11)
+			{
+				case 0:
+					result = cymbBenchAppend(string, " %s %u", operator, value & 0xFF);
+					break;
+
+				case 1:
+					result = cymbBenchAppend(string, " %s -b", operator);
+					break;
+
+				case 2:
+					result = cymbBenchAppend(string, " %s array[a]", operator);
+					break;
+
+				default:
+					result = cymbBenchAppend(string, " %s call(a, %u)", operator, value & 0xF);
+					break;
+			}
+		}
+
+		if(result == CYMB_SUCCESS)
+		{
+			result = cymbBenchAppend(string, ";\n}\n\n");
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Generate punctuators separated by spaces.
+ */
+static CymbResult cymbBenchGeneratePunctuators(CymbBenchString* const string, const size_t size)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	uint32_t state = 3;
+	for(unsigned int index = 1; result == CYMB_SUCCESS && string->length < size; ++index)
+	{
+		const CymbPunctuator* const punctuator = &cymbPunctuators[cymbBenchRandom(&state) % cymbPunctuatorCount];
+
+		result = cymbBenchAppend(string, "%s%c", punctuator->string.string, index % 16 == 0 ? '\n' : ' ');
+	}
+
+	return result;
+}
+
+/*
+ * Generate dense assembly code.
+ */
+static CymbResult cymbBenchGenerateAssembly(CymbBenchString* const string, const size_t size)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	uint32_t state = 3;
+	for(unsigned int index = 0; result == CYMB_SUCCESS && string->length < size; ++index)
+	{
+		const uint32_t value = cymbBenchRandom(&state);
+		const unsigned int first = value % 31;
+		const unsigned int second = (value >> 5) % 31;
+		const unsigned int third = (value >> 10) % 31;
+
+		if(index % 64 == 0)
+		{
+			result = cymbBenchAppend(string, "block_%u:\n", index / 64);
+			if(result != CYMB_SUCCESS)
+			{
+				break;
+			}
+		}
+
+		switch(value >> 15 & 0b111)
+		{
+			case 0:
+				result = cymbBenchAppend(string, "\tABS X%u, X%u\n", first, second);
+				break;
+
+			case 1:
+				result = cymbBenchAppend(string, "\tADC W%u, W%u, W%u\n", first, second, third);
+				break;
+
+			case 2:
+				result = cymbBenchAppend(string, "\tADCS X%u, X%u, X%u\n", first, second, third);
+				break;
+
+			case 3:
+				result = cymbBenchAppend(string, "\tADD X%u, X%u, X%u\n", first, second, third);
+				break;
+
+			case 4:
+				result = cymbBenchAppend(string, "\tADD X%u, X%u, W%u, SXTH #%u\n", first, second, third, value % 5);
+				break;
+
+			case 5:
+				result = cymbBenchAppend(string, "\tADD W%u, W%u, #%u\n", first, second, value >> 12);
+				break;
+
+			case 6:
+				result = cymbBenchAppend(string, "\tADD X%u, X%u, #%u, LSL #12\n", first, second, value >> 12);
+				break;
+
+			default:
+				result = cymbBenchAppend(string, "\tADR X%u, block_%u\n", first, index / 64);
+				break;
+		}
+	}
+
+	// The assembler expects an instruction after each line break.
+	while(string->length > 0 && string->string[string->length - 1] == '\n')
+	{
+		--string->length;
+		string->string[string->length] = '\0';
+	}
+
+	return result;
+}
+
+/*
+ * Generate unique identifiers, one per line, and split them into keys.
+ *
+ * Parameters:
+ * - corpus: The corpus, with its key count set.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+static CymbResult cymbBenchGenerateKeys(CymbBenchCorpus* const corpus)
+{
+	static const char* const prefixes[] = {"value", "count", "node", "buffer", "index", "result", "token", "symbol"};
+
+	CymbResult result = CYMB_SUCCESS;
+
+	CymbBenchString string = {};
+	uint32_t state = 1;
+
+	for(size_t keyIndex = 0; keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		result = cymbBenchAppend(&string, "%s_%zu\n", prefixes[cymbBenchRandom(&state) % CYMB_LENGTH(prefixes)], keyIndex);
+		if(result != CYMB_SUCCESS)
+		{
+			goto end;
+		}
+	}
+
+	corpus->keys = malloc(corpus->keyCount * sizeof(corpus->keys[0]));
+	if(!corpus->keys)
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto end;
+	}
+
+	const char* line = string.string;
+	for(size_t keyIndex = 0; keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		const char* const end = strchr(line, '\n');
+		corpus->keys[keyIndex] = (CymbStringView){line, end - line};
+		line = end + 1;
+	}
+
+	end:
+	corpus->string = string.string;
+	corpus->length = string.length;
+
+	return result;
+}
+
+/*
+ * A pair of the chained map the open-addressing map replaced, kept as a baseline.
+ *
+ * Fields:
+ * - key: The key.
+ * - element: The element.
+ * - next: The next pair of the bin.
+ */
+typedef struct CymbBenchChainedPair
+{
+	CymbStringView key;
+	uint32_t element;
+	struct CymbBenchChainedPair* next;
+} CymbBenchChainedPair;
+
+/*
+ * The chained map.
+ *
+ * Fields:
+ * - bins: The bins.
+ * - binCount: The number of bins.
+ */
+typedef struct CymbBenchChainedMap
+{
+	CymbBenchChainedPair* bins;
+	size_t binCount;
+} CymbBenchChainedMap;
+
+/*
+ * Store an element in a chained map.
+ *
+ * Parameters:
+ * - map: The map.
+ * - arena: The arena used for allocations.
+ * - key: The key.
+ * - element: The element.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+static CymbResult cymbBenchChainedStore(const CymbBenchChainedMap* const map, CymbArena* const arena, const CymbStringView key, const uint32_t element)
+{
+	CymbBenchChainedPair* pair = &map->bins[cymbMurmur3((const unsigned char*)key.string, key.length) % map->binCount];
+	if(!pair->key.string)
+	{
+		*pair = (CymbBenchChainedPair){key, element, nullptr};
+		return CYMB_SUCCESS;
+	}
+
+	while(true)
+	{
+		if(pair->key.length == key.length && memcmp(pair->key.string, key.string, key.length) == 0)
+		{
+			pair->element = element;
+			return CYMB_SUCCESS;
+		}
+
+		if(!pair->next)
+		{
+			break;
+		}
+		pair = pair->next;
+	}
+
+	CymbBenchChainedPair* const next = cymbArenaAllocate(arena, sizeof(*next), alignof(typeof(*next)));
+	if(!next)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+	*next = (CymbBenchChainedPair){key, element, nullptr};
+
+	pair->next = next;
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Read an element from a chained map.
+ *
+ * Parameters:
+ * - map: The map.
+ * - key: The key.
+ *
+ * Returns:
+ * - A pointer to the element if it was found.
+ * - nullptr if the element was not found.
+ */
+static const uint32_t* cymbBenchChainedRead(const CymbBenchChainedMap* const map, const CymbStringView key)
+{
+	const CymbBenchChainedPair* pair = &map->bins[cymbMurmur3((const unsigned char*)key.string, key.length) % map->binCount];
+	if(!pair->key.string)
+	{
+		return nullptr;
+	}
+
+	for(; pair; pair = pair->next)
+	{
+		if(pair->key.length == key.length && memcmp(pair->key.string, key.string, key.length) == 0)
+		{
+			return &pair->element;
+		}
+	}
+
+	return nullptr;
+}
+
+/*
+ * Get the current time.
+ *
+ * Returns:
+ * - The current time in seconds.
+ */
+static double cymbBenchTime(void)
+{
+	struct timespec time;
+	timespec_get(&time, TIME_UTC);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+/*
+ * Benchmark the lexer.
+ */
+static CymbResult cymbBenchLex(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	CymbInterner interner;
+	CymbResult result = cymbInternerCreate(&interner, arena);
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
+	}
+
+	CymbDiagnosticList diagnostics;
+	cymbDiagnosticListCreate(&diagnostics, arena, corpus->name, 8);
+
+	CymbTokenList tokens;
+
+	const double start = cymbBenchTime();
+	if(threadCount == 0)
+	{
+		result = cymbLex(corpus->string, CYMB_C23, &interner, &tokens, &diagnostics);
+	}
+	else
+	{
+		result = cymbLexParallel(corpus->string, CYMB_C23, threadCount, &interner, &tokens, &diagnostics);
+	}
+	*seconds = cymbBenchTime() - start;
+
+	if(result == CYMB_SUCCESS)
+	{
+		*counts = (CymbBenchCounts){
+			.bytes = corpus->length,
+			.tokens = tokens.count
+		};
+		cymbFreeTokenList(&tokens);
+	}
+
+	cymbDiagnosticListFree(&diagnostics);
+	cymbInternerFree(&interner);
+
+	return result;
+}
+
+/*
+ * Benchmark the parser.
+ */
+static CymbResult cymbBenchParse(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	CymbDiagnosticList diagnostics;
+	cymbDiagnosticListCreate(&diagnostics, arena, corpus->name, 8);
+	cymbDiagnosticListSetSource(&diagnostics, corpus->string);
+
+	CymbTree tree;
+
+	CymbResult result;
+
+	const double start = cymbBenchTime();
+	if(threadCount == 0)
+	{
+		result = cymbParse(&corpus->tokens, &tree, &diagnostics);
+	}
+	else
+	{
+		result = cymbParseParallel(&corpus->tokens, threadCount, &tree, &diagnostics);
+	}
+	*seconds = cymbBenchTime() - start;
+
+	if(result == CYMB_SUCCESS)
+	{
+		*counts = (CymbBenchCounts){
+			.bytes = corpus->length,
+			.tokens = corpus->tokens.count,
+			.nodes = tree.nodeCount
+		};
+		cymbFreeTree(&tree);
+	}
+
+	cymbDiagnosticListFree(&diagnostics);
+
+	return result;
+}
+
+/*
+ * Compare a string to a punctuator, as the lexer did before it switched on the first character.
+ */
+static int cymbBenchComparePunctuator(const void* const stringVoid, const void* const punctuatorVoid)
+{
+	const char* const string = stringVoid;
+	const CymbPunctuator* const punctuator = punctuatorVoid;
+
+	return strncmp(punctuator->string.string, string, punctuator->string.length);
+}
+
+/*
+ * Match a punctuator by scanning the punctuators in order, as the lexer did before it switched on the first character.
+ */
+static CymbResult cymbBenchParsePunctuatorLinear(CymbReader* const reader, CymbToken* const token, CymbConstant* const constant, CymbDiagnosticList* const diagnostics)
+{
+	(void)constant;
+	(void)diagnostics;
+
+	const CymbPunctuator* const punctuator = cymbFind(reader->string, cymbPunctuators, cymbPunctuatorCount, sizeof(cymbPunctuators[0]), cymbBenchComparePunctuator);
+	if(!punctuator)
+	{
+		return CYMB_NO_MATCH;
+	}
+
+	token->type = punctuator->type;
+	token->length = punctuator->string.length;
+
+	cymbReaderSkip(reader, punctuator->string.length);
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Match every punctuator of a corpus.
+ *
+ * Parameters:
+ * - corpus: The corpus.
+ * - function: The punctuator function.
+ * - seconds: Set to the time of the measured section.
+ * - counts: Set to the amounts of work done.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_NO_MATCH if a punctuator was not matched.
+ */
+static CymbResult cymbBenchPunctuatorCorpus(const CymbBenchCorpus* const corpus, const CymbLexFunction function, double* const seconds, CymbBenchCounts* const counts)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	CymbReader reader;
+	cymbReaderCreateLazy(corpus->string, &reader);
+
+	size_t tokenCount = 0;
+
+	const double start = cymbBenchTime();
+	while(true)
+	{
+		cymbReaderSkipSpaces(&reader);
+		if(*reader.string == '\0')
+		{
+			break;
+		}
+
+		CymbToken token;
+		result = function(&reader, &token, nullptr, nullptr);
+		if(result != CYMB_SUCCESS)
+		{
+			break;
+		}
+		++tokenCount;
+	}
+	*seconds = cymbBenchTime() - start;
+
+	*counts = (CymbBenchCounts){
+		.bytes = corpus->length,
+		.tokens = tokenCount
+	};
+
+	return result;
+}
+
+/*
+ * Benchmark the punctuator switch of the lexer.
+ */
+static CymbResult cymbBenchPunctuator(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+	(void)arena;
+
+	return cymbBenchPunctuatorCorpus(corpus, cymbParsePunctuator, seconds, counts);
+}
+
+/*
+ * Benchmark the linear punctuator scan.
+ */
+static CymbResult cymbBenchPunctuatorLinear(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+	(void)arena;
+
+	return cymbBenchPunctuatorCorpus(corpus, cymbBenchParsePunctuatorLinear, seconds, counts);
+}
+
+/*
+ * Benchmark the assembler.
+ */
+static CymbResult cymbBenchAssemble(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+
+	CymbDiagnosticList diagnostics;
+	cymbDiagnosticListCreate(&diagnostics, arena, corpus->name, 8);
+
+	uint32_t* codes;
+	size_t count;
+
+	const double start = cymbBenchTime();
+	const CymbResult result = cymbAssemble(corpus->string, &codes, &count, &diagnostics);
+	*seconds = cymbBenchTime() - start;
+
+	if(result == CYMB_SUCCESS)
+	{
+		*counts = (CymbBenchCounts){
+			.bytes = corpus->length,
+			.codes = count
+		};
+		cymbArrayDataFree(codes);
+	}
+
+	cymbDiagnosticListFree(&diagnostics);
+
+	return result;
+}
+
+/*
+ * Benchmark the disassembler.
+ */
+static CymbResult cymbBenchDisassemble(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+
+	CymbDiagnosticList diagnostics;
+	cymbDiagnosticListCreate(&diagnostics, arena, corpus->name, 8);
+
+	CymbString string;
+
+	const double start = cymbBenchTime();
+	const CymbResult result = cymbDisassemble(corpus->codes, corpus->codeCount, &string, &diagnostics);
+	*seconds = cymbBenchTime() - start;
+
+	if(result == CYMB_SUCCESS)
+	{
+		*counts = (CymbBenchCounts){
+			.bytes = corpus->codeCount * sizeof(corpus->codes[0]),
+			.codes = corpus->codeCount
+		};
+		cymbArrayDataFree(string.string);
+	}
+
+	cymbDiagnosticListFree(&diagnostics);
+
+	return result;
+}
+
+/*
+ * Benchmark the object file writer.
+ */
+static CymbResult cymbBenchObjectFile(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+	(void)arena;
+
+	static const char fileName[] = "cymb_bench.o";
+
+	const CymbObjectFileData data = {
+		.text = corpus->codes,
+		.textSize = corpus->codeCount * sizeof(corpus->codes[0])
+	};
+
+	const double start = cymbBenchTime();
+	const CymbResult result = cymbCreateObjectFile(fileName, &data);
+	*seconds = cymbBenchTime() - start;
+
+	remove(fileName);
+
+	*counts = (CymbBenchCounts){
+		.bytes = data.textSize,
+		.codes = corpus->codeCount
+	};
+
+	return result;
+}
+
+/*
+ * Sink of the hashes, so that they are not optimized out.
+ */
+static volatile uint64_t cymbBenchHashSink;
+
+/*
+ * A hash function.
+ *
+ * Parameters:
+ * - string: The string.
+ * - length: The length of the string.
+ *
+ * Returns:
+ * - The hash.
+ */
+typedef uint64_t (*CymbBenchHashFunction)(const unsigned char* string, size_t length);
+
+/*
+ * Hash each key of a corpus, or its whole source if it has no keys.
+ *
+ * Parameters:
+ * - corpus: The corpus.
+ * - function: The hash function.
+ * - seconds: Set to the time of the measured section.
+ * - counts: Set to the amounts of work done.
+ */
+static void cymbBenchHashCorpus(const CymbBenchCorpus* const corpus, const CymbBenchHashFunction function, double* const seconds, CymbBenchCounts* const counts)
+{
+	uint64_t hash = 0;
+
+	const double start = cymbBenchTime();
+	if(corpus->keyCount == 0)
+	{
+		hash = function((const unsigned char*)corpus->string, corpus->length);
+	}
+	for(size_t keyIndex = 0; keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		hash ^= function((const unsigned char*)corpus->keys[keyIndex].string, corpus->keys[keyIndex].length);
+	}
+	*seconds = cymbBenchTime() - start;
+
+	cymbBenchHashSink = hash;
+
+	*counts = (CymbBenchCounts){
+		.bytes = corpus->length,
+		.keys = corpus->keyCount
+	};
+}
+
+/*
+ * Compute the Murmur3 hash of a string, widened to the hash function type.
+ */
+static uint64_t cymbBenchMurmur3Function(const unsigned char* const string, const size_t length)
+{
+	return cymbMurmur3(string, length);
+}
+
+/*
+ * Benchmark the 64-bit hash.
+ */
+static CymbResult cymbBenchHash(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+	(void)arena;
+
+	cymbBenchHashCorpus(corpus, cymbHash, seconds, counts);
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Benchmark the Murmur3 hash.
+ */
+static CymbResult cymbBenchMurmur3(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+	(void)arena;
+
+	cymbBenchHashCorpus(corpus, cymbBenchMurmur3Function, seconds, counts);
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Fill a map with the keys of a corpus.
+ *
+ * Parameters:
+ * - corpus: The corpus.
+ * - arena: The arena used for allocations.
+ * - map: Set to the map.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+static CymbResult cymbBenchFillMap(const CymbBenchCorpus* const corpus, CymbArena* const arena, CymbMap* const map)
+{
+	CymbResult result = cymbMapCreate(map, arena, 0, sizeof(uint32_t), alignof(uint32_t));
+
+	for(size_t keyIndex = 0; result == CYMB_SUCCESS && keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		const uint32_t element = keyIndex;
+		result = cymbMapStore(map, corpus->keys[keyIndex], &element);
+	}
+
+	return result;
+}
+
+/*
+ * Fill a chained map with the keys of a corpus.
+ *
+ * Parameters:
+ * - corpus: The corpus.
+ * - arena: The arena used for allocations.
+ * - map: Set to the map.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+static CymbResult cymbBenchFillChainedMap(const CymbBenchCorpus* const corpus, CymbArena* const arena, CymbBenchChainedMap* const map)
+{
+	// With the 1024 bins the interner used, a million keys take tens of seconds, so give it one bin per key.
+	map->binCount = corpus->keyCount;
+	map->bins = cymbArenaAllocate(arena, map->binCount * sizeof(map->bins[0]), alignof(typeof(map->bins[0])));
+	if(!map->bins)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+	memset(map->bins, 0, map->binCount * sizeof(map->bins[0]));
+
+	CymbResult result = CYMB_SUCCESS;
+	for(size_t keyIndex = 0; result == CYMB_SUCCESS && keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		result = cymbBenchChainedStore(map, arena, corpus->keys[keyIndex], keyIndex);
+	}
+
+	return result;
+}
+
+/*
+ * Check the elements read from a map.
+ *
+ * Parameters:
+ * - corpus: The corpus.
+ * - sum: The sum of the elements read.
+ *
+ * Returns:
+ * - CYMB_SUCCESS if every key was found with its index.
+ * - CYMB_INVALID otherwise.
+ */
+static CymbResult cymbBenchCheckSum(const CymbBenchCorpus* const corpus, const size_t sum)
+{
+	return sum == corpus->keyCount * (corpus->keyCount - 1) / 2 ? CYMB_SUCCESS : CYMB_INVALID;
+}
+
+/*
+ * Benchmark storing keys in a map.
+ */
+static CymbResult cymbBenchMapStore(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+
+	CymbMap map;
+
+	const double start = cymbBenchTime();
+	const CymbResult result = cymbBenchFillMap(corpus, arena, &map);
+	*seconds = cymbBenchTime() - start;
+
+	*counts = (CymbBenchCounts){
+		.keys = corpus->keyCount
+	};
+
+	return result;
+}
+
+/*
+ * Benchmark reading keys from a map.
+ */
+static CymbResult cymbBenchMapRead(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+
+	CymbMap map;
+	const CymbResult result = cymbBenchFillMap(corpus, arena, &map);
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
+	}
+
+	size_t sum = 0;
+
+	const double start = cymbBenchTime();
+	for(size_t keyIndex = 0; keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		const uint32_t* const element = cymbMapRead(&map, corpus->keys[keyIndex]);
+		sum += element ? *element : 0;
+	}
+	*seconds = cymbBenchTime() - start;
+
+	*counts = (CymbBenchCounts){
+		.keys = corpus->keyCount
+	};
+
+	return cymbBenchCheckSum(corpus, sum);
+}
+
+/*
+ * Benchmark storing keys in the chained map.
+ */
+static CymbResult cymbBenchChainedMapStore(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+
+	CymbBenchChainedMap map;
+
+	const double start = cymbBenchTime();
+	const CymbResult result = cymbBenchFillChainedMap(corpus, arena, &map);
+	*seconds = cymbBenchTime() - start;
+
+	*counts = (CymbBenchCounts){
+		.keys = corpus->keyCount
+	};
+
+	return result;
+}
+
+/*
+ * Benchmark reading keys from the chained map.
+ */
+static CymbResult cymbBenchChainedMapRead(const CymbBenchCorpus* const corpus, const unsigned int threadCount, CymbArena* const arena, double* const seconds, CymbBenchCounts* const counts)
+{
+	(void)threadCount;
+
+	CymbBenchChainedMap map;
+	const CymbResult result = cymbBenchFillChainedMap(corpus, arena, &map);
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
+	}
+
+	size_t sum = 0;
+
+	const double start = cymbBenchTime();
+	for(size_t keyIndex = 0; keyIndex < corpus->keyCount; ++keyIndex)
+	{
+		const uint32_t* const element = cymbBenchChainedRead(&map, corpus->keys[keyIndex]);
+		sum += element ? *element : 0;
+	}
+	*seconds = cymbBenchTime() - start;
+
+	*counts = (CymbBenchCounts){
+		.keys = corpus->keyCount
+	};
+
+	return cymbBenchCheckSum(corpus, sum);
+}
+
+/*
+ * Compare two times.
+ */
+static int cymbCompareTimes(const void* const firstVoid, const void* const secondVoid)
+{
+	const double first = *(const double*)firstVoid;
+	const double second = *(const double*)secondVoid;
+
+	return (first > second) - (first < second);
+}
+
+/*
+ * Get a percentile of sorted times, using the nearest rank.
+ *
+ * Parameters:
+ * - times: The sorted times.
+ * - count: The number of times.
+ * - percentile: The percentile, between 1 and 100.
+ *
+ * Returns:
+ * - The percentile.
+ */
+static double cymbBenchPercentile(const double* const times, const size_t count, const unsigned int percentile)
+{
+	const size_t rank = (count * percentile + 99) / 100;
+
+	return times[rank == 0 ? 0 : rank - 1];
+}
+
+/*
+ * Run a benchmark and print its JSON object.
+ *
+ * Parameters:
+ * - name: The name of the benchmark.
+ * - function: The benchmark function.
+ * - corpus: The corpus.
+ * - threadCount: The maximum number of threads, 0 for the serial version.
+ * - options: The benchmark options.
+ * - times: An array of at least options->repetitionCount times.
+ * - first: Flag indicating if this is the first benchmark printed.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - An error code otherwise.
+ */
+static CymbResult cymbBenchRun(const char* const name, const CymbBenchFunction function, const CymbBenchCorpus* const corpus, const unsigned int threadCount, const CymbBenchOptions* const options, double* const times, const bool first)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	CymbArena arena;
+	cymbArenaCreate(&arena);
+
+	CymbBenchCounts counts = {};
+
+	const unsigned int runCount = options->warmupCount + options->repetitionCount;
+	for(unsigned int run = 0; run < runCount; ++run)
+	{
+		double seconds;
+		result = function(corpus, threadCount, &arena, &seconds, &counts);
+		cymbArenaClear(&arena);
+		if(result != CYMB_SUCCESS)
+		{
+			fprintf(stderr, "Benchmark %s failed on corpus %s.\n", name, corpus->name);
+			goto end;
+		}
+
+		if(run >= options->warmupCount)
+		{
+			times[run - options->warmupCount] = seconds;
+		}
+	}
+
+	const size_t count = options->repetitionCount;
+	qsort(times, count, sizeof(times[0]), cymbCompareTimes);
+
+	double mean = 0.0;
+	for(size_t index = 0; index < count; ++index)
+	{
+		mean += times[index];
+	}
+	mean /= count;
+
+	// Rates use the median, which is less sensitive to outliers than the mean.
+	const double median = cymbBenchPercentile(times, count, 50);
+
+	printf(
+		"%s\n"
+		"\t\t{\n"
+		"\t\t\t\"name\": \"%s\",\n"
+		"\t\t\t\"corpus\": \"%s\",\n"
+		"\t\t\t\"threads\": %u,\n"
+		"\t\t\t\"bytes\": %zu,\n"
+		"\t\t\t\"tokens\": %zu,\n"
+		"\t\t\t\"nodes\": %zu,\n"
+		"\t\t\t\"codes\": %zu,\n"
+		"\t\t\t\"keys\": %zu,\n"
+		"\t\t\t\"seconds\": {\"min\": %.9f, \"mean\": %.9f, \"p50\": %.9f, \"p90\": %.9f, \"p99\": %.9f, \"max\": %.9f},\n"
+		"\t\t\t\"mb_per_second\": %.3f,\n"
+		"\t\t\t\"tokens_per_second\": %.0f,\n"
+		"\t\t\t\"nodes_per_second\": %.0f,\n"
+		"\t\t\t\"codes_per_second\": %.0f,\n"
+		"\t\t\t\"keys_per_second\": %.0f\n"
+		"\t\t}",
+		first ? "" : ",",
+		name,
+		corpus->name,
+		threadCount == 0 ? 1 : threadCount,
+		counts.bytes,
+		counts.tokens,
+		counts.nodes,
+		counts.codes,
+		counts.keys,
+		times[0], mean, median, cymbBenchPercentile(times, count, 90), cymbBenchPercentile(times, count, 99), times[count - 1],
+		counts.bytes / 1e6 / median,
+		counts.tokens / median,
+		counts.nodes / median,
+		counts.codes / median,
+		counts.keys / median
+	);
+
+	end:
+	cymbArenaFree(&arena);
+
+	return result;
+}
+
+/*
+ * Generate a corpus and compute the inputs of its benchmarks.
+ *
+ * Parameters:
+ * - corpus: The corpus, with its name and either its generator and type or its key count set.
+ * - size: The approximate size of the corpus.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - An error code otherwise.
+ */
+static CymbResult cymbBenchPrepare(CymbBenchCorpus* const corpus, const size_t size)
+{
+	if(corpus->keyCount != 0)
+	{
+		return cymbBenchGenerateKeys(corpus);
+	}
+
+	CymbBenchString string = {};
+	CymbResult result = corpus->generator(&string, size);
+	corpus->string = string.string;
+	corpus->length = string.length;
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
+	}
+
+	CymbArena arena;
+	cymbArenaCreate(&arena);
+
+	CymbDiagnosticList diagnostics;
+	cymbDiagnosticListCreate(&diagnostics, &arena, corpus->name, 8);
+
+	if(corpus->isAssembly)
+	{
+		result = cymbAssemble(corpus->string, &corpus->codes, &corpus->codeCount, &diagnostics);
+	}
+	else
+	{
+		result = cymbLex(corpus->string, CYMB_C23, nullptr, &corpus->tokens, &diagnostics);
+	}
+
+	if(result != CYMB_SUCCESS)
+	{
+		cymbDiagnosticListPrint(&diagnostics);
+	}
+
+	cymbDiagnosticListFree(&diagnostics);
+	cymbArenaFree(&arena);
+
+	return result;
+}
+
+/*
+ * Parse an option with an unsigned value.
+ *
+ * Parameters:
+ * - argument: The argument.
+ * - prefix: The option prefix, including the equal sign.
+ * - minimum: The minimum value.
+ * - maximum: The maximum value.
+ * - value: Set to the value.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_NO_MATCH if the argument does not start with the prefix.
+ * - CYMB_INVALID if the value is invalid.
+ */
+static CymbResult cymbBenchParseOption(const char* const argument, const char* const prefix, const unsigned long long minimum, const unsigned long long maximum, unsigned long long* const value)
+{
+	const size_t prefixLength = strlen(prefix);
+	if(strncmp(argument, prefix, prefixLength) != 0)
+	{
+		return CYMB_NO_MATCH;
+	}
+
+	const char* const string = argument + prefixLength;
+	char* end;
+	*value = strtoull(string, &end, 10);
+
+	return end != string && *end == '\0' && *value >= minimum && *value <= maximum ? CYMB_SUCCESS : CYMB_INVALID;
+}
+
+int main(int argumentCount, char** arguments)
+{
+	int status = EXIT_FAILURE;
+
+	CymbBenchOptions options = {
+		.size = 0x400000,
+		.warmupCount = 2,
+		.repetitionCount = 10,
+		.maxThreadCount = 8
+	};
+
+	for(int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex)
+	{
+		const char* const argument = arguments[argumentIndex];
+		unsigned long long value;
+
+		CymbResult result = cymbBenchParseOption(argument, "--size=", 0x1000, 0x40000000, &value);
+		if(result == CYMB_SUCCESS)
+		{
+			options.size = value;
+			continue;
+		}
+
+		if(result == CYMB_NO_MATCH)
+		{
+			result = cymbBenchParseOption(argument, "--warmups=", 0, 1000, &value);
+			if(result == CYMB_SUCCESS)
+			{
+				options.warmupCount = value;
+				continue;
+			}
+		}
+
+		if(result == CYMB_NO_MATCH)
+		{
+			result = cymbBenchParseOption(argument, "--repetitions=", 1, 100000, &value);
+			if(result == CYMB_SUCCESS)
+			{
+				options.repetitionCount = value;
+				continue;
+			}
+		}
+
+		if(result == CYMB_NO_MATCH)
+		{
+			result = cymbBenchParseOption(argument, "--threads=", 1, 256, &value);
+			if(result == CYMB_SUCCESS)
+			{
+				options.maxThreadCount = value;
+				continue;
+			}
+		}
+
+		fputs("Usage: cymb_bench [--size=<bytes>] [--warmups=<count>] [--repetitions=<count>] [--threads=<count>]\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	CymbBenchCorpus corpora[] = {
+		{.name = "functions", .generator = cymbBenchGenerateFunctions},
+		{.name = "nesting", .generator = cymbBenchGenerateNesting},
+		{.name = "deep_nesting_1000", .generator = cymbBenchGenerateDeepNesting1000},
+		{.name = "deep_nesting_10000", .generator = cymbBenchGenerateDeepNesting10000},
+		{.name = "expressions", .generator = cymbBenchGenerateExpressions},
+		{.name = "punctuators", .generator = cymbBenchGeneratePunctuators, .isPunctuators = true},
+		{.name = "assembly", .generator = cymbBenchGenerateAssembly, .isAssembly = true},
+		{.name = "keys_100000", .keyCount = 100000},
+		{.name = "keys_1000000", .keyCount = 1000000}
+	};
+
+	double* const times = malloc(options.repetitionCount * sizeof(times[0]));
+	if(!times)
+	{
+		fputs("Out of memory.\n", stderr);
+		goto end;
+	}
+
+	for(size_t corpusIndex = 0; corpusIndex < CYMB_LENGTH(corpora); ++corpusIndex)
+	{
+		if(cymbBenchPrepare(&corpora[corpusIndex], options.size) != CYMB_SUCCESS)
+		{
+			fprintf(stderr, "Could not prepare corpus %s.\n", corpora[corpusIndex].name);
+			goto end;
+		}
+	}
+
+	printf(
+		"{\n"
+		"\t\"version\": \"%d.%d.%d\",\n"
+		"\t\"warmups\": %u,\n"
+		"\t\"repetitions\": %u,\n"
+		"\t\"benchmarks\": [",
+		CYMB_VERSION_MAJOR, CYMB_VERSION_MINOR, CYMB_VERSION_PATCH,
+		options.warmupCount,
+		options.repetitionCount
+	);
+
+	for(size_t corpusIndex = 0; corpusIndex < CYMB_LENGTH(corpora); ++corpusIndex)
+	{
+		const CymbBenchCorpus* const corpus = &corpora[corpusIndex];
+		const bool first = corpusIndex == 0;
+
+		if(corpus->keyCount != 0)
+		{
+			if(
+				cymbBenchRun("hash", cymbBenchHash, corpus, 0, &options, times, first) != CYMB_SUCCESS ||
+				cymbBenchRun("murmur3", cymbBenchMurmur3, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+				cymbBenchRun("map_store", cymbBenchMapStore, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+				cymbBenchRun("map_read", cymbBenchMapRead, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+				cymbBenchRun("chained_map_store", cymbBenchChainedMapStore, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+				cymbBenchRun("chained_map_read", cymbBenchChainedMapRead, corpus, 0, &options, times, false) != CYMB_SUCCESS
+			)
+			{
+				goto end;
+			}
+		}
+		else if(corpus->isAssembly)
+		{
+			if(
+				cymbBenchRun("assemble", cymbBenchAssemble, corpus, 0, &options, times, first) != CYMB_SUCCESS ||
+				cymbBenchRun("disassemble", cymbBenchDisassemble, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+				cymbBenchRun("object_file", cymbBenchObjectFile, corpus, 0, &options, times, false) != CYMB_SUCCESS
+			)
+			{
+				goto end;
+			}
+		}
+		else if(corpus->isPunctuators)
+		{
+			if(
+				cymbBenchRun("lex", cymbBenchLex, corpus, 0, &options, times, first) != CYMB_SUCCESS ||
+				cymbBenchRun("punctuator", cymbBenchPunctuator, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+				cymbBenchRun("punctuator_linear", cymbBenchPunctuatorLinear, corpus, 0, &options, times, false) != CYMB_SUCCESS
+			)
+			{
+				goto end;
+			}
+		}
+		else if(
+			cymbBenchRun("lex", cymbBenchLex, corpus, 0, &options, times, first) != CYMB_SUCCESS ||
+			cymbBenchRun("parse", cymbBenchParse, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+			cymbBenchRun("hash", cymbBenchHash, corpus, 0, &options, times, false) != CYMB_SUCCESS ||
+			cymbBenchRun("murmur3", cymbBenchMurmur3, corpus, 0, &options, times, false) != CYMB_SUCCESS
+		)
+		{
+			goto end;
+		}
+	}
+
+	// Scaling of the parallel lexer and parser over 1 to N threads.
+	unsigned int threadCount = 1;
+	while(true)
+	{
+		if(
+			cymbBenchRun("lex_parallel", cymbBenchLex, &corpora[0], threadCount, &options, times, false) != CYMB_SUCCESS ||
+			cymbBenchRun("parse_parallel", cymbBenchParse, &corpora[0], threadCount, &options, times, false) != CYMB_SUCCESS
+		)
+		{
+			goto end;
+		}
+
+		if(threadCount == options.maxThreadCount)
+		{
+			break;
+		}
+		threadCount = CYMB_MIN(threadCount * 2, options.maxThreadCount);
+	}
+
+	puts("\n\t]\n}");
+
+	status = EXIT_SUCCESS;
+
+	end:
+	for(size_t corpusIndex = 0; corpusIndex < CYMB_LENGTH(corpora); ++corpusIndex)
+	{
+		free(corpora[corpusIndex].string);
+		cymbFreeTokenList(&corpora[corpusIndex].tokens);
+		cymbArrayDataFree(corpora[corpusIndex].codes);
+		free(corpora[corpusIndex].keys);
+	}
+	free(times);
+
+	return status;
+}
@@ -10,7 +10,7 @@
  *
  * Parameters:
  * - string: The assembly code to assemble.
- * - codes: The resulting codes.
+ * - codes: The resulting codes, to free with cymbArrayDataFree.
  * - count: The resulting number of codes.
  * - diagnostics: A list of diagnostics.
  *
@@ -27,7 +27,7 @@ CymbResult cymbAssemble(const char* string, uint32_t** codes, size_t* count, Cym
  * Parameters:
  * - codes: The codes to disassemble.
  * - count: The number of codes.
- * - string: The resulting assembly code.
+ * - string: The resulting assembly code, to free with cymbArrayDataFree.
  * - diagnostics: A list of diagnostics.
  *
  * Returns:
@@ -21,6 +21,7 @@ typedef enum CymbDiagnosticType
 	CYMB_INVALID_CHARACTER_CONSTANT,
 	CYMB_INVALID_STRING_CHARACTER,
 	CYMB_UNFINISHED_STRING,
+	CYMB_UNFINISHED_COMMENT,
 	CYMB_CONSTANT_TOO_LARGE,
 	CYMB_SEPARATOR_AFTER_BASE,
 	CYMB_DUPLICATE_SEPARATORS,
@@ -109,23 +110,46 @@ typedef struct CymbDiagnostic
  *
  * Fields:
  * - file: The file for which diagnostics are emitted.
+ * - source: The content of the file, used to locate tokens.
+ * - lines: The offsets of the line starts in the source, built on the first lookup.
+ * - lineCount: The number of lines in the source, 0 if the lines are not built.
  * - tabWidth: The tab width used for diagnostics.
  * - arena: The arena used for allocations.
  * - start: The first diagnostic.
  * - end: The last diagnostic.
+ * - count: The number of diagnostics.
+ * - limit: The maximum number of diagnostics, past which they are dropped, 0 for no limit.
  */
 typedef struct CymbDiagnosticList
 {
 	const char* file;
+	const char* source;
+	size_t* lines;
+	size_t lineCount;
 	unsigned char tabWidth;
 
 	CymbArena* arena;
 	CymbDiagnostic* start;
 	CymbDiagnostic* end;
+	size_t count;
+	size_t limit;
 } CymbDiagnosticList;
 
 /*
- * Print diagnostics.
+ * Render diagnostics as they are printed.
+ *
+ * Parameters:
+ * - diagnostics: The diagnostics to render.
+ * - output: Set to the null-terminated rendered string, to free with cymbArrayDataFree.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if out of memory.
+ */
+CymbResult cymbDiagnosticListRender(const CymbDiagnosticList* diagnostics, CymbString* output);
+
+/*
+ * Print diagnostics to stderr in a single write.
  *
  * Parameters:
  * - diagnostics: The diagnostics to print.
@@ -143,6 +167,28 @@ void cymbDiagnosticListPrint(const CymbDiagnosticList* diagnostics);
  */
 void cymbDiagnosticListCreate(CymbDiagnosticList* diagnostics, CymbArena* arena, const char* file, unsigned char tabWidth);
 
+/*
+ * Check if a diagnostic list reached its limit.
+ * Lexing and parsing stop once it does.
+ *
+ * Parameters:
+ * - diagnostics: The list.
+ *
+ * Returns:
+ * - true if the list reached its limit.
+ * - false otherwise.
+ */
+bool cymbDiagnosticListFull(const CymbDiagnosticList* diagnostics);
+
+/*
+ * Set the source of a diagnostic list.
+ *
+ * Parameters:
+ * - diagnostics: The list to modify.
+ * - source: The content of the file for which diagnostics are emitted.
+ */
+void cymbDiagnosticListSetSource(CymbDiagnosticList* diagnostics, const char* source);
+
 /*
  * Free a list of diagnostics.
  *
@@ -153,6 +199,7 @@ void cymbDiagnosticListFree(CymbDiagnosticList* diagnostics);
 
 /*
  * Add a diagnostic to a list.
+ * The diagnostic is dropped if the list reached its limit.
  *
  * Parameters:
  * - diagnostics: The list to modify.
@@ -164,6 +211,20 @@ void cymbDiagnosticListFree(CymbDiagnosticList* diagnostics);
  */
 CymbResult cymbDiagnosticAdd(CymbDiagnosticList* diagnostics, const CymbDiagnostic* diagnostic);
 
+/*
+ * Locate a part of the source.
+ * The line starts are indexed on the first call, so that sources without diagnostics never pay for it.
+ *
+ * Parameters:
+ * - diagnostics: A list of diagnostics.
+ * - hint: A part of the source.
+ *
+ * Returns:
+ * - The diagnostic info of the hint.
+ * - An empty info if the list has no source.
+ */
+CymbDiagnosticInfo cymbDiagnosticLocate(CymbDiagnosticList* diagnostics, CymbStringView hint);
+
 /*
  * Get the next tab stop column.
  *
@@ -2,16 +2,18 @@
 #define CYMB_LEX_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "cymb/diagnostic.h"
 #include "cymb/memory.h"
+#include "cymb/options.h"
 #include "cymb/reader.h"
 #include "cymb/result.h"
 
 /*
  * A token type.
  */
-typedef enum CymbTokenType
+typedef enum CymbTokenType: unsigned char
 {
 	CYMB_TOKEN_IDENTIFIER,
 	/* Keywords */
@@ -164,16 +166,25 @@ typedef struct CymbConstant
  *
  * Fields:
  * - type: The token type.
- * - info: The diagnostic info of the token.
- * - constant: The constant info if the token is a constant.
+ * - offset: The offset of the token in the source.
+ * - length: The length of the token.
+ * - constant: The index of the constant in the constants of the list if the token is a constant.
+ * - symbol: The interned symbol of the identifier if the token is an identifier.
+ * - partner: The distance to the matching token if the token is a parenthesis, a bracket or a brace, 0 if it is unmatched.
  */
 typedef struct CymbToken
 {
 	CymbTokenType type;
 
-	CymbDiagnosticInfo info;
+	uint32_t offset;
+	uint32_t length;
 
-	CymbConstant constant;
+	union
+	{
+		uint32_t constant;
+		uint32_t symbol;
+		uint32_t partner;
+	};
 } CymbToken;
 
 /*
@@ -182,19 +193,44 @@ typedef struct CymbToken
  * Fields:
  * - tokens: An array of tokens.
  * - count: The number of tokens.
+ * - capacity: The number of tokens the array can hold, 0 if the list only views the tokens of another list.
+ * - constants: The constants of the tokens.
+ * - constantCount: The number of constants.
+ * - constantCapacity: The number of constants the array can hold.
+ * - invalid: Whether lexing met an error.
  */
 typedef struct CymbTokenList
 {
 	CymbToken* tokens;
 	size_t count;
+	size_t capacity;
+
+	CymbConstant* constants;
+	size_t constantCount;
+	size_t constantCapacity;
+
+	bool invalid;
 } CymbTokenList;
 
+/*
+ * Get the diagnostic info of a token.
+ *
+ * Parameters:
+ * - diagnostics: A list of diagnostics for the source of the token.
+ * - token: A token.
+ *
+ * Returns:
+ * - The diagnostic info of the token.
+ */
+CymbDiagnosticInfo cymbTokenInfo(CymbDiagnosticList* diagnostics, const CymbToken* token);
+
 /*
  * A lex function.
  *
  * Parameters:
  * - reader: A reader.
- * - token: A token in which to store the result.
+ * - token: A token in which to store the type and length of the result.
+ * - constant: A constant in which to store the value of the result if it is a constant.
  * - diagnostics: A list of diagnostics.
  *
  * Returns:
@@ -203,22 +239,41 @@ typedef struct CymbTokenList
  * - CYMB_INVALID if the token is invalid.
  * - CYMB_OUT_OF_MEMORY if a diagnostic could not be added.
  */
-typedef CymbResult (*CymbLexFunction)(CymbReader* reader, CymbToken* token, CymbDiagnosticList* diagnostics);
+typedef CymbResult (*CymbLexFunction)(CymbReader* reader, CymbToken* token, CymbConstant* constant, CymbDiagnosticList* diagnostics);
 
 /*
  * Parse a string literal.
  */
-CymbResult cymbParseString(CymbReader* reader, CymbToken* token, CymbDiagnosticList* diagnostics);
+CymbResult cymbParseString(CymbReader* reader, CymbToken* token, CymbConstant* constant, CymbDiagnosticList* diagnostics);
 
 /*
  * Parse a character constant.
  */
-CymbResult cymbParseCharacter(CymbReader* reader, CymbToken* token, CymbDiagnosticList* diagnostics);
+CymbResult cymbParseCharacter(CymbReader* reader, CymbToken* token, CymbConstant* constant, CymbDiagnosticList* diagnostics);
 
 /*
- * Parse a punctuator.
+ * A punctuator.
+ *
+ * Fields:
+ * - string: The spelling of the punctuator.
+ * - type: The token type of the punctuator.
+ */
+typedef struct CymbPunctuator
+{
+	CymbConstString string;
+	CymbTokenType type;
+} CymbPunctuator;
+
+/*
+ * The punctuators, from longest to shortest.
  */
-CymbResult cymbParsePunctuator(CymbReader* reader, CymbToken* token, CymbDiagnosticList* diagnostics);
+extern const CymbPunctuator cymbPunctuators[];
+extern const size_t cymbPunctuatorCount;
+
+/*
+ * Parse a punctuator, the longest one of cymbPunctuators which starts the string.
+ */
+CymbResult cymbParsePunctuator(CymbReader* reader, CymbToken* token, CymbConstant* constant, CymbDiagnosticList* diagnostics);
 
 /*
  * Parse an unsigned integer.
@@ -240,18 +295,73 @@ CymbResult cymbParseUnsigned(CymbReader* reader, uintmax_t* value, unsigned char
 /*
  * Parse an integer constant.
  */
-CymbResult cymbParseConstant(CymbReader* reader, CymbToken* token, CymbDiagnosticList* diagnostics);
+CymbResult cymbParseConstant(CymbReader* reader, CymbToken* token, CymbConstant* constant, CymbDiagnosticList* diagnostics);
+
+/*
+ * Parse an identifier or keyword, keywords are recognized as in the latest standard.
+ */
+CymbResult cymbParseIdentifier(CymbReader* reader, CymbToken* token, CymbConstant* constant, CymbDiagnosticList* diagnostics);
 
 /*
- * Parse an identifier or keyword.
+ * A lexer, which produces tokens one at a time.
+ *
+ * Fields:
+ * - reader: The reader over the string.
+ * - string: The string being lexed.
+ * - standard: The standard in use.
+ * - invalid: Set once an invalid token has been found.
+ * - interner: The interner of the identifiers.
+ * - diagnostics: A list of diagnostics.
  */
-CymbResult cymbParseIdentifier(CymbReader* reader, CymbToken* token, CymbDiagnosticList* diagnostics);
+typedef struct CymbLexer
+{
+	CymbReader reader;
+	const char* string;
+	CymbStandard standard;
+
+	bool invalid;
+
+	CymbInterner* interner;
+	CymbDiagnosticList* diagnostics;
+} CymbLexer;
+
+/*
+ * Create a lexer.
+ * The string is set as the source of the list of diagnostics.
+ *
+ * Parameters:
+ * - lexer: The lexer to create.
+ * - string: A string.
+ * - standard: The standard in use, which decides what keywords are recognized.
+ * - interner: The interner in which identifiers are interned, or nullptr to not intern them.
+ * - diagnostics: A list of diagnostics.
+ */
+void cymbLexerCreate(CymbLexer* lexer, const char* string, CymbStandard standard, CymbInterner* interner, CymbDiagnosticList* diagnostics);
+
+/*
+ * Lex the next token.
+ * Comments are skipped, unknown characters and unfinished comments are reported and skipped.
+ *
+ * Parameters:
+ * - lexer: A lexer.
+ * - token: A token in which to store the result.
+ * - constant: A constant in which to store the value of the result if it is a constant.
+ *
+ * Returns:
+ * - CYMB_SUCCESS if a token is lexed.
+ * - CYMB_INVALID if a token is lexed but it or characters before it are invalid.
+ * - CYMB_NO_MATCH at the end of the string.
+ * - CYMB_OUT_OF_MEMORY if a diagnostic or an identifier could not be added or the string is too long.
+ */
+CymbResult cymbLexNext(CymbLexer* lexer, CymbToken* token, CymbConstant* constant);
 
 /*
  * Lex a string into a list of tokens.
  *
  * Parameters:
  * - string: A string.
+ * - standard: The standard in use, which decides what keywords are recognized.
+ * - interner: The interner in which identifiers are interned.
  * - tokens: A list of tokens.
  * - diagnostics: A list of diagnostics.
  *
@@ -260,7 +370,77 @@ CymbResult cymbParseIdentifier(CymbReader* reader, CymbToken* token, CymbDiagnos
  * - CYMB_INVALID if some token is invalid.
  * - CYMB_OUT_OF_MEMORY if memory allocation fails.
  */
-CymbResult cymbLex(const char* string, CymbTokenList* tokens, CymbDiagnosticList* diagnostics);
+CymbResult cymbLex(const char* string, CymbStandard standard, CymbInterner* interner, CymbTokenList* tokens, CymbDiagnosticList* diagnostics);
+
+/*
+ * Lex a string into a list of tokens using several threads.
+ * The string is split in chunks at newlines, which are lexed in parallel and merged.
+ * The tokens, symbols and diagnostics are the same as with cymbLex.
+ *
+ * Parameters:
+ * - string: A string.
+ * - standard: The standard in use, which decides what keywords are recognized.
+ * - threadCount: The maximum number of threads to use, including the calling thread.
+ * - interner: The interner in which identifiers are interned.
+ * - tokens: A list of tokens.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS if the string is successfully lexed.
+ * - CYMB_INVALID if some token is invalid.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails.
+ */
+CymbResult cymbLexParallel(const char* string, CymbStandard standard, unsigned int threadCount, CymbInterner* interner, CymbTokenList* tokens, CymbDiagnosticList* diagnostics);
+
+/*
+ * Lex part of a string into a list of tokens, whose offsets are from the start of the string.
+ * The part starts between two tokens and lexing stops once it reaches the bound, so the last token may extend past it.
+ *
+ * Parameters:
+ * - string: A string.
+ * - standard: The standard in use, which decides what keywords are recognized.
+ * - start: The offset at which to start.
+ * - bound: The offset at which to stop.
+ * - interner: The interner in which identifiers are interned.
+ * - tokens: A list of tokens.
+ * - end: Set to the offset at which lexing stopped.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS if the part is successfully lexed.
+ * - CYMB_INVALID if some token is invalid.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails.
+ */
+CymbResult cymbLexRange(const char* string, CymbStandard standard, size_t start, size_t bound, CymbInterner* interner, CymbTokenList* tokens, size_t* end, CymbDiagnosticList* diagnostics);
+
+/*
+ * Replace some tokens of a list by the tokens lexed again for the same part of an edited string.
+ * The following tokens are moved in place, and the constants of the replaced tokens are reused by the new ones.
+ * The brackets of the tokens before and after the replaced ones must be matched among themselves, as in whole parsed functions, so only the new tokens are matched.
+ *
+ * Parameters:
+ * - tokens: A list of tokens, which owns its arrays.
+ * - start: The index of the first replaced token.
+ * - end: The index after the last replaced token.
+ * - replacement: The new tokens.
+ * - shift: The difference between the new and previous offsets of the tokens after the replaced ones.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails.
+ */
+CymbResult cymbReplaceTokens(CymbTokenList* tokens, size_t start, size_t end, const CymbTokenList* replacement, ptrdiff_t shift);
+
+/*
+ * Match the parentheses, brackets and braces of tokens in a single pass, setting their partners.
+ * Each kind is matched on its own, so an opening token matches the first closing token at which the count of its kind drops to zero.
+ * The lexing functions call it on the tokens they return.
+ *
+ * Parameters:
+ * - tokens: The tokens.
+ * - count: The number of tokens.
+ */
+void cymbMatchBrackets(CymbToken* tokens, size_t count);
 
 /*
  * Free a list of tokens.
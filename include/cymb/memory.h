@@ -1,8 +1,10 @@
 #ifndef CYMB_MEMORY_H
 #define CYMB_MEMORY_H
 
+#include <stdatomic.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <threads.h>
 
 #include "cymb/result.h"
 
@@ -154,6 +156,7 @@ typedef CymbConstString CymbStringView;
  * - next: The next region.
  * - size: The used size.
  * - capacity: The capacity.
+ * - mappingSize: The size of the mapping if the region is mapped, 0 if it is allocated.
  * - data: The data.
  */
 typedef struct CymbRegion
@@ -163,33 +166,130 @@ typedef struct CymbRegion
 	size_t size;
 	size_t capacity;
 
+	size_t mappingSize;
+
 	alignas(max_align_t) char data[];
 } CymbRegion;
 
+/*
+ * Number of region size classes of a pool.
+ * Class i holds regions of at least 0x4000 << i bytes.
+ */
+constexpr size_t cymbRegionClassCount = 11;
+
+/*
+ * A pool of free regions, shared by arenas of any thread.
+ *
+ * Each class is a stack with its own lock, which is only held to push or pop a region.
+ *
+ * Fields:
+ * - classes: The free regions of each size class.
+ * - locks: The lock of each size class.
+ * - size: The total size of the free regions.
+ * - maxSize: The maximum total size of the free regions, past which released regions are freed.
+ */
+typedef struct CymbRegionPool
+{
+	CymbRegion* classes[cymbRegionClassCount];
+	mtx_t locks[cymbRegionClassCount];
+
+	atomic_size_t size;
+	size_t maxSize;
+} CymbRegionPool;
+
+/*
+ * Create a region pool.
+ *
+ * Parameters:
+ * - pool: The pool.
+ * - maxSize: The maximum total size of the free regions.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if a lock could not be created.
+ */
+CymbResult cymbRegionPoolCreate(CymbRegionPool* pool, size_t maxSize);
+
+/*
+ * Trim a region pool, freeing free regions until their total size is at most a given size.
+ * Smaller regions are kept first, since they are reused the most.
+ *
+ * Parameters:
+ * - pool: The pool.
+ * - retainedSize: The maximum total size of the free regions kept.
+ */
+void cymbRegionPoolTrim(CymbRegionPool* pool, size_t retainedSize);
+
+/*
+ * Free a region pool.
+ * No arena may use the pool anymore.
+ *
+ * Parameters:
+ * - pool: The pool.
+ */
+void cymbRegionPoolFree(CymbRegionPool* pool);
+
+/*
+ * The statistics of an arena.
+ *
+ * Fields:
+ * - requestedSize: The number of bytes requested.
+ * - paddingSize: The number of bytes lost to alignment padding.
+ * - regionCount: The number of regions, including large allocations.
+ * - size: The total size of the regions.
+ * - peakSize: The highest total size of the regions.
+ * - fullRegionCount: The number of times an allocation skipped a region too full for it.
+ */
+typedef struct CymbArenaStats
+{
+	size_t requestedSize;
+	size_t paddingSize;
+
+	size_t regionCount;
+	size_t size;
+	size_t peakSize;
+
+	size_t fullRegionCount;
+} CymbArenaStats;
+
 /*
  * An arena.
  *
+ * Regions grow geometrically, and large allocations get their own region in a separate list.
+ *
  * Fields:
  * - start: The first region.
- * - end: The last region.
+ * - end: The current region.
+ * - large: The last large allocation.
+ * - pool: The pool regions are taken from and returned to, nullptr to allocate them directly.
+ * - stats: The statistics.
  */
 typedef struct CymbArena
 {
 	CymbRegion* start;
 	CymbRegion* end;
+
+	CymbRegion* large;
+
+	CymbRegionPool* pool;
+
+	CymbArenaStats stats;
 } CymbArena;
 
 /*
  * An arena save.
  *
  * Fields:
- * - region: The current last region.
+ * - region: The current region.
  * - size: The current size of this region.
+ * - large: The current last large allocation.
  */
 typedef struct CymbArenaSave
 {
 	CymbRegion* region;
 	size_t size;
+
+	CymbRegion* large;
 } CymbArenaSave;
 
 /*
@@ -200,6 +300,17 @@ typedef struct CymbArenaSave
  */
 void cymbArenaCreate(CymbArena* arena);
 
+/*
+ * Create an arena taking its regions from a pool.
+ * The arena itself is single-threaded, but arenas of several threads may share the pool.
+ * Its regions are returned to the pool when it is trimmed or freed.
+ *
+ * Parameters:
+ * - arena: The arena.
+ * - pool: The pool.
+ */
+void cymbArenaCreatePooled(CymbArena* arena, CymbRegionPool* pool);
+
 /*
  * Free an arena.
  *
@@ -224,12 +335,46 @@ void* cymbArenaAllocate(CymbArena* arena, size_t size, size_t alignment);
 
 /*
  * Clear the arena.
+ * Regions are kept to be reused, large allocations are freed.
  *
  * Parameters:
  * - arena: The arena.
  */
 void cymbArenaClear(CymbArena* arena);
 
+/*
+ * A policy for the memory kept by a cleared arena.
+ *
+ * Fields:
+ * - retainedSize: The maximum total size of the regions kept.
+ * - keepFirstRegion: Flag indicating if the first region, which is the most used, is kept regardless of the size.
+ */
+typedef struct CymbRetention
+{
+	size_t retainedSize;
+	bool keepFirstRegion;
+} CymbRetention;
+
+/*
+ * Give back the memory of a cleared arena beyond a retention policy.
+ * A pooled arena returns the regions to its pool.
+ * Otherwise, on Linux, the pages of mapped regions are released with madvise and the regions are kept, while other regions are freed.
+ *
+ * Parameters:
+ * - arena: The arena, which must be cleared.
+ * - retention: The retention policy.
+ */
+void cymbArenaTrim(CymbArena* arena, CymbRetention retention);
+
+/*
+ * Reset the statistics of an arena.
+ * The regions are kept, and the peak size restarts from their current size.
+ *
+ * Parameters:
+ * - arena: The arena.
+ */
+void cymbArenaResetStats(CymbArena* arena);
+
 /*
  * Save the state of an arena.
  *
@@ -250,6 +395,77 @@ CymbArenaSave cymbArenaSave(CymbArena* arena);
  */
 void cymbArenaRestore(CymbArena* arena, CymbArenaSave save);
 
+/*
+ * A growable array.
+ *
+ * Small arrays are allocated. On Linux, large ones are mapped and grow by remapping their pages, so their elements are never copied.
+ *
+ * Fields:
+ * - data: The elements, nullptr until the first reservation.
+ * - count: The number of elements.
+ * - capacity: The number of elements that fit without growing.
+ * - elementSize: The size of an element.
+ */
+typedef struct CymbArray
+{
+	void* data;
+	size_t count;
+	size_t capacity;
+
+	size_t elementSize;
+} CymbArray;
+
+/*
+ * Create an array.
+ *
+ * Parameters:
+ * - array: The array.
+ * - elementSize: The size of an element.
+ */
+void cymbArrayCreate(CymbArray* array, size_t elementSize);
+
+/*
+ * Free an array.
+ *
+ * Parameters:
+ * - array: The array.
+ */
+void cymbArrayFree(CymbArray* array);
+
+/*
+ * Free the data of an array, after it was taken out of it.
+ *
+ * Parameters:
+ * - data: The data, may be nullptr.
+ */
+void cymbArrayDataFree(void* data);
+
+/*
+ * Make sure an array can hold a number of elements without growing.
+ *
+ * Parameters:
+ * - array: The array.
+ * - capacity: The number of elements.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if memory allocation failed.
+ */
+CymbResult cymbArrayReserve(CymbArray* array, size_t capacity);
+
+/*
+ * Add elements at the end of an array.
+ *
+ * Parameters:
+ * - array: The array.
+ * - count: The number of elements to add.
+ *
+ * Returns:
+ * - A pointer to the first added element, which is uninitialized, on success.
+ * - nullptr if memory allocation failed.
+ */
+void* cymbArrayPush(CymbArray* array, size_t count);
+
 /*
  * Rotate a 32-bit unsigned integer left.
  *
@@ -287,42 +503,50 @@ uint64_t cymbRotateRight64(uint64_t value, unsigned char rotation);
 uint32_t cymbMurmur3(const unsigned char* string, const size_t length);
 
 /*
- * A map pair.
+ * Compute the 64-bit hash of a string, in the style of wyhash.
+ * Long strings are consumed 48 bytes per step, and strings of at most 16 bytes, like most identifiers, take 2 reads.
  *
- * Fields:
- * - key: The key.
- * - element: The element.
- * - next: The next pair in the bin.
+ * Parameters:
+ * - string: The string.
+ * - length: The length of the string.
+ *
+ * Returns:
+ * - The hash of the provided string.
  */
-typedef struct CymbMapPair
-{
-	CymbStringView key;
-
-	void* element;
-
-	struct CymbMapPair* next;
-} CymbMapPair;
+uint64_t cymbHash(const unsigned char* string, size_t length);
 
 /*
- * A map.
+ * A map, using open addressing with linear probing.
+ *
+ * Each slot has a control byte, which is either empty or holds 7 bits of the hash of its key, so that 16 slots are probed at once.
+ * Removing an element shifts the following ones back, so no tombstones are needed.
  *
  * Fields:
- * - binCount: The number of bins.
+ * - count: The number of elements.
+ * - capacity: The number of slots, a power of 2 of at least 16.
  * - elementSize: The size of each element.
  * - elementAlignment: The alignment of each element.
  * - arena: The arena used for allocations.
- * - bins: The bins array.
- * - binElements: The first elements for each bin.
+ * - slotSize: The size of each slot.
+ * - elementOffset: The offset of the element in each slot.
+ * - controls: The control byte of each slot, followed by a copy of the first 15 ones.
+ * - slots: The slots, each holding the hash of its key, its key and its element, so that a lookup touches a single slot.
  */
 typedef struct CymbMap
 {
-	size_t binCount;
+	size_t count;
+	size_t capacity;
+
 	size_t elementSize;
 	size_t elementAlignment;
 
+	size_t slotSize;
+	size_t elementOffset;
+
 	CymbArena* arena;
-	CymbMapPair* bins;
-	void* binElements;
+
+	unsigned char* controls;
+	void* slots;
 } CymbMap;
 
 /*
@@ -331,7 +555,7 @@ typedef struct CymbMap
  * Parameters:
  * - map: The map.
  * - arena: The arena used for allocations.
- * - binCount: The number of bins.
+ * - capacity: The number of elements expected, the map grows past it.
  * - elementSize: The size of each element.
  * - elementAlignment: The alignment of each element.
  *
@@ -339,7 +563,7 @@ typedef struct CymbMap
  * - CYMB_SUCCESS on success.
  * - CYMB_OUT_OF_MEMORY if allocation failed.
  */
-CymbResult cymbMapCreate(CymbMap* map, CymbArena* arena, size_t binCount, size_t elementSize, size_t elementAlignment);
+CymbResult cymbMapCreate(CymbMap* map, CymbArena* arena, size_t capacity, size_t elementSize, size_t elementAlignment);
 
 /*
  * Free a map.
@@ -351,6 +575,7 @@ void cymbMapFree(CymbMap* map);
 
 /*
  * Store an element in a map.
+ * The key is not copied, so it must outlive the map.
  *
  * Parameters:
  * - map: The map.
@@ -371,9 +596,102 @@ CymbResult cymbMapStore(CymbMap* map, CymbStringView key, const void* element);
  * - key: The key of the element.
  *
  * Returns:
- * - A pointer to the element if it was found.
+ * - A pointer to the element, valid until the map is modified, if it was found.
  * - nullptr if the element was not found.
  */
 void* cymbMapRead(const CymbMap* map, CymbStringView key);
 
+/*
+ * Remove an element from a map.
+ *
+ * Parameters:
+ * - map: The map.
+ * - key: The key of the element.
+ *
+ * Returns:
+ * - true if the element was found and removed.
+ * - false otherwise.
+ */
+bool cymbMapRemove(CymbMap* map, CymbStringView key);
+
+/*
+ * A string interner, which gives each distinct string a dense symbol.
+ *
+ * Fields:
+ * - map: The map from strings to symbols.
+ * - strings: The interned strings, indexed by symbol.
+ * - count: The number of interned strings.
+ * - capacity: The capacity of the strings array.
+ */
+typedef struct CymbInterner
+{
+	CymbMap map;
+
+	CymbStringView* strings;
+	uint32_t count;
+	uint32_t capacity;
+} CymbInterner;
+
+/*
+ * Create an interner.
+ *
+ * Parameters:
+ * - interner: The interner.
+ * - arena: The arena in which the interned strings are copied.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+CymbResult cymbInternerCreate(CymbInterner* interner, CymbArena* arena);
+
+/*
+ * Free an interner.
+ *
+ * Parameters:
+ * - interner: The interner.
+ */
+void cymbInternerFree(CymbInterner* interner);
+
+/*
+ * Intern a string.
+ * The string is copied on its first occurrence, so it does not need to outlive the interner.
+ *
+ * Parameters:
+ * - interner: The interner.
+ * - string: The string.
+ * - symbol: The symbol of the string.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed or there are too many symbols.
+ */
+CymbResult cymbIntern(CymbInterner* interner, CymbStringView string, uint32_t* symbol);
+
+/*
+ * Find the symbol of a string without interning it.
+ *
+ * Parameters:
+ * - interner: The interner.
+ * - string: The string.
+ * - symbol: The symbol of the string if it is found.
+ *
+ * Returns:
+ * - true if the string is interned.
+ * - false otherwise.
+ */
+bool cymbInternerFind(const CymbInterner* interner, CymbStringView string, uint32_t* symbol);
+
+/*
+ * Get the string of a symbol.
+ *
+ * Parameters:
+ * - interner: The interner.
+ * - symbol: A symbol returned by the interner.
+ *
+ * Returns:
+ * - The string, which is null-terminated.
+ */
+CymbStringView cymbInternerString(const CymbInterner* interner, uint32_t symbol);
+
 #endif
@@ -17,6 +17,9 @@ typedef enum CymbStandard: long
 	CYMB_C23 = 202311L
 } CymbStandard;
 
+// The default maximum size of free memory kept between inputs.
+constexpr size_t cymbDefaultRetainedSize = 0x2000000;
+
 /*
  * The compiling options.
  *
@@ -24,9 +27,13 @@ typedef enum CymbStandard: long
  * - inputs: The path to the files to compile.
  * - inputCount: The number of files to compile.
  * - output: The path to write the result to.
+ * - retainedSize: The maximum size of free memory kept between inputs.
  * - standard: The C standard to use.
  * - tabWidth: Tab width used for diagnostics.
+ * - threadCount: The maximum number of threads to use.
+ * - errorLimit: The maximum number of diagnostics of an input, 0 for no limit.
  * - debug: Switch to compile in debug or release mode.
+ * - stats: Switch to print memory and size statistics of each input.
  * - version: Switch to display the version information.
  * - help: Switch to display the help information.
  */
@@ -35,12 +42,16 @@ typedef struct CymbOptions
 	const char** inputs;
 	size_t inputCount;
 	const char* output;
+	size_t retainedSize;
 
 	CymbStandard standard;
 
 	unsigned char tabWidth;
+	unsigned short threadCount;
+	unsigned short errorLimit;
 
 	bool debug: 1;
+	bool stats: 1;
 	bool version: 1;
 	bool help: 1;
 } CymbOptions;
@@ -8,6 +8,7 @@
  *
  * Fields:
  * - string: A string to read.
+ * - lazy: If true, only the string is advanced and the position and line are not tracked.
  * - tabWidth: The tab width to use when encoutering tab characters.
  * - position: The position of the current character.
  * - line: The current line.
@@ -16,6 +17,7 @@ typedef struct CymbReader
 {
 	const char* string;
 
+	bool lazy;
 	unsigned char tabWidth;
 
 	CymbPosition position;
@@ -33,6 +35,16 @@ typedef struct CymbReader
  */
 void cymbReaderCreate(const char* string, unsigned char tabWidth, CymbReader* reader);
 
+/*
+ * Create a lazy reader, which does not track positions.
+ * Positions can be computed when needed with cymbDiagnosticLocate.
+ *
+ * Parameters:
+ * - string: A string to read.
+ * - reader: The reader.
+ */
+void cymbReaderCreateLazy(const char* string, CymbReader* reader);
+
 /*
  * Move a reader one character forward.
  *
@@ -66,6 +78,29 @@ void cymbReaderSkipLine(CymbReader* reader);
  */
 void cymbReaderSkipSpaces(CymbReader* reader);
 
+/*
+ * Find the first character of a string which is not a space.
+ *
+ * Parameters:
+ * - string: A string.
+ *
+ * Returns:
+ * - The first character which is not a space, which is the null terminator if there is none.
+ */
+const char* cymbFindNonSpace(const char* string);
+
+/*
+ * Find the end of a block comment.
+ *
+ * Parameters:
+ * - string: The string following the comment opening.
+ *
+ * Returns:
+ * - The start of the comment closing.
+ * - The null terminator if the comment is not closed.
+ */
+const char* cymbFindCommentEnd(const char* string);
+
 /*
  * Skip spaces in a line in a reader.
  *
@@ -2,6 +2,7 @@
 #define CYMB_TREE_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "cymb/lex.h"
 
@@ -28,20 +29,23 @@ typedef enum CymbNodeType
 	CYMB_NODE_POSTFIX_OPERATOR
 } CymbNodeType;
 
-typedef struct CymbNode CymbNode;
+/*
+ * The index of a node in a tree, 0 meaning no node.
+ */
+typedef uint32_t CymbNodeIndex;
 
 /*
- * A child node.
+ * A list of child nodes, stored contiguously in the children of a tree.
  *
  * Fields:
- * - node: The child node.
- * - next: The next child.
+ * - start: The index of the first child in the children of the tree.
+ * - count: The number of children.
  */
-typedef struct CymbNodeChild
+typedef struct CymbNodeSpan
 {
-	CymbNode* node;
-	struct CymbNodeChild* next;
-} CymbNodeChild;
+	uint32_t start;
+	uint32_t count;
+} CymbNodeSpan;
 
 /*
  * An object type.
@@ -91,7 +95,7 @@ typedef struct CymbTypeNode
  */
 typedef struct CymbPointerNode
 {
-	CymbNode* pointedNode;
+	CymbNodeIndex pointedNode;
 
 	bool isConst: 1;
 	bool isRestrict: 1;
@@ -102,13 +106,13 @@ typedef struct CymbPointerNode
  *
  * Fields:
  * - returnType: The return type.
- * - parameterTypesStart: The parameter types.
+ * - parameterTypes: The parameter types.
  */
 typedef struct CymbFunctionTypeNode
 {
-	CymbNode* returnType;
+	CymbNodeIndex returnType;
 
-	CymbNodeChild* parameterTypes;
+	CymbNodeSpan parameterTypes;
 } CymbFunctionTypeNode;
 
 /*
@@ -119,7 +123,7 @@ typedef struct CymbFunctionTypeNode
  */
 typedef struct CymbProgramNode
 {
-	CymbNodeChild* children;
+	CymbNodeSpan children;
 } CymbProgramNode;
 
 /*
@@ -128,17 +132,14 @@ typedef struct CymbProgramNode
  * Fields:
  * - name: The name.
  * - type: The type.
- * - parameters: The parameters.
- * - statements: The statements array.
+ * - children: The parameters, as many as the parameter types of the type, followed by the statements.
  */
 typedef struct CymbFunctionNode
 {
-	CymbNode* name;
-	CymbNode* type;
-
-	CymbNodeChild* parameters;
+	CymbNodeIndex name;
+	CymbNodeIndex type;
 
-	CymbNodeChild* statements;
+	CymbNodeSpan children;
 } CymbFunctionNode;
 
 /*
@@ -151,10 +152,10 @@ typedef struct CymbFunctionNode
  */
 typedef struct CymbDeclarationNode
 {
-	CymbNode* identifier;
+	CymbNodeIndex identifier;
 
-	CymbNode* type;
-	CymbNode* initializer;
+	CymbNodeIndex type;
+	CymbNodeIndex initializer;
 } CymbDeclarationNode;
 
 /*
@@ -166,14 +167,14 @@ typedef struct CymbDeclarationNode
  */
 typedef struct CymbWhileNode
 {
-	CymbNode* expression;
-	CymbNodeChild* body;
+	CymbNodeIndex expression;
+	CymbNodeSpan body;
 } CymbWhileNode;
 
 /*
  * A return node.
  */
-typedef CymbNode* CymbReturnNode;
+typedef CymbNodeIndex CymbReturnNode;
 
 /*
  * A constant node.
@@ -228,8 +229,8 @@ typedef struct CymbBinaryOperatorNode
 {
 	CymbBinaryOperator operator;
 
-	CymbNode* leftNode;
-	CymbNode* rightNode;
+	CymbNodeIndex leftNode;
+	CymbNodeIndex rightNode;
 } CymbBinaryOperatorNode;
 
 /*
@@ -258,7 +259,7 @@ typedef struct CymbUnaryOperatorNode
 {
 	CymbUnaryOperator operator;
 
-	CymbNode* node;
+	CymbNodeIndex node;
 } CymbUnaryOperatorNode;
 
 /*
@@ -270,9 +271,9 @@ typedef struct CymbUnaryOperatorNode
  */
 typedef struct CymbFunctionCallNode
 {
-	CymbNode* name;
+	CymbNodeIndex name;
 
-	CymbNodeChild* arguments;
+	CymbNodeSpan arguments;
 } CymbFunctionCallNode;
 
 /*
@@ -284,9 +285,9 @@ typedef struct CymbFunctionCallNode
  */
 typedef struct CymbArraySubscriptNode
 {
-	CymbNode* name;
+	CymbNodeIndex name;
 
-	CymbNode* expression;
+	CymbNodeIndex expression;
 } CymbArraySubscriptNode;
 
 /*
@@ -310,8 +311,8 @@ typedef struct CymbMemberAccessNode
 {
 	CymbMemberAccessType type;
 
-	CymbNode* name;
-	CymbNode* member;
+	CymbNodeIndex name;
+	CymbNodeIndex member;
 } CymbMemberAccessNode;
 
 /*
@@ -334,7 +335,7 @@ typedef struct CymbPostfixOperatorNode
 {
 	CymbPostfixOperator operator;
 
-	CymbNode* node;
+	CymbNodeIndex node;
 } CymbPostfixOperatorNode;
 
 /*
@@ -342,7 +343,7 @@ typedef struct CymbPostfixOperatorNode
  *
  * Fields:
  * - type: The node type.
- * - info: The diagnostic info.
+ * - token: The index of the token the node comes from.
  * - programNode: The node data if it is a program node.
  * - functionNode: The node data if it is a function node.
  * - declarationNode: The node data if it is a declaration node.
@@ -363,7 +364,7 @@ typedef struct CymbNode
 {
 	CymbNodeType type;
 
-	CymbDiagnosticInfo info;
+	uint32_t token;
 
 	union
 	{
@@ -388,16 +389,40 @@ typedef struct CymbNode
 /*
  * An abstract syntax tree.
  *
+ * Nodes are stored in a single array and refer to each other by index, node 0 being reserved.
+ *
  * Fields:
- * - arena: The arena to use for allocations.
+ * - tokens: The tokens the nodes come from.
+ * - nodes: The nodes.
+ * - children: The indices of the child nodes.
+ * - scratch: The indices of the children of the lists being parsed.
+ * - operators: The operators of the expressions being parsed.
  * - root: The root of the tree.
+ * - nodeCount: The number of nodes added.
  */
 typedef struct CymbTree
 {
-	CymbArena* arena;
-	CymbNode* root;
+	const CymbToken* tokens;
+
+	CymbArray nodes;
+	CymbArray children;
+	CymbArray scratch;
+	CymbArray operators;
+
+	CymbNodeIndex root;
+
+	size_t nodeCount;
 } CymbTree;
 
+/*
+ * Create a tree.
+ *
+ * Parameters:
+ * - tree: The tree.
+ * - tokens: The tokens the nodes come from.
+ */
+void cymbTreeCreate(CymbTree* tree, const CymbToken* tokens);
+
 /*
  * A traversal direction for skipping parentheses.
  */
@@ -468,8 +493,25 @@ CymbResult cymbParseProgram(CymbTree* tree, CymbTokenList* tokens, CymbDiagnosti
  *
  * Parameters:
  * - tokens: The tokens.
- * - arena: The arena to use for allocations.
- * - tree: The tree.abort
+ * - tree: The tree.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_INVALID if it is invalid.
+ * - CYMB_OUT_OF_MEMORY if a node or diagnostic could not be added.
+ */
+CymbResult cymbParse(const CymbTokenList* tokens, CymbTree* tree, CymbDiagnosticList* diagnostics);
+
+/*
+ * Parse tokens using several threads.
+ * The tokens are split in chunks of whole functions, found from the partners of their bodies, which are parsed in parallel and merged in order.
+ * The tree, result and diagnostics are the same as with cymbParse.
+ *
+ * Parameters:
+ * - tokens: The tokens, whose brackets are matched.
+ * - threadCount: The maximum number of threads to use, including the calling thread.
+ * - tree: The tree.
  * - diagnostics: A list of diagnostics.
  *
  * Returns:
@@ -477,7 +519,44 @@ CymbResult cymbParseProgram(CymbTree* tree, CymbTokenList* tokens, CymbDiagnosti
  * - CYMB_INVALID if it is invalid.
  * - CYMB_OUT_OF_MEMORY if a node or diagnostic could not be added.
  */
-CymbResult cymbParse(const CymbTokenList* tokens, CymbArena* arena, CymbTree* tree, CymbDiagnosticList* diagnostics);
+CymbResult cymbParseParallel(const CymbTokenList* tokens, unsigned int threadCount, CymbTree* tree, CymbDiagnosticList* diagnostics);
+
+/*
+ * An edit of a source, replacing some characters by others.
+ *
+ * Fields:
+ * - offset: The offset of the edit.
+ * - removedLength: The number of characters removed from the previous source.
+ * - insertedLength: The number of characters inserted in the new source.
+ */
+typedef struct CymbEdit
+{
+	size_t offset;
+	size_t removedLength;
+	size_t insertedLength;
+} CymbEdit;
+
+/*
+ * Lex and parse a source again after an edit.
+ * Only the functions touched by the edit are lexed and parsed again, the other functions are reused.
+ * The tokens and tree are the same as with cymbLex and cymbParse, but diagnostics are only emitted for the functions parsed again.
+ * If the previous source was not successfully lexed and parsed, or the edit changes how the following functions are lexed, the whole source is lexed and parsed again.
+ *
+ * Parameters:
+ * - string: The new source.
+ * - standard: The standard in use, which decides what keywords are recognized.
+ * - edit: The edit from the previous source to the new one.
+ * - interner: The interner in which identifiers were interned.
+ * - tokens: The tokens of the previous source, replaced by those of the new one.
+ * - tree: The tree of the previous tokens, replaced by that of the new ones.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_INVALID if it is invalid.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+CymbResult cymbReparse(const char* string, CymbStandard standard, const CymbEdit* edit, CymbInterner* interner, CymbTokenList* tokens, CymbTree* tree, CymbDiagnosticList* diagnostics);
 
 /*
  * Free a tree.
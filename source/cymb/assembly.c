@@ -106,15 +106,20 @@ typedef struct CymbImmediate
 } CymbImmediate;
 
 /*
- * A label.
+ * The labels of a program.
  *
  * Fields:
- * - offset: The offset.
+ * - names: The interned names, whose symbols index the offsets.
+ * - offsets: The offset of each label.
+ * - capacity: The capacity of the offsets array.
  */
-typedef struct CymbLabel
+typedef struct CymbLabels
 {
-	size_t offset;
-} CymbLabel;
+	CymbInterner names;
+
+	size_t* offsets;
+	size_t capacity;
+} CymbLabels;
 
 /*
  * Compare two instructions by name.
@@ -444,7 +449,7 @@ static CymbResult cymbParseImmediate(CymbReader* const reader, CymbImmediate* co
  *
  * Parameters:
  * - reader: A reader.
- * - labels: A list of labels.
+ * - labels: The labels of the program.
  * - offset: The current offset.
  * - instruction: The instruction to test.
  * - code: The parsed code.
@@ -455,7 +460,7 @@ static CymbResult cymbParseImmediate(CymbReader* const reader, CymbImmediate* co
  * - CYMB_NO_MATCH if it does not match.
  * - CYMB_INVALID if it is invalid.
  */
-static CymbResult cymbParseInstruction(CymbReader* const reader, CymbMap* const labels, const size_t offset, const CymbInstruction* const instruction, uint32_t* const code, CymbDiagnosticList* const diagnostics)
+static CymbResult cymbParseInstruction(CymbReader* const reader, const CymbLabels* const labels, const size_t offset, const CymbInstruction* const instruction, uint32_t* const code, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
 
@@ -1179,13 +1184,13 @@ static CymbResult cymbParseInstruction(CymbReader* const reader, CymbMap* const
 				}
 				label.length = reader->string - label.string;
 
-				const CymbLabel* const labelData = cymbMapRead(labels, label);
-				if(!labelData)
+				uint32_t symbol;
+				if(!cymbInternerFind(&labels->names, label, &symbol))
 				{
 					break;
 				}
 
-				const int32_t labelOffset = ((int32_t)labelData->offset - offset) * 4;
+				const int32_t labelOffset = ((int32_t)labels->offsets[symbol] - offset) * 4;
 
 				const uint32_t lo = labelOffset & 0b11;
 				*code |= lo << 29;
@@ -1248,24 +1253,21 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
 	*count = 0;
 	*codes = nullptr;
 
+	CymbArray codeArray;
+	cymbArrayCreate(&codeArray, sizeof((*codes)[0]));
+
+	cymbDiagnosticListSetSource(diagnostics, string);
+
 	CymbReader reader;
 	cymbReaderCreate(string, diagnostics->tabWidth, &reader);
 
-	CymbMap map;
-	result = cymbMapCreate(&map, diagnostics->arena, 32, sizeof(CymbLabel), alignof(CymbLabel));
+	CymbLabels labels = {};
+	result = cymbInternerCreate(&labels.names, diagnostics->arena);
 	if(result != CYMB_SUCCESS)
 	{
 		goto error;
 	}
 
-	size_t capacity = 32;
-	*codes = malloc(capacity * sizeof((*codes)[0]));
-	if(!codes)
-	{
-		result = CYMB_OUT_OF_MEMORY;
-		goto error;
-	}
-
 	CymbReader labelsReader = reader;
 	size_t offset = 0;
 	const char* colon = strchr(labelsReader.string, ':');
@@ -1326,7 +1328,8 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
 			goto error;
 		}
 
-		if(cymbMapRead(&map, info.hint) != nullptr)
+		uint32_t symbol;
+		if(cymbInternerFind(&labels.names, info.hint, &symbol))
 		{
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_DUPLICATE_LABEL,
@@ -1337,12 +1340,28 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
 			goto error;
 		}
 
-		result = cymbMapStore(&map, info.hint, &(CymbLabel){.offset = offset});
+		result = cymbIntern(&labels.names, info.hint, &symbol);
 		if(result != CYMB_SUCCESS)
 		{
 			goto error;
 		}
 
+		// Only labels are interned, so the symbols are consecutive.
+		if(symbol == labels.capacity)
+		{
+			const size_t capacity = labels.capacity == 0 ? 16 : labels.capacity * 2;
+			size_t* const offsets = realloc(labels.offsets, capacity * sizeof(labels.offsets[0]));
+			if(!offsets)
+			{
+				result = CYMB_OUT_OF_MEMORY;
+				goto error;
+			}
+
+			labels.offsets = offsets;
+			labels.capacity = capacity;
+		}
+		labels.offsets[symbol] = offset;
+
 		cymbReaderPop(&labelsReader);
 
 		colon = strchr(colon + 1, ':');
@@ -1352,25 +1371,11 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
 	offset = 0;
 	while(*reader.string != '\0')
 	{
-		if(*count == capacity)
+		uint32_t* const code = cymbArrayPush(&codeArray, 1);
+		if(!code)
 		{
-			if(capacity >= cymbSizeMax / sizeof((*codes)[0]))
-			{
-				result = CYMB_OUT_OF_MEMORY;
-				goto error;
-			}
-
-			const size_t newCapacity = capacity >= cymbSizeMax / sizeof((*codes)[0]) / 2 ? cymbSizeMax / sizeof((*codes)[0]) : capacity * 2;
-
-			uint32_t* const newCodes = realloc(*codes, capacity * sizeof((*codes)[0]));
-			if(!newCodes)
-			{
-				result = CYMB_OUT_OF_MEMORY;
-				goto error;
-			}
-
-			*codes = newCodes;
-			capacity = newCapacity;
+			result = CYMB_OUT_OF_MEMORY;
+			goto error;
 		}
 
 		cymbReaderSkipSpaces(&reader);
@@ -1445,7 +1450,7 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
 			const CymbDiagnosticList diagnosticsCopy = *diagnostics;
 			const CymbArenaSave save = cymbArenaSave(diagnostics->arena);
 
-			result = cymbParseInstruction(&reader, &map, offset, instruction, &(*codes)[*count], diagnostics);
+			result = cymbParseInstruction(&reader, &labels, offset, instruction, code, diagnostics);
 
 			if(result == CYMB_SUCCESS || result == CYMB_INVALID)
 			{
@@ -1473,19 +1478,21 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
 			goto error;
 		}
 
-		++*count;
 		++offset;
 	}
 
+	*codes = codeArray.data;
+	*count = codeArray.count;
+
 	goto end;
 
 	error:
 	result = result == CYMB_SUCCESS || result == CYMB_NO_MATCH ? CYMB_INVALID : result;
-	CYMB_FREE(*codes);
-	*count = 0;
+	cymbArrayFree(&codeArray);
 
 	end:
-	cymbMapFree(&map);
+	cymbInternerFree(&labels.names);
+	free(labels.offsets);
 	return result;
 }
 
@@ -1493,8 +1500,7 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
  * Append a format string and its arguments to a string.
  *
  * Parameters:
- * - string: The base string.
- * - capacity: The capacity of the string.
+ * - string: The array of characters of the string, which stays null-terminated.
  * - format: The format string.
  * - The arguments of the format string.
  *
@@ -1503,7 +1509,7 @@ CymbResult cymbAssemble(const char* const string, uint32_t** const codes, size_t
  * - CYMB_INVALID if it is invalid.
  * - CYMB_OUT_OF_MEMORY if an allocation failed.
  */
-static CymbResult cymbAppend(CymbString* const string, size_t* const capacity, const char* const format, ...)
+static CymbResult cymbAppend(CymbArray* const string, const char* const format, ...)
 {
 	CymbResult result = CYMB_SUCCESS;
 
@@ -1520,33 +1526,20 @@ static CymbResult cymbAppend(CymbString* const string, size_t* const capacity, c
 		goto end;
 	}
 
-	if(*capacity - length <= string->length)
+	// Room is made for the null character, which is not counted.
+	char* const characters = cymbArrayPush(string, length + 1);
+	if(!characters)
 	{
-		if(*capacity == cymbSizeMax)
-		{
-			result = CYMB_OUT_OF_MEMORY;
-			goto end;
-		}
-
-		const size_t newCapacity = *capacity >= cymbSizeMax / 2 ? cymbSizeMax : *capacity * 2;
-
-		char* const newString = realloc(string->string, newCapacity);
-		if(!newString)
-		{
-			result = CYMB_OUT_OF_MEMORY;
-			goto end;
-		}
-
-		string->string = newString;
-		*capacity = newCapacity;
+		result = CYMB_OUT_OF_MEMORY;
+		goto end;
 	}
+	--string->count;
 
-	if(vsnprintf(string->string + string->length, length + 1, format, stringArguments) != length)
+	if(vsnprintf(characters, length + 1, format, stringArguments) != length)
 	{
 		result = CYMB_INVALID;
 		goto end;
 	}
-	string->length += length;
 
 	end:
 	va_end(stringArguments);
@@ -1557,15 +1550,19 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 {
 	CymbResult result = CYMB_SUCCESS;
 
-	string->length = 0;
+	*string = (CymbString){};
+
+	CymbArray characters;
+	cymbArrayCreate(&characters, sizeof(char));
 
-	size_t stringCapacity = 256;
-	string->string = malloc(stringCapacity);
-	if(!string->string)
+	char* const empty = cymbArrayPush(&characters, 1);
+	if(!empty)
 	{
 		result = CYMB_OUT_OF_MEMORY;
-		goto end;
+		goto error;
 	}
+	*empty = '\0';
+	characters.count = 0;
 
 	for(size_t codeIndex = 0; codeIndex < count; ++codeIndex)
 	{
@@ -1622,7 +1619,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 			}
 		}
 
-		result = cymbAppend(string, &stringCapacity, instruction->name);
+		result = cymbAppend(&characters, instruction->name);
 
 		const char* parameters = instruction->parameters;
 		bool firstParameter = true;
@@ -1653,7 +1650,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 				{
 					if(!firstParameter)
 					{
-						result = cymbAppend(string, &stringCapacity, ",");
+						result = cymbAppend(&characters, ",");
 						if(result != CYMB_SUCCESS)
 						{
 							goto error;
@@ -1661,7 +1658,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					}
 					firstParameter = false;
 
-					result = cymbAppend(string, &stringCapacity, " ");
+					result = cymbAppend(&characters, " ");
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1677,7 +1674,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					{
 						if(parameter == 'Z')
 						{
-							result = cymbAppend(string, &stringCapacity, isX ? "XZR" : "WZR");
+							result = cymbAppend(&characters, isX ? "XZR" : "WZR");
 							if(result != CYMB_SUCCESS)
 							{
 								goto error;
@@ -1687,7 +1684,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 						{
 							hasSp = true;
 
-							result = cymbAppend(string, &stringCapacity, isX ? "SP" : "WSP");
+							result = cymbAppend(&characters, isX ? "SP" : "WSP");
 							if(result != CYMB_SUCCESS)
 							{
 								goto error;
@@ -1696,7 +1693,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					}
 					else
 					{
-						result = cymbAppend(string, &stringCapacity, "%c%hhu", isX ? 'X' : 'W', registerNumber);
+						result = cymbAppend(&characters, "%c%hhu", isX ? 'X' : 'W', registerNumber);
 						if(result != CYMB_SUCCESS)
 						{
 							goto error;
@@ -1723,7 +1720,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					const unsigned char option = codes[codeIndex] >> optionShift & 0b111;
 					const unsigned char immediate = codes[codeIndex] >> immediateShift & 0b111;
 
-					result = cymbAppend(string, &stringCapacity, ", %c%hhu", isX && option & 0b11 ? 'X' : 'W', registerNumber);
+					result = cymbAppend(&characters, ", %c%hhu", isX && option & 0b11 ? 'X' : 'W', registerNumber);
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1738,12 +1735,12 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 							break;
 						}
 
-						result = cymbAppend(string, &stringCapacity, ", LSL #%hhu", immediate);
+						result = cymbAppend(&characters, ", LSL #%hhu", immediate);
 
 						break;
 					}
 
-					result = cymbAppend(string, &stringCapacity, ", %cXT%c", option & 0b100 ? 'S' : 'U', extensions[option & 0b11]);
+					result = cymbAppend(&characters, ", %cXT%c", option & 0b100 ? 'S' : 'U', extensions[option & 0b11]);
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1751,7 +1748,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 
 					if(immediate != 0)
 					{
-						result = cymbAppend(string, &stringCapacity, " #%hhu", immediate);
+						result = cymbAppend(&characters, " #%hhu", immediate);
 						if(result != CYMB_SUCCESS)
 						{
 							goto error;
@@ -1772,7 +1769,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					parameters = end - 1;
 
 					const uint32_t immediate = codes[codeIndex] >> shift & ((UINT32_C(1) << immediateWidth) - 1);
-					result = cymbAppend(string, &stringCapacity, ", #0x%"PRIX32, immediate);
+					result = cymbAppend(&characters, ", #0x%"PRIX32, immediate);
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1781,7 +1778,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					const bool hasShift = codes[codeIndex] >> (shift + immediateWidth) & 1;
 					if(hasShift)
 					{
-						result = cymbAppend(string, &stringCapacity, ", LSL #12");
+						result = cymbAppend(&characters, ", LSL #12");
 						if(result != CYMB_SUCCESS)
 						{
 							goto error;
@@ -1819,7 +1816,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 						goto error;
 					}
 
-					result = cymbAppend(string, &stringCapacity, ", ");
+					result = cymbAppend(&characters, ", ");
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1856,13 +1853,13 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 						default:
 							unreachable();
 					}
-					result = cymbAppend(string, &stringCapacity, shiftTypeString);
+					result = cymbAppend(&characters, shiftTypeString);
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
 					}
 
-					result = cymbAppend(string, &stringCapacity, " #%hhu", immediate);
+					result = cymbAppend(&characters, " #%hhu", immediate);
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1932,7 +1929,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					}
 
 					const uint64_t rotated = cymbRotateRight64(bases[size - 1] * pattern, immr);
-					result = cymbAppend(string, &stringCapacity, ", #0x%"PRIX64, rotated);
+					result = cymbAppend(&characters, ", #0x%"PRIX64, rotated);
 					if(result != CYMB_SUCCESS)
 					{
 						goto error;
@@ -1954,7 +1951,7 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 					}
 
 					const uint32_t o = codeIndex * 4 + offset;
-					cymbAppend(string, &stringCapacity, ", 0x%"PRIX32, o);
+					cymbAppend(&characters, ", 0x%"PRIX32, o);
 
 					break;
 				}
@@ -1966,19 +1963,23 @@ CymbResult cymbDisassemble(const uint32_t* const codes, const size_t count, Cymb
 			parameters += *parameters != '\0';
 		}
 
-		result = cymbAppend(string, &stringCapacity, "\n");
+		result = cymbAppend(&characters, "\n");
 		if(result != CYMB_SUCCESS)
 		{
 			goto error;
 		}
 	}
 
+	*string = (CymbString){
+		.string = characters.data,
+		.length = characters.count
+	};
+
 	goto end;
 
 	error:
 	result = result == CYMB_SUCCESS ? CYMB_INVALID : result;
-	CYMB_FREE(string->string);
-	string->length = 0;
+	cymbArrayFree(&characters);
 
 	end:
 	return result;
@@ -4,6 +4,30 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * A source file.
+ *
+ * Fields:
+ * - string: The contents of the file, followed by a null character.
+ * - length: The length of the contents.
+ * - mappingSize: The size of the mapping if the contents are mapped, 0 if they are allocated.
+ */
+typedef struct CymbSource
+{
+	char* string;
+	size_t length;
+
+	size_t mappingSize;
+} CymbSource;
+
 /*
  * Read all the contents of a file in text mode.
  *
@@ -30,19 +54,20 @@ static CymbResult cymbReadFile(const char* const path, CymbString* const string)
 		goto end;
 	}
 
-	// Allocate initial buffer.
-	size_t capacity = 1024;
-	string->string = malloc(capacity);
-	if(!string->string)
-	{
-		goto error;
-	}
+	CymbArray characters;
+	cymbArrayCreate(&characters, sizeof(char));
 
-	size_t toRead = capacity;
 	while(true)
 	{
-		const size_t read = fread(string->string + string->length, 1, toRead, file);
-		string->length += read;
+		// Read into all the free capacity, keeping room for the null character.
+		if(cymbArrayReserve(&characters, characters.count + 1024) != CYMB_SUCCESS)
+		{
+			goto error;
+		}
+
+		const size_t toRead = characters.capacity - characters.count - 1;
+		const size_t read = fread((char*)characters.data + characters.count, 1, toRead, file);
+		characters.count += read;
 
 		if(read < toRead)
 		{
@@ -51,43 +76,21 @@ static CymbResult cymbReadFile(const char* const path, CymbString* const string)
 				goto error;
 			}
 
-			if(string->length >= cymbSizeMax)
-			{
-				goto error;
-			}
-
-			char* const newString = realloc(string->string, string->length + 1);
-			if(!newString)
-			{
-				goto error;
-			}
-			string->string = newString;
-			string->string[string->length] = '\0';
+			((char*)characters.data)[characters.count] = '\0';
 
 			if(fclose(file) != 0)
 			{
 				result = CYMB_OUT_OF_MEMORY;
 				goto clear;
 			}
-			
-			goto end;
-		}
-
-		if(capacity == cymbSizeMax)
-		{
-			goto error;
-		}
 
-		const size_t newCapacity = capacity > cymbSizeMax / 2 ? cymbSizeMax : capacity * 2;
-		toRead = newCapacity - capacity;
-		capacity = newCapacity;
+			*string = (CymbString){
+				.string = characters.data,
+				.length = characters.count
+			};
 
-		char* const newString = realloc(string->string, capacity);
-		if(!newString)
-		{
-			goto error;
+			goto end;
 		}
-		string->string = newString;
 	}
 
 	error:
@@ -95,32 +98,161 @@ static CymbResult cymbReadFile(const char* const path, CymbString* const string)
 	fclose(file);
 
 	clear:
-	free(string->string);
-	*string = (CymbString){};
+	cymbArrayFree(&characters);
 
 	end:
 	return result;
 }
 
+/*
+ * Map a file in memory, followed by at least one null character.
+ *
+ * Parameters:
+ * - path: Path of the file.
+ * - source: A source where to store the mapping.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_FILE_NOT_FOUND if the file could not be opened.
+ * - CYMB_NO_MATCH if the file cannot be mapped, for example if it is a pipe.
+ */
+static CymbResult cymbMapFile(const char* const path, CymbSource* const source)
+{
+	*source = (CymbSource){};
+
+#ifdef __linux__
+	CymbResult result = CYMB_NO_MATCH;
+
+	const int file = open(path, O_RDONLY);
+	if(file == -1)
+	{
+		return CYMB_FILE_NOT_FOUND;
+	}
+
+	struct stat status;
+	if(fstat(file, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= 0)
+	{
+		goto end;
+	}
+
+	const long pageSize = sysconf(_SC_PAGESIZE);
+	if(pageSize <= 0 || (unsigned long long)status.st_size > cymbSizeMax - (size_t)pageSize)
+	{
+		goto end;
+	}
+
+	// The end of the last page is zero filled, unless the file fills it completely.
+	// In that case, reserve an additional zero page to act as the null terminator.
+	const size_t length = status.st_size;
+	const size_t mappingSize = (length / pageSize + 1) * pageSize;
+
+	char* const reservation = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(reservation == MAP_FAILED)
+	{
+		goto end;
+	}
+
+	char* const string = mmap(reservation, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, file, 0);
+	if(string == MAP_FAILED)
+	{
+		munmap(reservation, mappingSize);
+		goto end;
+	}
+
+	*source = (CymbSource){
+		.string = string,
+		.length = length,
+		.mappingSize = mappingSize
+	};
+	result = CYMB_SUCCESS;
+
+	end:
+	close(file);
+	return result;
+#else
+	(void)path;
+
+	return CYMB_NO_MATCH;
+#endif
+}
+
+/*
+ * Load a source file, mapping it if possible and reading it otherwise.
+ *
+ * Parameters:
+ * - path: Path of the file.
+ * - source: A source where to store the contents of the file.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_FILE_NOT_FOUND if the file could not be opened.
+ * - CYMB_OUT_OF_MEMORY otherwise.
+ */
+static CymbResult cymbLoadFile(const char* const path, CymbSource* const source)
+{
+	const CymbResult result = cymbMapFile(path, source);
+	if(result != CYMB_NO_MATCH)
+	{
+		return result;
+	}
+
+	CymbString string;
+	const CymbResult readResult = cymbReadFile(path, &string);
+	*source = (CymbSource){
+		.string = string.string,
+		.length = string.length
+	};
+
+	return readResult;
+}
+
+/*
+ * Free a source file.
+ *
+ * Parameters:
+ * - source: A source.
+ */
+static void cymbFreeSource(CymbSource* const source)
+{
+#ifdef __linux__
+	if(source->mappingSize > 0)
+	{
+		munmap(source->string, source->mappingSize);
+		*source = (CymbSource){};
+		return;
+	}
+#endif
+
+	cymbArrayDataFree(source->string);
+	*source = (CymbSource){};
+}
+
 /*
  * Compile a source file.
  *
  * Parameters:
  * - arena: An arena to use for allocations.
+ * - standard: The standard to compile with.
+ * - threadCount: The maximum number of threads to use.
  * - diagnostics: A list of diagnostics.
+ * - tokenCount: Set to the number of tokens.
+ * - nodeCount: Set to the number of nodes.
  *
  * Returns:
  * - CYMB_SUCCESS on success.
  * - CYMB_FILE_NOT_FOUND if the file could not be opened.
  * - CYMB_OUT_OF_MEMORY if the code is too large.
  */
-static CymbResult cymbCompile(CymbArena* const arena, CymbDiagnosticList* const diagnostics)
+static CymbResult cymbCompile(CymbArena* const arena, const CymbStandard standard, const unsigned int threadCount, CymbDiagnosticList* const diagnostics, size_t* const tokenCount, size_t* const nodeCount)
 {
+	*tokenCount = 0;
+	*nodeCount = 0;
+
 	CymbResult result;
 
 	// Get source code.
-	CymbString source;
-	result = cymbReadFile(diagnostics->file, &source);
+	CymbSource source;
+	result = cymbLoadFile(diagnostics->file, &source);
 	if(result != CYMB_SUCCESS)
 	{
 		switch(result)
@@ -140,36 +272,99 @@ static CymbResult cymbCompile(CymbArena* const arena, CymbDiagnosticList* const
 		goto end;
 	}
 
+	CymbInterner interner;
+	result = cymbInternerCreate(&interner, arena);
+	if(result != CYMB_SUCCESS)
+	{
+		goto clear;
+	}
+
 	CymbTokenList tokens;
-	result = cymbLex(source.string, &tokens, diagnostics);
+	result = cymbLexParallel(source.string, standard, threadCount, &interner, &tokens, diagnostics);
 	if(result != CYMB_SUCCESS && result != CYMB_INVALID)
 	{
 		goto clear;
 	}
 
-	CymbTree tree;
-	const CymbResult parseResult = cymbParse(&tokens, arena, &tree, diagnostics);
-	if(parseResult != CYMB_SUCCESS)
+	// Parsing is skipped once the error limit is reached.
+	CymbTree tree = {};
+	if(!cymbDiagnosticListFull(diagnostics))
 	{
-		result = parseResult;
+		const CymbResult parseResult = cymbParseParallel(&tokens, threadCount, &tree, diagnostics);
+		if(parseResult != CYMB_SUCCESS)
+		{
+			result = parseResult;
+		}
 	}
 
+	*tokenCount = tokens.count;
+	*nodeCount = tree.nodeCount;
+
 	cymbFreeTree(&tree);
 	cymbFreeTokenList(&tokens);
 
 	clear:
 	cymbDiagnosticListPrint(diagnostics);
 
-	free(source.string);
+	cymbInternerFree(&interner);
+	cymbFreeSource(&source);
+	cymbDiagnosticListSetSource(diagnostics, nullptr);
 
 	end:
 	return result;
 }
 
+/*
+ * Print the statistics of an input.
+ *
+ * Parameters:
+ * - file: The input file.
+ * - stats: The statistics of the arena used for the input.
+ * - compiled: Flag indicating if the input was compiled, so that token and node counts are meaningful.
+ * - tokenCount: The number of tokens.
+ * - nodeCount: The number of nodes.
+ */
+static void cymbPrintStats(const char* const file, const CymbArenaStats* const stats, const bool compiled, const size_t tokenCount, const size_t nodeCount)
+{
+	fprintf(stderr, "Statistics of \"%s\":\n", file);
+
+	if(compiled)
+	{
+		fprintf(stderr, "  Tokens:             %zu\n", tokenCount);
+		fprintf(stderr, "  Nodes:              %zu\n", nodeCount);
+	}
+
+	fprintf(stderr, "  Requested bytes:    %zu\n", stats->requestedSize);
+	fprintf(stderr, "  Padding bytes:      %zu\n", stats->paddingSize);
+	fprintf(stderr, "  Regions:            %zu\n", stats->regionCount);
+	fprintf(stderr, "  Peak arena bytes:   %zu\n", stats->peakSize);
+	fprintf(stderr, "  Full region skips:  %zu\n", stats->fullRegionCount);
+
+#ifdef __linux__
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+		fprintf(stderr, "  Peak RSS:           %ld KiB\n", usage.ru_maxrss);
+	}
+#endif
+}
+
+/*
+ * Maximum total size of the free regions kept in the pool.
+ */
+constexpr size_t cymbPoolMaxSize = 0x10000000;
+
 CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumentCount)
 {
+	// The arenas of every thread share a pool, which is trimmed to the retained size between input files.
+	CymbRegionPool pool;
+	if(cymbRegionPoolCreate(&pool, cymbPoolMaxSize) != CYMB_SUCCESS)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
 	CymbArena arena;
-	cymbArenaCreate(&arena);
+	cymbArenaCreatePooled(&arena, &pool);
 
 	CymbDiagnosticList diagnostics;
 	cymbDiagnosticListCreate(&diagnostics, &arena, nullptr, 8);
@@ -178,6 +373,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 	CymbOptions options;
 	CymbResult result = cymbParseArguments(arguments, argumentCount, &options, &diagnostics);
 	diagnostics.tabWidth = options.tabWidth;
+	diagnostics.limit = options.errorLimit;
 
 	cymbDiagnosticListPrint(&diagnostics);
 
@@ -198,21 +394,31 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 	// Compile file.
 	for(size_t inputIndex = 0; inputIndex < options.inputCount; ++inputIndex)
 	{
+		// Only the first region of the main arena stays hot, the others go back to the pool.
 		cymbArenaClear(&arena);
+		cymbArenaTrim(&arena, (CymbRetention){
+			.keepFirstRegion = true
+		});
+		cymbRegionPoolTrim(&pool, options.retainedSize);
+		cymbArenaResetStats(&arena);
 		cymbDiagnosticListFree(&diagnostics);
 
 		diagnostics.file = options.inputs[inputIndex];
 
 		CymbResult fileResult = CYMB_SUCCESS;
 
+		bool compiled = false;
+		size_t tokenCount = 0;
+		size_t nodeCount = 0;
+
 		const size_t length = strlen(options.inputs[inputIndex]);
 		if(length >= 2 && options.inputs[inputIndex][length - 2] == '.' && options.inputs[inputIndex][length - 1] == 's')
 		{
-			CymbString string;
-			fileResult = cymbReadFile(options.inputs[inputIndex], &string);
+			CymbSource string;
+			fileResult = cymbLoadFile(options.inputs[inputIndex], &string);
 			if(fileResult != CYMB_SUCCESS)
 			{
-				switch(result)
+				switch(fileResult)
 				{
 					case CYMB_FILE_NOT_FOUND:
 						fprintf(stderr, "Failed to open file \"%s\".\n", diagnostics.file);
@@ -234,7 +440,8 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 			fileResult = cymbAssemble(string.string, &codes, &count, &diagnostics);
 
 			cymbDiagnosticListPrint(&diagnostics);
-			free(string.string);
+			cymbFreeSource(&string);
+			cymbDiagnosticListSetSource(&diagnostics, nullptr);
 
 			if(fileResult != CYMB_SUCCESS)
 			{
@@ -245,7 +452,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 			{
 				fileResult = CYMB_OUT_OF_MEMORY;
 
-				free(codes);
+				cymbArrayDataFree(codes);
 
 				goto next;
 			}
@@ -256,7 +463,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 			{
 				fileResult = CYMB_OUT_OF_MEMORY;
 
-				free(codes);
+				cymbArrayDataFree(codes);
 
 				goto next;
 			}
@@ -275,7 +482,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 				fprintf(stderr, "Failed to open file \"%s\".\n", output);
 
 				free(output);
-				free(codes);
+				cymbArrayDataFree(codes);
 
 				goto next;
 			}
@@ -284,7 +491,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 			{
 				fclose(file);
 				free(output);
-				free(codes);
+				cymbArrayDataFree(codes);
 
 				goto next;
 			}
@@ -295,7 +502,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 			}
 
 			free(output);
-			free(codes);
+			cymbArrayDataFree(codes);
 
 			goto next;
 		}
@@ -372,19 +579,25 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 
 			if(fileResult != CYMB_SUCCESS)
 			{
-				free(assembly.string);
+				cymbArrayDataFree(assembly.string);
 				goto next;
 			}
 
 			fputs(assembly.string, stdout);
-			free(assembly.string);
+			cymbArrayDataFree(assembly.string);
 
 			goto next;
 		}
 
-		fileResult = cymbCompile(&arena, &diagnostics);
+		fileResult = cymbCompile(&arena, options.standard, options.threadCount, &diagnostics, &tokenCount, &nodeCount);
+		compiled = true;
 
 		next:
+		if(options.stats)
+		{
+			cymbPrintStats(diagnostics.file, &arena.stats, compiled, tokenCount, nodeCount);
+		}
+
 		if(
 			(fileResult == CYMB_OUT_OF_MEMORY) ||
 			((result == CYMB_SUCCESS || result == CYMB_FILE_NOT_FOUND) && fileResult == CYMB_INVALID) ||
@@ -403,6 +616,7 @@ CymbResult cymbMain(const CymbConstString* const arguments, const size_t argumen
 	clear:
 	free(options.inputs);
 	cymbArenaFree(&arena);
+	cymbRegionPoolFree(&pool);
 
 	return result;
 }
@@ -6,281 +6,455 @@
 #include <string.h>
 
 /*
- * Print a diagnostic.
+ * Get the message of a diagnostic type.
  *
  * Parameters:
- * - diagnostic: A diagnostic.
- * - file: The file for which the diagnostic was emitted.
- * - tabWidth: The tab width to use for printing.
+ * - type: A diagnostic type.
+ *
+ * Returns:
+ * - The message.
  */
-static void cymbDiagnosticPrint(const CymbDiagnostic* const diagnostic, const char* const file, const unsigned char tabWidth)
+static const char* cymbDiagnosticMessage(const CymbDiagnosticType type)
 {
-	if(diagnostic->info.line.string)
-	{
-		fprintf(stderr, "In file %s, line %zu, column %zu:\n", file, diagnostic->info.position.line, diagnostic->info.position.column);
-	}
-
-	switch(diagnostic->type)
+	switch(type)
 	{
 		case CYMB_TOO_MANY_INPUTS:
-			fputs("Too many inputs.\n", stderr);
-			break;
+			return "Too many inputs.";
 
 		case CYMB_UNKNOWN_OPTION:
-			fputs("Unknown option.\n", stderr);
-			break;
+			return "Unknown option.";
 
 		case CYMB_MISSING_ARGUMENT:
-			fputs("Missing argument.\n", stderr);
-			break;
+			return "Missing argument.";
 
 		case CYMB_UNEXPECTED_ARGUMENT:
-			fputs("Unexpected argument.\n", stderr);
-			break;
+			return "Unexpected argument.";
 
 		case CYMB_INVALID_ARGUMENT:
-			fputs("Invalid argument.\n", stderr);
-			break;
+			return "Invalid argument.";
 
 		case CYMB_UNKNOWN_TOKEN:
-			fputs("Unknown token.\n", stderr);
-			break;
+			return "Unknown token.";
 
 		case CYMB_INVALID_CONSTANT_SUFFIX:
-			fputs("Invalid constant suffix.\n", stderr);
-			break;
+			return "Invalid constant suffix.";
 
 		case CYMB_INVALID_CHARACTER_CONSTANT:
-			fputs("Invalid character constant.\n", stderr);
-			break;
+			return "Invalid character constant.";
 
 		case CYMB_INVALID_STRING_CHARACTER:
-			fputs("Invalid character in string.\n", stderr);
-			break;
+			return "Invalid character in string.";
 
 		case CYMB_UNFINISHED_STRING:
-			fputs("Unfinished string.\n", stderr);
-			break;
+			return "Unfinished string.";
+
+		case CYMB_UNFINISHED_COMMENT:
+			return "Unfinished comment.";
 
 		case CYMB_CONSTANT_TOO_LARGE:
-			fputs("Integer constant too large.\n", stderr);
-			break;
+			return "Integer constant too large.";
 
 		case CYMB_SEPARATOR_AFTER_BASE:
-			fputs("Digit separator after base prefix.\n", stderr);
-			break;
+			return "Digit separator after base prefix.";
 
 		case CYMB_DUPLICATE_SEPARATORS:
-			fputs("Duplicate digit separators.\n", stderr);
-			break;
+			return "Duplicate digit separators.";
 
 		case CYMB_TRAILING_SEPARATOR:
-			fputs("Trailing digit separator.\n", stderr);
-			break;
+			return "Trailing digit separator.";
 
 		case CYMB_UNEXPECTED_TOKEN:
-			fputs("Unexpected token.\n", stderr);
-			break;
+			return "Unexpected token.";
 
 		case CYMB_UNMATCHED_PARENTHESIS:
-			fputs("Unmatched parenthesis.\n", stderr);
-			break;
+			return "Unmatched parenthesis.";
 
 		case CYMB_UNMATCHED_BRACE:
-			fputs("Unmatched brace.\n", stderr);
-			break;
+			return "Unmatched brace.";
 
 		case CYMB_UNMATCHED_BRACKET:
-			fputs("Unmatched bracket.\n", stderr);
-			break;
+			return "Unmatched bracket.";
 
 		case CYMB_MULTIPLE_CONST:
-			fputs("Multiple const specification.\n", stderr);
-			break;
+			return "Multiple const specification.";
 
 		case CYMB_MULTIPLE_RESTRICT:
-			fputs("Multiple restrict specification.\n", stderr);
-			break;
+			return "Multiple restrict specification.";
 
 		case CYMB_MULTIPLE_STATIC:
-			fputs("Multiple static specification.\n", stderr);
-			break;
+			return "Multiple static specification.";
 
 		case CYMB_MISSING_TYPE:
-			fputs("Missing type.\n", stderr);
-			break;
+			return "Missing type.";
 
 		case CYMB_EXPECTED_EXPRESSION:
-			fputs("Expected expression.\n", stderr);
-			break;
+			return "Expected expression.";
 
 		case CYMB_INVALID_DECLARATION:
-			fputs("Invalid declaration.\n", stderr);
-			break;
+			return "Invalid declaration.";
 
 		case CYMB_EXPECTED_PARENTHESIS:
-			fputs("Expected parenthesis.\n", stderr);
-			break;
+			return "Expected parenthesis.";
 
 		case CYMB_EXPECTED_SEMICOLON:
-			fputs("Expected semicolon.\n", stderr);
-			break;
+			return "Expected semicolon.";
 
 		case CYMB_EXPECTED_FUNCTION:
-			fputs("Expected function.\n", stderr);
-			break;
+			return "Expected function.";
 
 		case CYMB_EXPECTED_PARAMETER:
-			fputs("Expected parameter.\n", stderr);
-			break;
+			return "Expected parameter.";
 
 		case CYMB_EXPECTED_IDENTIFIER:
-			fputs("Expected identifier.\n", stderr);
-			break;
+			return "Expected identifier.";
 
 		case CYMB_INVALID_TYPE:
-			fputs("Invalid type.\n", stderr);
-			break;
+			return "Invalid type.";
 
 		case CYMB_UNKNOWN_INSTRUCTION:
-			fputs("Unknown instruction.\n", stderr);
-			break;
+			return "Unknown instruction.";
 
 		case CYMB_UNEXPECTED_CHARACTERS_AFTER_INSTRUCTION:
-			fputs("Unexpected characters after instruction.\n", stderr);
-			break;
+			return "Unexpected characters after instruction.";
 
 		case CYMB_MISSING_SPACE:
-			fputs("Missing space.\n", stderr);
-			break;
+			return "Missing space.";
 
 		case CYMB_MISSING_COMMA:
-			fputs("Missing comma.\n", stderr);
-			break;
+			return "Missing comma.";
 
 		case CYMB_EXPECTED_REGISTER:
-			fputs("Expected a register.\n", stderr);
-			break;
+			return "Expected a register.";
 
 		case CYMB_EXPECTED_IMMEDIATE:
-			fputs("Expected an immediate.\n", stderr);
-			break;
+			return "Expected an immediate.";
 
 		case CYMB_INVALID_REGISTER:
-			fputs("Invalid register.\n", stderr);
-			break;
+			return "Invalid register.";
 
 		case CYMB_EXPECTED_SP:
-			fputs("Expected an SP register.\n", stderr);
-			break;
+			return "Expected an SP register.";
 
 		case CYMB_INVALID_SP:
-			fputs("Invalid SP register.\n", stderr);
-			break;
+			return "Invalid SP register.";
 
 		case CYMB_INVALID_ZR:
-			fputs("Invalid ZR register.\n", stderr);
-			break;
+			return "Invalid ZR register.";
 
 		case CYMB_INVALID_REGISTER_WIDTH:
-			fputs("Invalid register width.\n", stderr);
-			break;
+			return "Invalid register width.";
 
 		case CYMB_INVALID_IMMEDIATE:
-			fputs("Invalid immediate.\n", stderr);
-			break;
+			return "Invalid immediate.";
 
 		case CYMB_INVALID_EXTENSION:
-			fputs("Invalid extension.\n", stderr);
-			break;
+			return "Invalid extension.";
 
 		case CYMB_DUPLICATE_LABEL:
-			fputs("Duplicate label.\n", stderr);
-			break;
+			return "Duplicate label.";
 
 		case CYMB_INVALID_LABEL:
-			fputs("Invalid label.\n", stderr);
-			break;
+			return "Invalid label.";
 
 		default:
 			unreachable();
 	}
+}
+
+/*
+ * Append characters to a string being rendered.
+ *
+ * Parameters:
+ * - string: The array of characters of the string.
+ * - characters: The characters to append.
+ * - length: The number of characters.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbRenderCharacters(CymbArray* const string, const char* const characters, const size_t length)
+{
+	char* const end = cymbArrayPush(string, length);
+	if(!end)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	memcpy(end, characters, length);
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Append a null-terminated string to a string being rendered.
+ *
+ * Parameters:
+ * - string: The array of characters of the string.
+ * - characters: The null-terminated string to append.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbRenderString(CymbArray* const string, const char* const characters)
+{
+	return cymbRenderCharacters(string, characters, strlen(characters));
+}
+
+/*
+ * Append a repeated character to a string being rendered.
+ *
+ * Parameters:
+ * - string: The array of characters of the string.
+ * - character: The character to append.
+ * - count: The number of times to append it.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbRenderRepeat(CymbArray* const string, const char character, const size_t count)
+{
+	char* const end = cymbArrayPush(string, count);
+	if(!end)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	memset(end, character, count);
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Append a size to a string being rendered.
+ *
+ * Parameters:
+ * - string: The array of characters of the string.
+ * - size: The size to append.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbRenderSize(CymbArray* const string, const size_t size)
+{
+	char characters[24];
+	const int length = snprintf(characters, sizeof(characters), "%zu", size);
+
+	return cymbRenderCharacters(string, characters, length);
+}
+
+/*
+ * Append part of a line to a string being rendered, expanding tabs up to the next tab stop.
+ *
+ * Parameters:
+ * - string: The array of characters of the string.
+ * - line: The part of the line.
+ * - column: The column at which the part starts, updated to the column after it.
+ * - tabWidth: The tab width.
+ * - copy: Flag indicating if the characters which are not tabs are copied rather than replaced by spaces.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbRenderLine(CymbArray* const string, const CymbStringView line, size_t* const column, const unsigned char tabWidth, const bool copy)
+{
+	const char* start = line.string;
+	const char* const end = line.string + line.length;
+	while(start < end)
+	{
+		// Runs of characters without tabs are appended at once.
+		const char* tab = memchr(start, '\t', end - start);
+		if(!tab)
+		{
+			tab = end;
+		}
+
+		const CymbResult result = copy ? cymbRenderCharacters(string, start, tab - start) : cymbRenderRepeat(string, ' ', tab - start);
+		if(result != CYMB_SUCCESS)
+		{
+			return result;
+		}
+		*column += tab - start;
+
+		if(tab == end)
+		{
+			break;
+		}
+
+		const size_t nextTab = cymbNextTab(*column, tabWidth);
+		const CymbResult tabResult = cymbRenderRepeat(string, ' ', nextTab - *column);
+		if(tabResult != CYMB_SUCCESS)
+		{
+			return tabResult;
+		}
+		*column = nextTab;
+
+		start = tab + 1;
+	}
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Render a diagnostic.
+ *
+ * Parameters:
+ * - string: The array of characters to which the diagnostic is appended.
+ * - diagnostic: A diagnostic.
+ * - file: The file for which the diagnostic was emitted.
+ * - tabWidth: The tab width to use for printing.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbDiagnosticRender(CymbArray* const string, const CymbDiagnostic* const diagnostic, const char* const file, const unsigned char tabWidth)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	if(diagnostic->info.line.string)
+	{
+		if(
+			(result = cymbRenderString(string, "In file ")) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, file)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, ", line ")) != CYMB_SUCCESS ||
+			(result = cymbRenderSize(string, diagnostic->info.position.line)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, ", column ")) != CYMB_SUCCESS ||
+			(result = cymbRenderSize(string, diagnostic->info.position.column)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, ":\n")) != CYMB_SUCCESS
+		)
+		{
+			goto end;
+		}
+	}
+
+	if(
+		(result = cymbRenderString(string, cymbDiagnosticMessage(diagnostic->type))) != CYMB_SUCCESS ||
+		(result = cymbRenderString(string, "\n")) != CYMB_SUCCESS
+	)
+	{
+		goto end;
+	}
 
 	if(diagnostic->info.line.string)
 	{
-		int written = fprintf(stderr, "%zu | ", diagnostic->info.position.line);
+		const size_t prefixStart = string->count;
+		if(
+			(result = cymbRenderSize(string, diagnostic->info.position.line)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, " | ")) != CYMB_SUCCESS
+		)
+		{
+			goto end;
+		}
+		const size_t prefixLength = string->count - prefixStart;
 
 		size_t column = 1;
-		for(size_t characterIndex = 0; characterIndex < diagnostic->info.line.length; ++characterIndex)
+		if(
+			(result = cymbRenderLine(string, diagnostic->info.line, &column, tabWidth, true)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, "\n")) != CYMB_SUCCESS ||
+			(result = cymbRenderRepeat(string, ' ', prefixLength)) != CYMB_SUCCESS
+		)
 		{
-			if(diagnostic->info.line.string[characterIndex] == '\t')
-			{
-				const size_t nextTab = cymbNextTab(column, tabWidth);
-				size_t offset = nextTab - column;
-				while(offset--)
-				{
-					fputc(' ', stderr);
-				}
-
-				column = nextTab;
-			}
-			else
-			{
-				fputc(diagnostic->info.line.string[characterIndex], stderr);
-				++column;
-			}
+			goto end;
 		}
-		fputc('\n', stderr);
 
-		while(written--)
+		// The hint is underlined, with the same tab expansion as the line.
+		column = 1;
+		const CymbStringView beforeHint = {diagnostic->info.line.string, diagnostic->info.hint.string - diagnostic->info.line.string};
+		if(
+			(result = cymbRenderLine(string, beforeHint, &column, tabWidth, false)) != CYMB_SUCCESS ||
+			(result = cymbRenderRepeat(string, '~', diagnostic->info.hint.length)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, "\n")) != CYMB_SUCCESS
+		)
+		{
+			goto end;
+		}
+	}
+	else if(diagnostic->info.hint.string)
+	{
+		if(
+			(result = cymbRenderString(string, diagnostic->info.hint.string)) != CYMB_SUCCESS ||
+			(result = cymbRenderString(string, "\n")) != CYMB_SUCCESS
+		)
 		{
-			fputc(' ', stderr);
+			goto end;
 		}
+	}
 
-		column = 1;
+	end:
+	return result;
+}
+
+CymbResult cymbDiagnosticListRender(const CymbDiagnosticList* const diagnostics, CymbString* const output)
+{
+	CymbResult result = CYMB_SUCCESS;
 
-		const ptrdiff_t offset = diagnostic->info.hint.string - diagnostic->info.line.string;
-		for(ptrdiff_t offsetIndex = 0; offsetIndex < offset; ++offsetIndex)
+	*output = (CymbString){};
+
+	CymbArray string;
+	cymbArrayCreate(&string, sizeof(char));
+
+	for(const CymbDiagnostic* diagnostic = diagnostics->start; diagnostic; diagnostic = diagnostic->next)
+	{
+		result = cymbDiagnosticRender(&string, diagnostic, diagnostics->file, diagnostics->tabWidth);
+		if(result != CYMB_SUCCESS)
 		{
-			if(diagnostic->info.line.string[offsetIndex] == '\t')
-			{
-				const size_t nextTab = cymbNextTab(column, tabWidth);
-				size_t offset = nextTab - column;
-				while(offset--)
-				{
-					fputc(' ', stderr);
-				}
-
-				column = nextTab;
-			}
-			else
-			{
-				fputc(' ', stderr);
-				++column;
-			}
+			goto error;
 		}
+	}
 
-		for(size_t hintIndex = 0; hintIndex < diagnostic->info.hint.length; ++hintIndex)
+	if(cymbDiagnosticListFull(diagnostics))
+	{
+		result = cymbRenderString(&string, "Error limit reached, stopping.\n");
+		if(result != CYMB_SUCCESS)
 		{
-			fputc('~', stderr);
+			goto error;
 		}
-		fputc('\n', stderr);
 	}
-	else if(diagnostic->info.hint.string)
+
+	// The null character is not counted.
+	result = cymbRenderRepeat(&string, '\0', 1);
+	if(result != CYMB_SUCCESS)
 	{
-		fputs(diagnostic->info.hint.string, stderr);
-		fputc('\n', stderr);
+		goto error;
 	}
+
+	*output = (CymbString){
+		.string = string.data,
+		.length = string.count - 1
+	};
+
+	goto end;
+
+	error:
+	cymbArrayFree(&string);
+
+	end:
+	return result;
 }
 
 void cymbDiagnosticListPrint(const CymbDiagnosticList* const diagnostics)
 {
-	const CymbDiagnostic* diagnostic = diagnostics->start;
-	while(diagnostic)
+	if(!diagnostics->start)
 	{
-		cymbDiagnosticPrint(diagnostic, diagnostics->file, diagnostics->tabWidth);
-		diagnostic = diagnostic->next;
+		return;
 	}
+
+	// Diagnostics are rendered first, so that unbuffered stderr gets a single write.
+	CymbString string;
+	if(cymbDiagnosticListRender(diagnostics, &string) != CYMB_SUCCESS)
+	{
+		fputs("Out of memory.\n", stderr);
+		return;
+	}
+
+	fwrite(string.string, 1, string.length, stderr);
+
+	cymbArrayDataFree(string.string);
 }
 
 void cymbDiagnosticListCreate(CymbDiagnosticList* const diagnostics, CymbArena* const arena, const char* const file, const unsigned char tabWidth)
@@ -292,14 +466,37 @@ void cymbDiagnosticListCreate(CymbDiagnosticList* const diagnostics, CymbArena*
 	};
 }
 
+bool cymbDiagnosticListFull(const CymbDiagnosticList* const diagnostics)
+{
+	return diagnostics->limit != 0 && diagnostics->count >= diagnostics->limit;
+}
+
+void cymbDiagnosticListSetSource(CymbDiagnosticList* const diagnostics, const char* const source)
+{
+	diagnostics->source = source;
+	diagnostics->lines = nullptr;
+	diagnostics->lineCount = 0;
+}
+
 void cymbDiagnosticListFree(CymbDiagnosticList* const diagnostics)
 {
+	// The line index lives in the arena, which is reset along with the list.
+	diagnostics->lines = nullptr;
+	diagnostics->lineCount = 0;
+
 	diagnostics->start = nullptr;
 	diagnostics->end = nullptr;
+	diagnostics->count = 0;
 }
 
 CymbResult cymbDiagnosticAdd(CymbDiagnosticList* const diagnostics, const CymbDiagnostic* const diagnostic)
 {
+	// Diagnostics past the limit are dropped, the caller is expected to stop soon after.
+	if(cymbDiagnosticListFull(diagnostics))
+	{
+		return CYMB_SUCCESS;
+	}
+
 	CymbDiagnostic* const result = cymbArenaAllocate(diagnostics->arena, sizeof(*diagnostic), alignof(typeof(*diagnostic)));
 	if(!result)
 	{
@@ -319,10 +516,125 @@ CymbResult cymbDiagnosticAdd(CymbDiagnosticList* const diagnostics, const CymbDi
 		diagnostics->end->next = result;
 		diagnostics->end = result;
 	}
+	++diagnostics->count;
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Index the line starts of the source of a diagnostic list.
+ *
+ * Parameters:
+ * - diagnostics: A list of diagnostics with a source.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if the index could not be allocated.
+ */
+static CymbResult cymbDiagnosticIndexLines(CymbDiagnosticList* const diagnostics)
+{
+	const char* const source = diagnostics->source;
+	const char* const end = source + strlen(source);
+
+	// memchr is vectorized by the C library, so both passes stay cheap on large sources.
+	size_t lineCount = 1;
+	for(const char* newline = memchr(source, '\n', end - source); newline; newline = memchr(newline + 1, '\n', end - newline - 1))
+	{
+		++lineCount;
+	}
+
+	size_t* const lines = cymbArenaAllocate(diagnostics->arena, lineCount * sizeof(lines[0]), alignof(typeof(lines[0])));
+	if(!lines)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	lines[0] = 0;
+	size_t lineIndex = 1;
+	for(const char* newline = memchr(source, '\n', end - source); newline; newline = memchr(newline + 1, '\n', end - newline - 1))
+	{
+		lines[lineIndex] = newline + 1 - source;
+		++lineIndex;
+	}
+
+	diagnostics->lines = lines;
+	diagnostics->lineCount = lineCount;
 
 	return CYMB_SUCCESS;
 }
 
+CymbDiagnosticInfo cymbDiagnosticLocate(CymbDiagnosticList* const diagnostics, const CymbStringView hint)
+{
+	if(!diagnostics->source)
+	{
+		return (CymbDiagnosticInfo){};
+	}
+
+	const size_t offset = hint.string - diagnostics->source;
+
+	CymbDiagnosticInfo info = {
+		.position = {
+			.line = 1,
+			.column = 1
+		},
+		.line = {.string = diagnostics->source},
+		.hint = hint
+	};
+
+	if(diagnostics->lineCount == 0)
+	{
+		cymbDiagnosticIndexLines(diagnostics);
+	}
+
+	if(diagnostics->lineCount > 0)
+	{
+		// Find the last line starting before the hint.
+		size_t low = 0;
+		size_t high = diagnostics->lineCount;
+		while(high - low > 1)
+		{
+			const size_t middle = low + (high - low) / 2;
+			if(diagnostics->lines[middle] <= offset)
+			{
+				low = middle;
+			}
+			else
+			{
+				high = middle;
+			}
+		}
+
+		info.position.line = low + 1;
+		info.line.string += diagnostics->lines[low];
+	}
+	else
+	{
+		// Without an index, fall back to a scan.
+		for(const char* string = diagnostics->source; string < hint.string; ++string)
+		{
+			if(*string == '\n')
+			{
+				++info.position.line;
+				info.line.string = string + 1;
+			}
+		}
+	}
+
+	for(const char* string = info.line.string; string < hint.string; ++string)
+	{
+		info.position.column = *string == '\t' ? cymbNextTab(info.position.column, diagnostics->tabWidth) : info.position.column + 1;
+	}
+
+	const char* end = info.line.string;
+	while(*end != '\0' && *end != '\n')
+	{
+		++end;
+	}
+	info.line.length = end - info.line.string;
+
+	return info;
+}
+
 size_t cymbNextTab(const size_t column, const unsigned char tabWidth)
 {
 	return column + tabWidth - (column - 1) % tabWidth;
@@ -2,88 +2,97 @@
 
 #include <ctype.h>
 #include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 
 #include "cymb/memory.h"
 
 /*
- * A mapping from string to token type.
+ * A keyword.
  *
  * Fields:
- * - string: A string.
- * - token: A token type.
+ * - string: The keyword string.
+ * - token: The keyword token type.
+ * - standard: The first standard in which the keyword is available.
  */
-typedef struct CymbMapping
+typedef struct CymbKeyword
 {
 	CymbConstString string;
 	CymbTokenType token;
-} CymbMapping;
-
-// Keywords must be stored from longest to shortest and in alphabetical order for bsearch.
-// They could also be stored from shortest to longest, longer keywords would not be missed (e.g. "do" and "double") because the length of the identifier is known.
-static const CymbMapping keywords[] = {
-	{CYMB_STRING("_Static_assert"), CYMB_TOKEN__STATIC_ASSERT},
-	{CYMB_STRING("_Thread_local"), CYMB_TOKEN__THREAD_LOCAL},
-	{CYMB_STRING("static_assert"), CYMB_TOKEN_STATIC_ASSERT},
-	{CYMB_STRING("typeof_unqual"), CYMB_TOKEN_TYPEOF_UNQUAL},
-	{CYMB_STRING("thread_local"), CYMB_TOKEN_THREAD_LOCAL},
-	{CYMB_STRING("_Decimal128"), CYMB_TOKEN__DECIMAL_128},
-	{CYMB_STRING("_Decimal32"), CYMB_TOKEN__DECIMAL_32},
-	{CYMB_STRING("_Decimal64"), CYMB_TOKEN__DECIMAL_64},
-	{CYMB_STRING("_Imaginary"), CYMB_TOKEN__IMAGINARY},
-	{CYMB_STRING("constexpr"), CYMB_TOKEN_CONSTEXPR},
-	{CYMB_STRING("_Alignas"), CYMB_TOKEN__ALIGNAS},
-	{CYMB_STRING("_Alignof"), CYMB_TOKEN__ALIGNOF},
-	{CYMB_STRING("_Complex"), CYMB_TOKEN__COMPLEX},
-	{CYMB_STRING("_Generic"), CYMB_TOKEN__GENERIC},
-	{CYMB_STRING("continue"), CYMB_TOKEN_CONTINUE},
-	{CYMB_STRING("register"), CYMB_TOKEN_REGISTER},
-	{CYMB_STRING("restrict"), CYMB_TOKEN_RESTRICT},
-	{CYMB_STRING("unsigned"), CYMB_TOKEN_UNSIGNED},
-	{CYMB_STRING("volatile"), CYMB_TOKEN_VOLATILE},
-	{CYMB_STRING("_Atomic"), CYMB_TOKEN__ATOMIC},
-	{CYMB_STRING("_BitInt"), CYMB_TOKEN__BIT_INT},
-	{CYMB_STRING("alignas"), CYMB_TOKEN_ALIGNAS},
-	{CYMB_STRING("alignof"), CYMB_TOKEN_ALIGNOF},
-	{CYMB_STRING("default"), CYMB_TOKEN_DEFAULT},
-	{CYMB_STRING("typedef"), CYMB_TOKEN_TYPEDEF},
-	{CYMB_STRING("double"), CYMB_TOKEN_DOUBLE},
-	{CYMB_STRING("extern"), CYMB_TOKEN_EXTERN},
-	{CYMB_STRING("return"), CYMB_TOKEN_RETURN},
-	{CYMB_STRING("signed"), CYMB_TOKEN_SIGNED},
-	{CYMB_STRING("sizeof"), CYMB_TOKEN_SIZEOF},
-	{CYMB_STRING("static"), CYMB_TOKEN_STATIC},
-	{CYMB_STRING("struct"), CYMB_TOKEN_STRUCT},
-	{CYMB_STRING("switch"), CYMB_TOKEN_SWITCH},
-	{CYMB_STRING("typeof"), CYMB_TOKEN_TYPEOF},
-	{CYMB_STRING("_Bool"), CYMB_TOKEN__BOOL},
-	{CYMB_STRING("break"), CYMB_TOKEN_BREAK},
-	{CYMB_STRING("const"), CYMB_TOKEN_CONST},
-	{CYMB_STRING("false"), CYMB_TOKEN_FALSE},
-	{CYMB_STRING("float"), CYMB_TOKEN_FLOAT},
-	{CYMB_STRING("short"), CYMB_TOKEN_SHORT},
-	{CYMB_STRING("union"), CYMB_TOKEN_UNION},
-	{CYMB_STRING("while"), CYMB_TOKEN_WHILE},
-	{CYMB_STRING("auto"), CYMB_TOKEN_AUTO},
-	{CYMB_STRING("bool"), CYMB_TOKEN_BOOL},
-	{CYMB_STRING("case"), CYMB_TOKEN_CASE},
-	{CYMB_STRING("char"), CYMB_TOKEN_CHAR},
-	{CYMB_STRING("else"), CYMB_TOKEN_ELSE},
-	{CYMB_STRING("enum"), CYMB_TOKEN_ENUM},
-	{CYMB_STRING("goto"), CYMB_TOKEN_GOTO},
-	{CYMB_STRING("long"), CYMB_TOKEN_LONG},
-	{CYMB_STRING("true"), CYMB_TOKEN_TRUE},
-	{CYMB_STRING("void"), CYMB_TOKEN_VOID},
-	{CYMB_STRING("for"), CYMB_TOKEN_FOR},
-	{CYMB_STRING("int"), CYMB_TOKEN_INT},
-	{CYMB_STRING("do"), CYMB_TOKEN_DO},
-	{CYMB_STRING("if"), CYMB_TOKEN_IF}
+	CymbStandard standard;
+} CymbKeyword;
+
+constexpr size_t keywordMinimumLength = 2;
+constexpr size_t keywordMaximumLength = 14;
+constexpr unsigned char keywordHashBits = 7;
+constexpr uint32_t keywordHashMultiplier = 0x47F5DC49;
+
+// Keywords are stored at the index hashed by cymbFindKeyword, empty slots have a zero length and never match.
+// The multiplier was searched for so that no two keywords collide, a new one must be searched for when adding a keyword.
+static const CymbKeyword keywords[1 << keywordHashBits] = {
+	[5] = {CYMB_STRING("_Generic"), CYMB_TOKEN__GENERIC, CYMB_C11},
+	[7] = {CYMB_STRING("_Static_assert"), CYMB_TOKEN__STATIC_ASSERT, CYMB_C11},
+	[11] = {CYMB_STRING("typeof_unqual"), CYMB_TOKEN_TYPEOF_UNQUAL, CYMB_C23},
+	[12] = {CYMB_STRING("while"), CYMB_TOKEN_WHILE, CYMB_C90},
+	[13] = {CYMB_STRING("_Complex"), CYMB_TOKEN__COMPLEX, CYMB_C99},
+	[15] = {CYMB_STRING("_Alignof"), CYMB_TOKEN__ALIGNOF, CYMB_C11},
+	[20] = {CYMB_STRING("else"), CYMB_TOKEN_ELSE, CYMB_C90},
+	[22] = {CYMB_STRING("auto"), CYMB_TOKEN_AUTO, CYMB_C90},
+	[23] = {CYMB_STRING("sizeof"), CYMB_TOKEN_SIZEOF, CYMB_C90},
+	[24] = {CYMB_STRING("switch"), CYMB_TOKEN_SWITCH, CYMB_C90},
+	[32] = {CYMB_STRING("char"), CYMB_TOKEN_CHAR, CYMB_C90},
+	[35] = {CYMB_STRING("for"), CYMB_TOKEN_FOR, CYMB_C90},
+	[40] = {CYMB_STRING("break"), CYMB_TOKEN_BREAK, CYMB_C90},
+	[42] = {CYMB_STRING("enum"), CYMB_TOKEN_ENUM, CYMB_C90},
+	[50] = {CYMB_STRING("void"), CYMB_TOKEN_VOID, CYMB_C90},
+	[51] = {CYMB_STRING("constexpr"), CYMB_TOKEN_CONSTEXPR, CYMB_C23},
+	[52] = {CYMB_STRING("typeof"), CYMB_TOKEN_TYPEOF, CYMB_C23},
+	[53] = {CYMB_STRING("register"), CYMB_TOKEN_REGISTER, CYMB_C90},
+	[54] = {CYMB_STRING("do"), CYMB_TOKEN_DO, CYMB_C90},
+	[55] = {CYMB_STRING("bool"), CYMB_TOKEN_BOOL, CYMB_C23},
+	[58] = {CYMB_STRING("int"), CYMB_TOKEN_INT, CYMB_C90},
+	[59] = {CYMB_STRING("continue"), CYMB_TOKEN_CONTINUE, CYMB_C90},
+	[61] = {CYMB_STRING("thread_local"), CYMB_TOKEN_THREAD_LOCAL, CYMB_C23},
+	[62] = {CYMB_STRING("_Thread_local"), CYMB_TOKEN__THREAD_LOCAL, CYMB_C11},
+	[65] = {CYMB_STRING("alignas"), CYMB_TOKEN_ALIGNAS, CYMB_C23},
+	[66] = {CYMB_STRING("_Decimal64"), CYMB_TOKEN__DECIMAL_64, CYMB_C23},
+	[67] = {CYMB_STRING("float"), CYMB_TOKEN_FLOAT, CYMB_C90},
+	[70] = {CYMB_STRING("if"), CYMB_TOKEN_IF, CYMB_C90},
+	[73] = {CYMB_STRING("goto"), CYMB_TOKEN_GOTO, CYMB_C90},
+	[79] = {CYMB_STRING("signed"), CYMB_TOKEN_SIGNED, CYMB_C90},
+	[80] = {CYMB_STRING("long"), CYMB_TOKEN_LONG, CYMB_C90},
+	[83] = {CYMB_STRING("default"), CYMB_TOKEN_DEFAULT, CYMB_C90},
+	[85] = {CYMB_STRING("union"), CYMB_TOKEN_UNION, CYMB_C90},
+	[86] = {CYMB_STRING("static_assert"), CYMB_TOKEN_STATIC_ASSERT, CYMB_C23},
+	[87] = {CYMB_STRING("struct"), CYMB_TOKEN_STRUCT, CYMB_C90},
+	[88] = {CYMB_STRING("typedef"), CYMB_TOKEN_TYPEDEF, CYMB_C90},
+	[91] = {CYMB_STRING("unsigned"), CYMB_TOKEN_UNSIGNED, CYMB_C90},
+	[92] = {CYMB_STRING("_Imaginary"), CYMB_TOKEN__IMAGINARY, CYMB_C99},
+	[93] = {CYMB_STRING("return"), CYMB_TOKEN_RETURN, CYMB_C90},
+	[94] = {CYMB_STRING("_BitInt"), CYMB_TOKEN__BIT_INT, CYMB_C23},
+	[95] = {CYMB_STRING("false"), CYMB_TOKEN_FALSE, CYMB_C23},
+	[96] = {CYMB_STRING("double"), CYMB_TOKEN_DOUBLE, CYMB_C90},
+	[99] = {CYMB_STRING("_Alignas"), CYMB_TOKEN__ALIGNAS, CYMB_C11},
+	[100] = {CYMB_STRING("extern"), CYMB_TOKEN_EXTERN, CYMB_C90},
+	[104] = {CYMB_STRING("volatile"), CYMB_TOKEN_VOLATILE, CYMB_C90},
+	[105] = {CYMB_STRING("const"), CYMB_TOKEN_CONST, CYMB_C90},
+	[106] = {CYMB_STRING("true"), CYMB_TOKEN_TRUE, CYMB_C23},
+	[109] = {CYMB_STRING("alignof"), CYMB_TOKEN_ALIGNOF, CYMB_C23},
+	[111] = {CYMB_STRING("short"), CYMB_TOKEN_SHORT, CYMB_C90},
+	[112] = {CYMB_STRING("case"), CYMB_TOKEN_CASE, CYMB_C90},
+	[115] = {CYMB_STRING("static"), CYMB_TOKEN_STATIC, CYMB_C90},
+	[117] = {CYMB_STRING("_Bool"), CYMB_TOKEN__BOOL, CYMB_C99},
+	[119] = {CYMB_STRING("_Decimal128"), CYMB_TOKEN__DECIMAL_128, CYMB_C23},
+	[122] = {CYMB_STRING("_Decimal32"), CYMB_TOKEN__DECIMAL_32, CYMB_C23},
+	[125] = {CYMB_STRING("restrict"), CYMB_TOKEN_RESTRICT, CYMB_C99},
+	[127] = {CYMB_STRING("_Atomic"), CYMB_TOKEN__ATOMIC, CYMB_C11}
 };
-constexpr size_t keywordCount = CYMB_LENGTH(keywords);
 
-// Punctuators must be stored from longest to shortest to avoid missing longer ones (e.g. "+" and "=" instead of "+=").
-static const CymbMapping punctuators[] = {
+// Punctuators are stored from longest to shortest, so that the first one which starts a string is the longest (e.g. "+=" rather than "+").
+// cymbParsePunctuator is written from this table and the tests check that it agrees with it.
+const CymbPunctuator cymbPunctuators[] = {
 	{CYMB_STRING("<<="), CYMB_TOKEN_LEFT_SHIFT_EQUAL},
 	{CYMB_STRING(">>="), CYMB_TOKEN_RIGHT_SHIFT_EQUAL},
 	{CYMB_STRING("+="), CYMB_TOKEN_PLUS_EQUAL},
@@ -130,61 +139,58 @@ static const CymbMapping punctuators[] = {
 	{CYMB_STRING("."), CYMB_TOKEN_DOT},
 	{CYMB_STRING(":"), CYMB_TOKEN_COLON}
 };
-constexpr size_t punctuatorCount = CYMB_LENGTH(punctuators);
-constexpr size_t punctuatorSize = sizeof(punctuators[0]);
-
-bool cymbIsKeyword(const CymbTokenType type)
-{
-	return type >= CYMB_TOKEN_VOID && type <= CYMB_TOKEN_GOTO;
-}
+const size_t cymbPunctuatorCount = CYMB_LENGTH(cymbPunctuators);
 
 /*
- * Check for punctuator equality.
- *
- * Parameters:
- * - stringVoid: A string.
- * - punctuatorVoid: A punctuator string.
- *
- * Returns:
- * - 0 if the strings are equal.
- * - A negative value if the first string comes before the second one.
- * - A positive value if the first string comes after the second one.
+ * A character class, which tells which lex function can match a token starting with a given character.
  */
-static int cymbComparePunctuator(const void* const stringVoid, const void* const punctuatorVoid)
+typedef enum CymbCharacterClass: unsigned char
 {
-	const char* const string = stringVoid;
-	const CymbConstString* const punctuator = punctuatorVoid;
-
-	return strncmp(punctuator->string, string, punctuator->length);
-}
+	CYMB_CLASS_NONE,
+	CYMB_CLASS_STRING,
+	CYMB_CLASS_CHARACTER,
+	CYMB_CLASS_PUNCTUATOR,
+	CYMB_CLASS_DIGIT,
+	CYMB_CLASS_IDENTIFIER
+} CymbCharacterClass;
+
+// Classes of the first character of a token, any character not listed cannot start a token.
+static const CymbCharacterClass characterClasses[UCHAR_MAX + 1] = {
+	['"'] = CYMB_CLASS_STRING,
+	['\''] = CYMB_CLASS_CHARACTER,
+	['!'] = CYMB_CLASS_PUNCTUATOR, ['%'] = CYMB_CLASS_PUNCTUATOR, ['&'] = CYMB_CLASS_PUNCTUATOR, ['('] = CYMB_CLASS_PUNCTUATOR,
+	[')'] = CYMB_CLASS_PUNCTUATOR, ['*'] = CYMB_CLASS_PUNCTUATOR, ['+'] = CYMB_CLASS_PUNCTUATOR, [','] = CYMB_CLASS_PUNCTUATOR,
+	['-'] = CYMB_CLASS_PUNCTUATOR, ['.'] = CYMB_CLASS_PUNCTUATOR, ['/'] = CYMB_CLASS_PUNCTUATOR, [':'] = CYMB_CLASS_PUNCTUATOR,
+	[';'] = CYMB_CLASS_PUNCTUATOR, ['<'] = CYMB_CLASS_PUNCTUATOR, ['='] = CYMB_CLASS_PUNCTUATOR, ['>'] = CYMB_CLASS_PUNCTUATOR,
+	['?'] = CYMB_CLASS_PUNCTUATOR, ['['] = CYMB_CLASS_PUNCTUATOR, [']'] = CYMB_CLASS_PUNCTUATOR, ['^'] = CYMB_CLASS_PUNCTUATOR,
+	['{'] = CYMB_CLASS_PUNCTUATOR, ['|'] = CYMB_CLASS_PUNCTUATOR, ['}'] = CYMB_CLASS_PUNCTUATOR, ['~'] = CYMB_CLASS_PUNCTUATOR,
+	['0'] = CYMB_CLASS_DIGIT, ['1'] = CYMB_CLASS_DIGIT, ['2'] = CYMB_CLASS_DIGIT, ['3'] = CYMB_CLASS_DIGIT, ['4'] = CYMB_CLASS_DIGIT,
+	['5'] = CYMB_CLASS_DIGIT, ['6'] = CYMB_CLASS_DIGIT, ['7'] = CYMB_CLASS_DIGIT, ['8'] = CYMB_CLASS_DIGIT, ['9'] = CYMB_CLASS_DIGIT,
+	['A'] = CYMB_CLASS_IDENTIFIER, ['B'] = CYMB_CLASS_IDENTIFIER, ['C'] = CYMB_CLASS_IDENTIFIER, ['D'] = CYMB_CLASS_IDENTIFIER,
+	['E'] = CYMB_CLASS_IDENTIFIER, ['F'] = CYMB_CLASS_IDENTIFIER, ['G'] = CYMB_CLASS_IDENTIFIER, ['H'] = CYMB_CLASS_IDENTIFIER,
+	['I'] = CYMB_CLASS_IDENTIFIER, ['J'] = CYMB_CLASS_IDENTIFIER, ['K'] = CYMB_CLASS_IDENTIFIER, ['L'] = CYMB_CLASS_IDENTIFIER,
+	['M'] = CYMB_CLASS_IDENTIFIER, ['N'] = CYMB_CLASS_IDENTIFIER, ['O'] = CYMB_CLASS_IDENTIFIER, ['P'] = CYMB_CLASS_IDENTIFIER,
+	['Q'] = CYMB_CLASS_IDENTIFIER, ['R'] = CYMB_CLASS_IDENTIFIER, ['S'] = CYMB_CLASS_IDENTIFIER, ['T'] = CYMB_CLASS_IDENTIFIER,
+	['U'] = CYMB_CLASS_IDENTIFIER, ['V'] = CYMB_CLASS_IDENTIFIER, ['W'] = CYMB_CLASS_IDENTIFIER, ['X'] = CYMB_CLASS_IDENTIFIER,
+	['Y'] = CYMB_CLASS_IDENTIFIER, ['Z'] = CYMB_CLASS_IDENTIFIER, ['_'] = CYMB_CLASS_IDENTIFIER,
+	['a'] = CYMB_CLASS_IDENTIFIER, ['b'] = CYMB_CLASS_IDENTIFIER, ['c'] = CYMB_CLASS_IDENTIFIER, ['d'] = CYMB_CLASS_IDENTIFIER,
+	['e'] = CYMB_CLASS_IDENTIFIER, ['f'] = CYMB_CLASS_IDENTIFIER, ['g'] = CYMB_CLASS_IDENTIFIER, ['h'] = CYMB_CLASS_IDENTIFIER,
+	['i'] = CYMB_CLASS_IDENTIFIER, ['j'] = CYMB_CLASS_IDENTIFIER, ['k'] = CYMB_CLASS_IDENTIFIER, ['l'] = CYMB_CLASS_IDENTIFIER,
+	['m'] = CYMB_CLASS_IDENTIFIER, ['n'] = CYMB_CLASS_IDENTIFIER, ['o'] = CYMB_CLASS_IDENTIFIER, ['p'] = CYMB_CLASS_IDENTIFIER,
+	['q'] = CYMB_CLASS_IDENTIFIER, ['r'] = CYMB_CLASS_IDENTIFIER, ['s'] = CYMB_CLASS_IDENTIFIER, ['t'] = CYMB_CLASS_IDENTIFIER,
+	['u'] = CYMB_CLASS_IDENTIFIER, ['v'] = CYMB_CLASS_IDENTIFIER, ['w'] = CYMB_CLASS_IDENTIFIER, ['x'] = CYMB_CLASS_IDENTIFIER,
+	['y'] = CYMB_CLASS_IDENTIFIER, ['z'] = CYMB_CLASS_IDENTIFIER
+};
 
-/*
- * Check for two strings equality.
- *
- * Parameters:
- * - stringVoid: A string to test.
- * - keywordVoid: A keyword mapping.
- *
- * Returns:
- * - 0 if the strings are equal.
- * - A negative value if the first string comes before the second one.
- * - A positive value if the first string comes after the second one.
- */
-static int cymbCompareString(const void* const stringVoid, const void* const keywordVoid)
+bool cymbIsKeyword(const CymbTokenType type)
 {
-	const CymbConstString* const string = stringVoid;
-	const CymbMapping* const keyword = keywordVoid;
-
-	if(string->length != keyword->string.length)
-	{
-		return (string->length < keyword->string.length) - (string->length > keyword->string.length);
-	}
-
-	return strncmp(string->string, keyword->string.string, string->length);
+	return type >= CYMB_TOKEN_VOID && type <= CYMB_TOKEN_GOTO;
 }
 
-CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, CymbDiagnosticList* const diagnostics)
+CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, CymbConstant* const constant, CymbDiagnosticList* const diagnostics)
 {
+	(void)constant;
+
 	CymbResult result = CYMB_SUCCESS;
 
 	if(*reader->string != '"')
@@ -195,6 +201,8 @@ CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, Cym
 
 	token->type = CYMB_TOKEN_STRING;
 
+	const char* const start = reader->string;
+
 	cymbReaderPop(reader);
 
 	while(*reader->string != '\0' && *reader->string != '\n' && (*reader->string != '"' || *(reader->string - 1) == '\\'))
@@ -205,11 +213,7 @@ CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, Cym
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_INVALID_STRING_CHARACTER,
-				.info = {
-					.position = reader->position,
-					.line = reader->line,
-					.hint = {reader->string, 1}
-				}
+				.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){reader->string, 1})
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -222,12 +226,12 @@ CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, Cym
 		cymbReaderPop(reader);
 	}
 
-	token->info.hint.length = reader->string - token->info.hint.string;
+	token->length = reader->string - start;
 
 	if(*reader->string == '"')
 	{
 		cymbReaderPop(reader);
-		++token->info.hint.length;
+		++token->length;
 	}
 	else
 	{
@@ -235,7 +239,7 @@ CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, Cym
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_UNFINISHED_STRING,
-			.info = token->info
+			.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){start, token->length})
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -248,7 +252,7 @@ CymbResult cymbParseString(CymbReader* const reader, CymbToken* const token, Cym
 	return result;
 }
 
-CymbResult cymbParseCharacter(CymbReader* const reader, CymbToken* const token, CymbDiagnosticList* const diagnostics)
+CymbResult cymbParseCharacter(CymbReader* const reader, CymbToken* const token, CymbConstant* const constant, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
 
@@ -259,8 +263,10 @@ CymbResult cymbParseCharacter(CymbReader* const reader, CymbToken* const token,
 	}
 
 	token->type = CYMB_TOKEN_CONSTANT;
-	token->constant.type = CYMB_CONSTANT_INT;
-	token->info.hint.length = 3;
+	token->length = 3;
+	constant->type = CYMB_CONSTANT_INT;
+
+	const char* const start = reader->string;
 
 	cymbReaderPop(reader);
 
@@ -274,11 +280,11 @@ CymbResult cymbParseCharacter(CymbReader* const reader, CymbToken* const token,
 	{
 		result = CYMB_INVALID;
 
-		token->info.hint.length = 1 + !endOfLine;
+		token->length = 1 + !endOfLine;
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_INVALID_CHARACTER_CONSTANT,
-			.info = token->info
+			.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){start, token->length})
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -290,16 +296,16 @@ CymbResult cymbParseCharacter(CymbReader* const reader, CymbToken* const token,
 
 	if(endOfLine)
 	{
-		token->constant.value = 0;
+		constant->value = 0;
 	}
 	else if(reader->string[0] == '\'')
 	{
-		token->constant.value = 0;
+		constant->value = 0;
 		cymbReaderPop(reader);
 	}
 	else
 	{
-		token->constant.value = reader->string[0];
+		constant->value = reader->string[0];
 		cymbReaderSkip(reader, 1 + (reader->string[1] == '\''));
 	}
 
@@ -307,20 +313,269 @@ CymbResult cymbParseCharacter(CymbReader* const reader, CymbToken* const token,
 	return result;
 }
 
-CymbResult cymbParsePunctuator(CymbReader* const reader, CymbToken* const token, CymbDiagnosticList* const diagnostics)
+CymbResult cymbParsePunctuator(CymbReader* const reader, CymbToken* const token, CymbConstant* const constant, CymbDiagnosticList* const diagnostics)
 {
+	(void)constant;
 	(void)diagnostics;
 
-	const CymbMapping* const mapping = cymbFind(reader->string, punctuators, punctuatorCount, punctuatorSize, cymbComparePunctuator);
-	if(!mapping)
+	// Switch on the first character, then look at most two characters ahead for the longest punctuator of cymbPunctuators.
+	size_t length = 1;
+	switch(reader->string[0])
 	{
-		return CYMB_NO_MATCH;
+		case '(':
+			token->type = CYMB_TOKEN_OPEN_PARENTHESIS;
+			break;
+
+		case ')':
+			token->type = CYMB_TOKEN_CLOSE_PARENTHESIS;
+			break;
+
+		case '{':
+			token->type = CYMB_TOKEN_OPEN_BRACE;
+			break;
+
+		case '}':
+			token->type = CYMB_TOKEN_CLOSE_BRACE;
+			break;
+
+		case '[':
+			token->type = CYMB_TOKEN_OPEN_BRACKET;
+			break;
+
+		case ']':
+			token->type = CYMB_TOKEN_CLOSE_BRACKET;
+			break;
+
+		case ';':
+			token->type = CYMB_TOKEN_SEMICOLON;
+			break;
+
+		case '~':
+			token->type = CYMB_TOKEN_TILDE;
+			break;
+
+		case '?':
+			token->type = CYMB_TOKEN_QUESTION;
+			break;
+
+		case ',':
+			token->type = CYMB_TOKEN_COMMA;
+			break;
+
+		case '.':
+			token->type = CYMB_TOKEN_DOT;
+			break;
+
+		case ':':
+			token->type = CYMB_TOKEN_COLON;
+			break;
+
+		case '+':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_PLUS_EQUAL;
+					length = 2;
+					break;
+
+				case '+':
+					token->type = CYMB_TOKEN_PLUS_PLUS;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_PLUS;
+					break;
+			}
+			break;
+
+		case '-':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_MINUS_EQUAL;
+					length = 2;
+					break;
+
+				case '-':
+					token->type = CYMB_TOKEN_MINUS_MINUS;
+					length = 2;
+					break;
+
+				case '>':
+					token->type = CYMB_TOKEN_ARROW;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_MINUS;
+					break;
+			}
+			break;
+
+		case '*':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_STAR_EQUAL;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_STAR;
+					break;
+			}
+			break;
+
+		case '/':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_SLASH_EQUAL;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_SLASH;
+					break;
+			}
+			break;
+
+		case '%':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_PERCENT_EQUAL;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_PERCENT;
+					break;
+			}
+			break;
+
+		case '&':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_AMPERSAND_EQUAL;
+					length = 2;
+					break;
+
+				case '&':
+					token->type = CYMB_TOKEN_AMPERSAND_AMPERSAND;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_AMPERSAND;
+					break;
+			}
+			break;
+
+		case '|':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_BAR_EQUAL;
+					length = 2;
+					break;
+
+				case '|':
+					token->type = CYMB_TOKEN_BAR_BAR;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_BAR;
+					break;
+			}
+			break;
+
+		case '^':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_CARET_EQUAL;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_CARET;
+					break;
+			}
+			break;
+
+		case '=':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_EQUAL_EQUAL;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_EQUAL;
+					break;
+			}
+			break;
+
+		case '!':
+			switch(reader->string[1])
+			{
+				case '=':
+					token->type = CYMB_TOKEN_NOT_EQUAL;
+					length = 2;
+					break;
+
+				default:
+					token->type = CYMB_TOKEN_EXCLAMATION;
+					break;
+			}
+			break;
+
+		case '<':
+			if(reader->string[1] == '<')
+			{
+				token->type = reader->string[2] == '=' ? CYMB_TOKEN_LEFT_SHIFT_EQUAL : CYMB_TOKEN_LEFT_SHIFT;
+				length = 2 + (reader->string[2] == '=');
+			}
+			else if(reader->string[1] == '=')
+			{
+				token->type = CYMB_TOKEN_LESS_EQUAL;
+				length = 2;
+			}
+			else
+			{
+				token->type = CYMB_TOKEN_LESS;
+			}
+			break;
+
+		case '>':
+			if(reader->string[1] == '>')
+			{
+				token->type = reader->string[2] == '=' ? CYMB_TOKEN_RIGHT_SHIFT_EQUAL : CYMB_TOKEN_RIGHT_SHIFT;
+				length = 2 + (reader->string[2] == '=');
+			}
+			else if(reader->string[1] == '=')
+			{
+				token->type = CYMB_TOKEN_GREATER_EQUAL;
+				length = 2;
+			}
+			else
+			{
+				token->type = CYMB_TOKEN_GREATER;
+			}
+			break;
+
+		default:
+			return CYMB_NO_MATCH;
 	}
 
-	token->type = mapping->token;
-	token->info.hint.length = mapping->string.length;
+	token->length = length;
 
-	cymbReaderSkip(reader, token->info.hint.length);
+	cymbReaderSkip(reader, length);
 
 	return CYMB_SUCCESS;
 }
@@ -401,6 +656,90 @@ static unsigned char cymbParseBase(CymbReader* const reader)
 	return base;
 }
 
+/*
+ * Parse 8 decimal digits at once.
+ *
+ * Parameters:
+ * - digits: 8 decimal digits.
+ *
+ * Returns:
+ * - The value of the digits.
+ */
+static uint32_t cymbParseEightDigits(const char* const digits)
+{
+	uint64_t word;
+	memcpy(&word, digits, sizeof(word));
+
+	// Combine adjacent digits, then pairs of pairs, then the two halves.
+	word -= 0x3030303030303030;
+	word = word * 10 + (word >> 8);
+	word = ((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32)) + ((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32))) >> 32;
+
+	return word;
+}
+
+/*
+ * Parse 8 hexadecimal digits at once.
+ *
+ * Parameters:
+ * - digits: 8 hexadecimal digits.
+ *
+ * Returns:
+ * - The value of the digits.
+ */
+static uint32_t cymbParseEightHexadecimalDigits(const char* const digits)
+{
+	uint64_t word;
+	memcpy(&word, digits, sizeof(word));
+
+	// Letters have bit 6 set and their low nibble is their value minus 9.
+	word = (word & 0x0F0F0F0F0F0F0F0F) + ((word & 0x4040404040404040) >> 6) * 9;
+
+	// The first digit is in the lowest byte, so each step puts the lower half in front.
+	word = ((word & 0x000F000F000F000F) << 4) | ((word & 0x0F000F000F000F00) >> 8);
+	word = ((word & 0x000000FF000000FF) << 8) | ((word & 0x00FF000000FF0000) >> 16);
+	word = ((word & 0x000000000000FFFF) << 16) | ((word & 0x0000FFFF00000000) >> 32);
+
+	return word;
+}
+
+/*
+ * Parse an unsigned integer without separators that cannot overflow, several digits at a time.
+ *
+ * Parameters:
+ * - digits: The digits.
+ * - length: The number of digits, at most 19 in base 10 and 16 in base 16.
+ * - base: The base, 10 or 16.
+ *
+ * Returns:
+ * - The parsed value.
+ */
+static uintmax_t cymbParseUnsignedFast(const char* digits, size_t length, const unsigned char base)
+{
+	uintmax_t value = 0;
+
+	while(length >= 8)
+	{
+		value = base == 10 ?
+			value * 100000000 + cymbParseEightDigits(digits) :
+			value << 32 | cymbParseEightHexadecimalDigits(digits);
+
+		digits += 8;
+		length -= 8;
+	}
+
+	while(length > 0)
+	{
+		const unsigned char digit = toupper((unsigned char)*digits) - (*digits <= '9' ? '0' : 'A' - 10);
+		value = value * base + digit;
+
+		++digits;
+		--length;
+	}
+
+	return value;
+}
+
 CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, unsigned char base, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
@@ -413,11 +752,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 		goto end;
 	}
 
-	CymbDiagnosticInfo info = {
-		.position = reader->position,
-		.line = reader->line,
-		.hint = {.string = reader->string}
-	};
+	CymbStringView number = {.string = reader->string};
 
 	// Parse base.
 	if(base == 0)
@@ -425,12 +760,23 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 		base = cymbParseBase(reader);
 	}
 
+	bool separators = false;
 	const char* end = reader->string;
 	while(cymbIsDigit(*end, base) || *end == '\'')
 	{
+		separators |= *end == '\'';
 		++end;
 	}
-	info.hint.length = end - info.hint.string;
+	number.length = end - number.string;
+
+	// Without separators and with few enough digits to not overflow, nothing can be diagnosed.
+	const size_t digitCount = end - reader->string;
+	if(!separators && ((base == 10 && digitCount <= 19) || (base == 16 && digitCount <= 16)))
+	{
+		*value = cymbParseUnsignedFast(reader->string, digitCount, base);
+		cymbReaderSkip(reader, digitCount);
+		goto end;
+	}
 
 	// Parse value.
 	bool previousSeparator = false;
@@ -440,11 +786,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_SEPARATOR_AFTER_BASE,
-			.info = {
-				.position = reader->position,
-				.line = reader->line,
-				.hint = {reader->string, 1}
-			}
+			.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){reader->string, 1})
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -466,8 +808,6 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 			{
 				result = CYMB_INVALID;
 
-				const size_t column = reader->position.column - 1;
-
 				const char* const start = reader->string - 1;
 				while(*reader->string == '\'')
 				{
@@ -476,11 +816,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_DUPLICATE_SEPARATORS,
-					.info = {
-						.position = {reader->position.line, column},
-						.line = reader->line,
-						.hint = {start, reader->string - start}
-					}
+					.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){start, reader->string - start})
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -500,7 +836,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 
 		previousSeparator = false;
 
-		const unsigned char digit = toupper((unsigned char)*reader->string) - (*reader->string <= '9' ? '0' : 'A');
+		const unsigned char digit = toupper((unsigned char)*reader->string) - (*reader->string <= '9' ? '0' : 'A' - 10);
 
 		if(!tooLarge && *value > (UINTMAX_MAX - digit) / base)
 		{
@@ -508,7 +844,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_CONSTANT_TOO_LARGE,
-				.info = info
+				.info = cymbDiagnosticLocate(diagnostics, number)
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -533,11 +869,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_TRAILING_SEPARATOR,
-			.info = {
-				.position = {reader->position.line, reader->position.column - 1},
-				.line = reader->line,
-				.hint = {reader->string - 1, 1}
-			}
+			.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){reader->string - 1, 1})
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -555,8 +887,9 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
  *
  * Parameters:
  * - reader: A reader.
- * - token: A token.
- * - base: The base of the ocnstant.
+ * - hint: The constant in the source, whose length is set to include the suffix.
+ * - constant: The constant.
+ * - base: The base of the constant.
  * - diagnostics: A list of diagnostics.
  *
  * Returns:
@@ -564,7 +897,7 @@ CymbResult cymbParseUnsigned(CymbReader* const reader, uintmax_t* const value, u
  * - CYMB_INVALID if the suffix is invalid or the constant too large.
  * - CYMB_OUT_OF_MEMORY if a diagnostic could not be added.
  */
-static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const token, const unsigned char base, CymbDiagnosticList* const diagnostics)
+static CymbResult cymbParseSuffix(CymbReader* const reader, CymbStringView* const hint, CymbConstant* const constant, const unsigned char base, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
 
@@ -573,7 +906,7 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 	{
 		++end;
 	}
-	token->info.hint.length = end - token->info.hint.string;
+	hint->length = end - hint->string;
 
 	const char suffix[] = {
 		tolower(reader->string[0]),
@@ -586,7 +919,7 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 		!isalnum((unsigned char)reader->string[3]) && reader->string[3] != '_'
 	)
 	{
-		token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
+		constant->type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
 	}
 	else if(
 		((suffix[0] == 'u' && suffix[1] == 'l') ||
@@ -594,36 +927,36 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 		!isalnum((unsigned char)reader->string[2]) && reader->string[2] != '_'
 	)
 	{
-		token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG;
-		if(token->constant.value > ULONG_MAX)
+		constant->type = CYMB_CONSTANT_UNSIGNED_LONG;
+		if(constant->value > ULONG_MAX)
 		{
-			token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
+			constant->type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
 		}
 	}
 	else if(suffix[0] == 'u' && !isalnum((unsigned char)reader->string[1]) && reader->string[1] != '_')
 	{
-		token->constant.type = CYMB_CONSTANT_UNSIGNED_INT;
-		if(token->constant.value > UINT_MAX)
+		constant->type = CYMB_CONSTANT_UNSIGNED_INT;
+		if(constant->value > UINT_MAX)
 		{
-			token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG;
+			constant->type = CYMB_CONSTANT_UNSIGNED_LONG;
 		}
-		if(token->constant.value > ULONG_MAX)
+		if(constant->value > ULONG_MAX)
 		{
-			token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
+			constant->type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
 		}
 	}
 	else if(suffix[0] == 'l' && reader->string[1] == reader->string[0] && !isalnum((unsigned char)reader->string[2]) && reader->string[2] != '_')
 	{
-		token->constant.type = CYMB_CONSTANT_LONG_LONG;
+		constant->type = CYMB_CONSTANT_LONG_LONG;
 		if(base == 10)
 		{
-			if(token->constant.value > LLONG_MAX)
+			if(constant->value > LLONG_MAX)
 			{
 				result = CYMB_INVALID;
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_CONSTANT_TOO_LARGE,
-					.info = token->info
+					.info = cymbDiagnosticLocate(diagnostics, *hint)
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -635,28 +968,28 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 		}
 		else
 		{
-			if(token->constant.value > LLONG_MAX)
+			if(constant->value > LLONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
+				constant->type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
 			}
 		}
 	}
 	else if(suffix[0] == 'l' && !isalnum((unsigned char)reader->string[1]) && reader->string[1] != '_')
 	{
-		token->constant.type = CYMB_CONSTANT_LONG;
+		constant->type = CYMB_CONSTANT_LONG;
 		if(base == 10)
 		{
-			if(token->constant.value > LONG_MAX)
+			if(constant->value > LONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_LONG_LONG;
+				constant->type = CYMB_CONSTANT_LONG_LONG;
 			}
-			if(token->constant.value > LLONG_MAX)
+			if(constant->value > LLONG_MAX)
 			{
 				result = CYMB_INVALID;
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_CONSTANT_TOO_LARGE,
-					.info = token->info
+					.info = cymbDiagnosticLocate(diagnostics, *hint)
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -668,40 +1001,40 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 		}
 		else
 		{
-			if(token->constant.value > LONG_MAX)
+			if(constant->value > LONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG;
+				constant->type = CYMB_CONSTANT_UNSIGNED_LONG;
 			}
-			if(token->constant.value > ULONG_MAX)
+			if(constant->value > ULONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_LONG_LONG;
+				constant->type = CYMB_CONSTANT_LONG_LONG;
 			}
-			if(token->constant.value > LLONG_MAX)
+			if(constant->value > LLONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
+				constant->type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
 			}
 		}
 	}
 	else
 	{
-		token->constant.type = CYMB_CONSTANT_INT;
+		constant->type = CYMB_CONSTANT_INT;
 		if(base == 10)
 		{
-			if(token->constant.value > INT_MAX)
+			if(constant->value > INT_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_LONG;
+				constant->type = CYMB_CONSTANT_LONG;
 			}
-			if(token->constant.value > LONG_MAX)
+			if(constant->value > LONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_LONG_LONG;
+				constant->type = CYMB_CONSTANT_LONG_LONG;
 			}
-			if(token->constant.value > LLONG_MAX)
+			if(constant->value > LLONG_MAX)
 			{
 				result = CYMB_INVALID;
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_CONSTANT_TOO_LARGE,
-					.info = token->info
+					.info = cymbDiagnosticLocate(diagnostics, *hint)
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -713,25 +1046,25 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 		}
 		else
 		{
-			if(token->constant.value > INT_MAX)
+			if(constant->value > INT_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_UNSIGNED_INT;
+				constant->type = CYMB_CONSTANT_UNSIGNED_INT;
 			}
-			if(token->constant.value > UINT_MAX)
+			if(constant->value > UINT_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_LONG;
+				constant->type = CYMB_CONSTANT_LONG;
 			}
-			if(token->constant.value > LONG_MAX)
+			if(constant->value > LONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG;
+				constant->type = CYMB_CONSTANT_UNSIGNED_LONG;
 			}
-			if(token->constant.value > ULONG_MAX)
+			if(constant->value > ULONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_LONG_LONG;
+				constant->type = CYMB_CONSTANT_LONG_LONG;
 			}
-			if(token->constant.value > LLONG_MAX)
+			if(constant->value > LLONG_MAX)
 			{
-				token->constant.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
+				constant->type = CYMB_CONSTANT_UNSIGNED_LONG_LONG;
 			}
 		}
 
@@ -741,11 +1074,7 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_INVALID_CONSTANT_SUFFIX,
-				.info = {
-					.position = reader->position,
-					.line = reader->line,
-					.hint = {reader->string, end - reader->string}
-				}
+				.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){reader->string, end - reader->string})
 			};
 			const CymbResult result = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(result != CYMB_SUCCESS)
@@ -760,23 +1089,26 @@ static CymbResult cymbParseSuffix(CymbReader* const reader, CymbToken* const tok
 	return result;
 }
 
-CymbResult cymbParseConstant(CymbReader* const reader, CymbToken* const token, CymbDiagnosticList* const diagnostics)
+CymbResult cymbParseConstant(CymbReader* const reader, CymbToken* const token, CymbConstant* const constant, CymbDiagnosticList* const diagnostics)
 {
 	token->type = CYMB_TOKEN_CONSTANT;
-	token->constant.type = CYMB_CONSTANT_INT;
+	constant->type = CYMB_CONSTANT_INT;
 
 	if(!isdigit((unsigned char)*reader->string))
 	{
 		return CYMB_NO_MATCH;
 	}
 
+	CymbStringView hint = {.string = reader->string};
+
 	const CymbDiagnostic* diagnostic = diagnostics->end;
 
 	const unsigned char base = cymbParseBase(reader);
 	uintmax_t value;
 	CymbResult result = cymbParseUnsigned(reader, &value, base, diagnostics);
-	token->info.hint.length = reader->string - token->info.hint.string;
-	token->constant.value = value;
+	hint.length = reader->string - hint.string;
+	token->length = hint.length;
+	constant->value = value;
 
 	if(result != CYMB_SUCCESS && result != CYMB_INVALID)
 	{
@@ -791,20 +1123,18 @@ CymbResult cymbParseConstant(CymbReader* const reader, CymbToken* const token, C
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_CONSTANT_TOO_LARGE,
-			.info = token->info
+			.info = cymbDiagnosticLocate(diagnostics, hint)
 		};
 		result = cymbDiagnosticAdd(diagnostics, &diagnostic);
 
 		return result;
 	}
-	token->constant.value = value;
+	constant->value = value;
 
 	if(!tooLarge)
 	{
-		if(!diagnostic)
-		{
-			diagnostic = diagnostics->start;
-		}
+		// Only look at the diagnostics added for this constant.
+		diagnostic = diagnostic ? diagnostic->next : diagnostics->start;
 
 		while(diagnostic)
 		{
@@ -820,11 +1150,12 @@ CymbResult cymbParseConstant(CymbReader* const reader, CymbToken* const token, C
 	
 	if(tooLarge)
 	{
-		token->constant = (CymbConstant){CYMB_CONSTANT_INT, 0};
+		*constant = (CymbConstant){CYMB_CONSTANT_INT, 0};
 	}
 
 	// Parse suffix.
-	const CymbResult suffixResult = cymbParseSuffix(reader, token, base, diagnostics);
+	const CymbResult suffixResult = cymbParseSuffix(reader, &hint, constant, base, diagnostics);
+	token->length = hint.length;
 	if(result == CYMB_SUCCESS)
 	{
 		result = suffixResult;
@@ -833,19 +1164,60 @@ CymbResult cymbParseConstant(CymbReader* const reader, CymbToken* const token, C
 	return result;
 }
 
-CymbResult cymbParseIdentifier(CymbReader* const reader, CymbToken* const token, CymbDiagnosticList* const diagnostics)
+/*
+ * Find the keyword an identifier spells.
+ *
+ * Parameters:
+ * - identifier: An identifier.
+ * - standard: The standard in use.
+ *
+ * Returns:
+ * - The keyword token type if the identifier is a keyword of the standard.
+ * - CYMB_TOKEN_IDENTIFIER otherwise.
+ */
+static CymbTokenType cymbFindKeyword(const CymbStringView identifier, const CymbStandard standard)
 {
-	(void)diagnostics;
+	if(identifier.length < keywordMinimumLength || identifier.length > keywordMaximumLength)
+	{
+		return CYMB_TOKEN_IDENTIFIER;
+	}
 
-	CymbResult result = CYMB_SUCCESS;
+	// Hash the length, the first two characters and the last character.
+	const uint32_t key =
+		(uint32_t)identifier.length << 24 |
+		(uint32_t)(unsigned char)identifier.string[0] << 16 |
+		(uint32_t)(unsigned char)identifier.string[1] << 8 |
+		(uint32_t)(unsigned char)identifier.string[identifier.length - 1];
+	const CymbKeyword* const keyword = &keywords[(uint32_t)(key * keywordHashMultiplier) >> (32 - keywordHashBits)];
+
+	if(keyword->string.length != identifier.length || keyword->standard > standard || memcmp(keyword->string.string, identifier.string, identifier.length) != 0)
+	{
+		return CYMB_TOKEN_IDENTIFIER;
+	}
+
+	return keyword->token;
+}
 
+/*
+ * Parse an identifier or a keyword of some standard.
+ *
+ * Parameters:
+ * - reader: A reader.
+ * - token: A token in which to store the result.
+ * - standard: The standard in use.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on match.
+ * - CYMB_NO_MATCH if there is no match.
+ */
+static CymbResult cymbParseStandardIdentifier(CymbReader* const reader, CymbToken* const token, const CymbStandard standard)
+{
 	if(!isalpha((unsigned char)*reader->string) && *reader->string != '_')
 	{
-		result = CYMB_NO_MATCH;
-		return result;
+		return CYMB_NO_MATCH;
 	}
 
-	token->type = CYMB_TOKEN_IDENTIFIER;
+	const char* const start = reader->string;
 
 	cymbReaderPop(reader);
 	while(isalnum((unsigned char)*reader->string) || *reader->string == '_')
@@ -853,141 +1225,858 @@ CymbResult cymbParseIdentifier(CymbReader* const reader, CymbToken* const token,
 		cymbReaderPop(reader);
 	}
 
-	token->info.hint.length = reader->string - token->info.hint.string;
-
-	const CymbMapping* const keyword = bsearch(&token->info.hint, keywords, keywordCount, sizeof(keywords[0]), cymbCompareString);
-	if(keyword)
-	{
-		token->type = keyword->token;
-	}
+	token->length = reader->string - start;
+	token->type = cymbFindKeyword((CymbStringView){start, token->length}, standard);
 
-	return result;
+	return CYMB_SUCCESS;
 }
 
-CymbResult cymbLex(const char* const string, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
+CymbResult cymbParseIdentifier(CymbReader* const reader, CymbToken* const token, CymbConstant* const constant, CymbDiagnosticList* const diagnostics)
 {
-	CymbResult result = CYMB_SUCCESS;
+	(void)constant;
+	(void)diagnostics;
+
+	return cymbParseStandardIdentifier(reader, token, CYMB_C23);
+}
 
-	tokens->count = 0;
+// Lex functions indexed by the class of the first character of a token, identifiers are handled separately.
+static const CymbLexFunction lexFunctions[] = {
+	[CYMB_CLASS_STRING] = cymbParseString,
+	[CYMB_CLASS_CHARACTER] = cymbParseCharacter,
+	[CYMB_CLASS_PUNCTUATOR] = cymbParsePunctuator,
+	[CYMB_CLASS_DIGIT] = cymbParseConstant
+};
 
-	size_t tokensCapacity = 1024;
-	tokens->tokens = malloc(tokensCapacity * sizeof(tokens->tokens[0]));
-	if(!tokens->tokens)
+CymbDiagnosticInfo cymbTokenInfo(CymbDiagnosticList* const diagnostics, const CymbToken* const token)
+{
+	if(!diagnostics->source)
 	{
-		result = CYMB_OUT_OF_MEMORY;
-		return result;
+		return (CymbDiagnosticInfo){};
 	}
 
-	CymbReader reader;
-	cymbReaderCreate(string, diagnostics->tabWidth, &reader);
+	return cymbDiagnosticLocate(diagnostics, (CymbStringView){diagnostics->source + token->offset, token->length});
+}
 
-	static const CymbLexFunction lexFunctions[] = {
-		cymbParseString,
-		cymbParseCharacter,
-		cymbParsePunctuator,
-		cymbParseConstant,
-		cymbParseIdentifier
+void cymbLexerCreate(CymbLexer* const lexer, const char* const string, const CymbStandard standard, CymbInterner* const interner, CymbDiagnosticList* const diagnostics)
+{
+	*lexer = (CymbLexer){
+		.string = string,
+		.standard = standard,
+		.interner = interner,
+		.diagnostics = diagnostics
 	};
-	static constexpr size_t lexFunctionCount = CYMB_LENGTH(lexFunctions);
 
-	while(cymbReaderSkipSpaces(&reader), *reader.string != '\0')
-	{
-		if(tokens->count == tokensCapacity)
-		{
-			if(tokensCapacity * sizeof(tokens->tokens) == cymbSizeMax)
-			{
-				result = CYMB_OUT_OF_MEMORY;
-				goto clear;
-			}
+	// Positions are only computed when a diagnostic is emitted.
+	cymbReaderCreateLazy(string, &lexer->reader);
 
-			tokensCapacity = tokensCapacity > cymbSizeMax / 2 / sizeof(tokens->tokens[0]) ? cymbSizeMax / sizeof(tokens->tokens[0]) : tokensCapacity * 2;
-			CymbToken* const newTokens = realloc(tokens->tokens, tokensCapacity * sizeof(tokens->tokens[0]));
-			if(!newTokens)
-			{
-				result = CYMB_OUT_OF_MEMORY;
-				goto clear;
-			}
-			tokens->tokens = newTokens;
-		}
+	cymbDiagnosticListSetSource(diagnostics, string);
+}
 
-		CymbToken* const token = &tokens->tokens[tokens->count];
-		*token = (CymbToken){
-			.info = {
-				.position = reader.position,
-				.line = reader.line,
-				.hint = {.string = reader.string}
-			}
-		};
+/*
+ * Skip spaces and comments.
+ *
+ * Parameters:
+ * - reader: A reader.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_INVALID if a comment is unfinished.
+ * - CYMB_OUT_OF_MEMORY if a diagnostic could not be added.
+ */
+static CymbResult cymbSkipSpacesAndComments(CymbReader* const reader, CymbDiagnosticList* const diagnostics)
+{
+	while(true)
+	{
+		cymbReaderSkipSpaces(reader);
 
-		for(size_t lexFunctionIndex = 0; lexFunctionIndex < lexFunctionCount; ++lexFunctionIndex)
+		if(reader->string[0] != '/')
 		{
-			const CymbResult lexResult = lexFunctions[lexFunctionIndex](&reader, token, diagnostics);
-
-			if(lexResult == CYMB_INVALID)
-			{
-				result = CYMB_INVALID;
-			}
-
-			if(lexResult == CYMB_SUCCESS || lexResult == CYMB_INVALID)
-			{
-				goto append;
-			}
-			if(lexResult != CYMB_NO_MATCH)
-			{
-				goto clear;
-			}
+			return CYMB_SUCCESS;
 		}
 
-		result = CYMB_INVALID;
+		if(reader->string[1] == '/')
+		{
+			cymbReaderSkipLine(reader);
+			continue;
+		}
 
-		const CymbDiagnostic diagnostic = {
-			.type = CYMB_UNKNOWN_TOKEN,
-			.info = {
-				.position = reader.position,
-				.line = reader.line,
-				.hint = {reader.string, 1}
-			}
-		};
-		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
-		if(diagnosticResult != CYMB_SUCCESS)
+		if(reader->string[1] != '*')
 		{
-			result = diagnosticResult;
-			goto clear;
+			return CYMB_SUCCESS;
 		}
 
-		cymbReaderPop(&reader);
-		continue;
+		const char* const end = cymbFindCommentEnd(reader->string + 2);
+		if(*end == '\0')
+		{
+			const CymbDiagnostic diagnostic = {
+				.type = CYMB_UNFINISHED_COMMENT,
+				.info = cymbDiagnosticLocate(diagnostics, (CymbStringView){reader->string, 2})
+			};
+			cymbReaderSkip(reader, end - reader->string);
 
-		append:
-		++tokens->count;
-	}
+			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+			return diagnosticResult == CYMB_SUCCESS ? CYMB_INVALID : diagnosticResult;
+		}
 
-	if(tokens->count == 0)
-	{
-		goto clear;
+		cymbReaderSkip(reader, end + 2 - reader->string);
 	}
+}
 
-	if(tokens->count < tokensCapacity)
-	{
-		CymbToken* const newTokens = realloc(tokens->tokens, tokens->count * sizeof(tokens->tokens[0]));
-		if(!newTokens)
+CymbResult cymbLexNext(CymbLexer* const lexer, CymbToken* const token, CymbConstant* const constant)
+{
+	CymbReader* const reader = &lexer->reader;
+
+	bool invalid = false;
+
+	while(true)
+	{
+		const CymbResult skipResult = cymbSkipSpacesAndComments(reader, lexer->diagnostics);
+		if(skipResult == CYMB_INVALID)
+		{
+			invalid = true;
+			lexer->invalid = true;
+		}
+		else if(skipResult != CYMB_SUCCESS)
+		{
+			return skipResult;
+		}
+
+		if(*reader->string == '\0')
+		{
+			break;
+		}
+
+		// Offsets and lengths are stored on 32 bits.
+		if((size_t)(reader->string - lexer->string) > UINT32_MAX)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		*token = (CymbToken){
+			.offset = reader->string - lexer->string
+		};
+		*constant = (CymbConstant){};
+
+		const CymbCharacterClass characterClass = characterClasses[(unsigned char)*reader->string];
+		if(characterClass != CYMB_CLASS_NONE)
+		{
+			// Identifiers are parsed separately because keywords depend on the standard.
+			const CymbResult result = characterClass == CYMB_CLASS_IDENTIFIER ?
+				cymbParseStandardIdentifier(reader, token, lexer->standard) :
+				lexFunctions[characterClass](reader, token, constant, lexer->diagnostics);
+
+			if(result == CYMB_SUCCESS)
+			{
+				if(lexer->interner && token->type == CYMB_TOKEN_IDENTIFIER)
+				{
+					const CymbResult internResult = cymbIntern(lexer->interner, (CymbStringView){lexer->string + token->offset, token->length}, &token->symbol);
+					if(internResult != CYMB_SUCCESS)
+					{
+						return internResult;
+					}
+				}
+
+				return invalid ? CYMB_INVALID : CYMB_SUCCESS;
+			}
+			if(result == CYMB_INVALID)
+			{
+				lexer->invalid = true;
+				return CYMB_INVALID;
+			}
+			if(result != CYMB_NO_MATCH)
+			{
+				return result;
+			}
+		}
+
+		invalid = true;
+		lexer->invalid = true;
+
+		const CymbDiagnostic diagnostic = {
+			.type = CYMB_UNKNOWN_TOKEN,
+			.info = cymbDiagnosticLocate(lexer->diagnostics, (CymbStringView){reader->string, 1})
+		};
+		const CymbResult diagnosticResult = cymbDiagnosticAdd(lexer->diagnostics, &diagnostic);
+		if(diagnosticResult != CYMB_SUCCESS)
+		{
+			return diagnosticResult;
+		}
+
+		cymbReaderPop(reader);
+	}
+
+	return CYMB_NO_MATCH;
+}
+
+/*
+ * A list of tokens being built.
+ *
+ * Fields:
+ * - tokens: The array of tokens.
+ * - constants: The array of constants.
+ * - lastInvalid: The start of the last lexing step which found something invalid, nullptr if there is none.
+ */
+typedef struct CymbTokenBuffer
+{
+	CymbArray tokens;
+	CymbArray constants;
+
+	const char* lastInvalid;
+} CymbTokenBuffer;
+
+/*
+ * Create a token buffer.
+ *
+ * Parameters:
+ * - buffer: The buffer to create.
+ * - length: The length of the string to lex, used to estimate the number of tokens.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails.
+ */
+static CymbResult cymbTokenBufferCreate(CymbTokenBuffer* const buffer, const size_t length)
+{
+	*buffer = (CymbTokenBuffer){};
+	cymbArrayCreate(&buffer->tokens, sizeof(CymbToken));
+	cymbArrayCreate(&buffer->constants, sizeof(CymbConstant));
+
+	// Most tokens are followed by at least one space or are several characters long, so this rarely needs to grow.
+	return cymbArrayReserve(&buffer->tokens, length / 4 + 16);
+}
+
+/*
+ * Free a token buffer.
+ *
+ * Parameters:
+ * - buffer: The buffer.
+ */
+static void cymbTokenBufferFree(CymbTokenBuffer* const buffer)
+{
+	cymbArrayFree(&buffer->tokens);
+	cymbArrayFree(&buffer->constants);
+}
+
+/*
+ * Append a token to a token buffer.
+ *
+ * Parameters:
+ * - buffer: A token buffer.
+ * - token: The token to append.
+ * - constant: The value of the token if it is a constant.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails.
+ */
+static CymbResult cymbTokenBufferAppend(CymbTokenBuffer* const buffer, const CymbToken* const token, const CymbConstant* const constant)
+{
+	CymbToken* const newToken = cymbArrayPush(&buffer->tokens, 1);
+	if(!newToken)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+	*newToken = *token;
+
+	if(token->type == CYMB_TOKEN_CONSTANT)
+	{
+		if(buffer->constants.count > UINT32_MAX)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		newToken->constant = buffer->constants.count;
+
+		CymbConstant* const newConstant = cymbArrayPush(&buffer->constants, 1);
+		if(!newConstant)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+		*newConstant = *constant;
+	}
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Lex tokens into a buffer until the lexer reaches a bound or its diagnostics reach their limit.
+ * The last token may extend past the bound.
+ *
+ * Parameters:
+ * - lexer: A lexer.
+ * - bound: The position at which to stop.
+ * - buffer: The buffer in which to append the tokens.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails or the string is too long.
+ */
+static CymbResult cymbLexUntil(CymbLexer* const lexer, const char* const bound, CymbTokenBuffer* const buffer)
+{
+	while(lexer->reader.string < bound && !cymbDiagnosticListFull(lexer->diagnostics))
+	{
+		const char* const start = lexer->reader.string;
+
+		// The flag of the lexer is sticky, so it is reset to know whether this step is invalid.
+		const bool invalid = lexer->invalid;
+		lexer->invalid = false;
+
+		CymbToken token;
+		CymbConstant constant;
+		const CymbResult result = cymbLexNext(lexer, &token, &constant);
+
+		if(lexer->invalid)
+		{
+			buffer->lastInvalid = start;
+		}
+		lexer->invalid = lexer->invalid || invalid;
+
+		if(result == CYMB_NO_MATCH)
+		{
+			break;
+		}
+		if(result != CYMB_SUCCESS && result != CYMB_INVALID)
+		{
+			return result;
+		}
+
+		const CymbResult appendResult = cymbTokenBufferAppend(buffer, &token, &constant);
+		if(appendResult != CYMB_SUCCESS)
+		{
+			return appendResult;
+		}
+	}
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Finish a list of tokens.
+ *
+ * Parameters:
+ * - result: The result of the lexing.
+ * - buffer: The buffer holding the tokens.
+ * - tokens: The list of tokens to set.
+ *
+ * Returns:
+ * - The result of the lexing.
+ */
+static CymbResult cymbTokenBufferFinish(const CymbResult result, CymbTokenBuffer* const buffer, CymbTokenList* const tokens)
+{
+	// The unused capacity is kept rather than copying the tokens into a smaller buffer.
+	if((result != CYMB_SUCCESS && result != CYMB_INVALID) || buffer->tokens.count == 0)
+	{
+		cymbTokenBufferFree(buffer);
+		*tokens = (CymbTokenList){
+			.invalid = result == CYMB_INVALID
+		};
+
+		return result;
+	}
+
+	*tokens = (CymbTokenList){
+		.tokens = buffer->tokens.data,
+		.count = buffer->tokens.count,
+		.capacity = buffer->tokens.capacity,
+		.constants = buffer->constants.data,
+		.constantCount = buffer->constants.count,
+		.constantCapacity = buffer->constants.capacity,
+		.invalid = result == CYMB_INVALID
+	};
+
+	cymbMatchBrackets(tokens->tokens, tokens->count);
+
+	return result;
+}
+
+CymbResult cymbLex(const char* const string, const CymbStandard standard, CymbInterner* const interner, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
+{
+	*tokens = (CymbTokenList){};
+
+	CymbLexer lexer;
+	cymbLexerCreate(&lexer, string, standard, interner, diagnostics);
+
+	const size_t length = strlen(string);
+
+	CymbTokenBuffer buffer;
+	CymbResult result = cymbTokenBufferCreate(&buffer, length);
+	if(result == CYMB_SUCCESS)
+	{
+		result = cymbLexUntil(&lexer, string + length, &buffer);
+	}
+
+	if(result == CYMB_SUCCESS && lexer.invalid)
+	{
+		result = CYMB_INVALID;
+	}
+
+	return cymbTokenBufferFinish(result, &buffer, tokens);
+}
+
+/*
+ * Minimum size of a chunk lexed by a thread.
+ */
+constexpr size_t cymbLexChunkSize = 0x10000;
+
+/*
+ * A chunk of a string lexed by another thread.
+ *
+ * Fields:
+ * - start: The start of the chunk.
+ * - bound: The end of the chunk.
+ * - lexer: The lexer, which starts at the start of the chunk.
+ * - arena: The arena used for the diagnostics.
+ * - diagnostics: The diagnostics of the chunk.
+ * - tokens: The tokens of the chunk.
+ * - result: The result of the lexing.
+ * - thread: The thread lexing the chunk.
+ * - threaded: Flag indicating if the thread was started.
+ */
+typedef struct CymbLexChunk
+{
+	const char* start;
+	const char* bound;
+
+	CymbLexer lexer;
+
+	CymbArena arena;
+	CymbDiagnosticList diagnostics;
+
+	CymbTokenBuffer tokens;
+
+	CymbResult result;
+
+	thrd_t thread;
+	bool threaded;
+} CymbLexChunk;
+
+/*
+ * Lex a chunk.
+ *
+ * Parameters:
+ * - chunkVoid: The chunk.
+ *
+ * Returns:
+ * - 0.
+ */
+static int cymbLexChunk(void* const chunkVoid)
+{
+	CymbLexChunk* const chunk = chunkVoid;
+
+	chunk->result = cymbLexUntil(&chunk->lexer, chunk->bound, &chunk->tokens);
+
+	return 0;
+}
+
+/*
+ * Merge the tokens and diagnostics of a chunk.
+ *
+ * The chunk was lexed assuming it starts between two tokens, which is wrong if a comment crosses its start.
+ * Its tokens are kept from the first step starting where the lexer stopped, because lexing only depends on the position.
+ * If there is no such step, the chunk is lexed again.
+ *
+ * Parameters:
+ * - lexer: The lexer, which stopped at the end of the previous chunk.
+ * - buffer: The buffer in which to append the tokens.
+ * - chunk: The chunk to merge.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if memory allocation fails.
+ */
+static CymbResult cymbMergeChunk(CymbLexer* const lexer, CymbTokenBuffer* const buffer, const CymbLexChunk* const chunk)
+{
+	const char* const position = lexer->reader.string;
+
+	// Each step after the first starts at the end of the previous token.
+	const CymbTokenList list = {
+		.tokens = chunk->tokens.tokens.data,
+		.count = chunk->tokens.tokens.count,
+		.constants = chunk->tokens.constants.data
+	};
+	const size_t offset = position - lexer->string;
+
+	size_t first = 0;
+	size_t last = list.count;
+	bool found = position == chunk->start;
+	while(!found && first < last)
+	{
+		const size_t middle = first + (last - first) / 2;
+		const size_t end = (size_t)list.tokens[middle].offset + list.tokens[middle].length;
+
+		if(end == offset)
+		{
+			first = middle + 1;
+			found = true;
+		}
+		else if(end < offset)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	if(!found)
+	{
+		return cymbLexUntil(lexer, chunk->bound, buffer);
+	}
+
+	for(size_t tokenIndex = first; tokenIndex < list.count; ++tokenIndex)
+	{
+		const CymbToken* const token = &list.tokens[tokenIndex];
+
+		const CymbResult result = cymbTokenBufferAppend(buffer, token, token->type == CYMB_TOKEN_CONSTANT ? &list.constants[token->constant] : nullptr);
+		if(result != CYMB_SUCCESS)
+		{
+			return result;
+		}
+	}
+
+	// The diagnostics of a step point after its start.
+	for(const CymbDiagnostic* diagnostic = chunk->diagnostics.start; diagnostic; diagnostic = diagnostic->next)
+	{
+		if(diagnostic->info.hint.string < position)
+		{
+			continue;
+		}
+
+		const CymbResult result = cymbDiagnosticAdd(lexer->diagnostics, diagnostic);
+		if(result != CYMB_SUCCESS)
+		{
+			return result;
+		}
+	}
+
+	if(chunk->tokens.lastInvalid && chunk->tokens.lastInvalid >= position)
+	{
+		lexer->invalid = true;
+		buffer->lastInvalid = chunk->tokens.lastInvalid;
+	}
+
+	lexer->reader.string = chunk->lexer.reader.string;
+
+	return CYMB_SUCCESS;
+}
+
+CymbResult cymbLexParallel(const char* const string, const CymbStandard standard, const unsigned int threadCount, CymbInterner* const interner, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
+{
+	const size_t length = strlen(string);
+
+	// Small strings are not worth starting threads.
+	const size_t chunkCount = CYMB_MIN(threadCount, length / cymbLexChunkSize);
+	if(chunkCount <= 1)
+	{
+		return cymbLex(string, standard, interner, tokens, diagnostics);
+	}
+
+	*tokens = (CymbTokenList){};
+
+	CymbResult result = CYMB_SUCCESS;
+
+	// The first chunk is lexed by the calling thread.
+	CymbLexChunk* const chunks = calloc(chunkCount - 1, sizeof(chunks[0]));
+	if(!chunks)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	// Chunks start after a newline, so they usually start between two tokens.
+	const char* const end = string + length;
+	const char* start = string;
+	for(size_t chunkIndex = 0; chunkIndex < chunkCount - 1; ++chunkIndex)
+	{
+		const char* const target = CYMB_MAX(start, string + length / chunkCount * (chunkIndex + 1));
+		const char* const newline = memchr(target, '\n', end - target);
+		start = newline ? newline + 1 : end;
+
+		chunks[chunkIndex].start = start;
+		if(chunkIndex > 0)
+		{
+			chunks[chunkIndex - 1].bound = start;
+		}
+	}
+	chunks[chunkCount - 2].bound = end;
+
+	for(size_t chunkIndex = 0; chunkIndex < chunkCount - 1; ++chunkIndex)
+	{
+		CymbLexChunk* const chunk = &chunks[chunkIndex];
+
+		// Chunk arenas take their regions from the pool of the caller, if any.
+		cymbArenaCreatePooled(&chunk->arena, diagnostics->arena->pool);
+		cymbDiagnosticListCreate(&chunk->diagnostics, &chunk->arena, diagnostics->file, diagnostics->tabWidth);
+		chunk->diagnostics.limit = diagnostics->limit;
+
+		// Identifiers are interned once the chunks are merged.
+		cymbLexerCreate(&chunk->lexer, string, standard, nullptr, &chunk->diagnostics);
+		chunk->lexer.reader.string = chunk->start;
+
+		chunk->result = cymbTokenBufferCreate(&chunk->tokens, chunk->bound - chunk->start);
+		if(chunk->result != CYMB_SUCCESS)
+		{
+			continue;
+		}
+
+		chunk->threaded = thrd_create(&chunk->thread, cymbLexChunk, chunk) == thrd_success;
+		if(!chunk->threaded)
+		{
+			cymbLexChunk(chunk);
+		}
+	}
+
+	CymbLexer lexer;
+	cymbLexerCreate(&lexer, string, standard, nullptr, diagnostics);
+
+	CymbTokenBuffer buffer;
+	result = cymbTokenBufferCreate(&buffer, length);
+	if(result == CYMB_SUCCESS)
+	{
+		result = cymbLexUntil(&lexer, chunks[0].start, &buffer);
+	}
+
+	// Every thread is joined, even after a failure.
+	for(size_t chunkIndex = 0; chunkIndex < chunkCount - 1; ++chunkIndex)
+	{
+		CymbLexChunk* const chunk = &chunks[chunkIndex];
+
+		if(chunk->threaded)
+		{
+			thrd_join(chunk->thread, nullptr);
+		}
+
+		if(result == CYMB_SUCCESS)
+		{
+			result = chunk->result;
+		}
+		// Once the error limit is reached, the remaining chunks are dropped.
+		if(result == CYMB_SUCCESS && !cymbDiagnosticListFull(diagnostics))
+		{
+			result = cymbMergeChunk(&lexer, &buffer, chunk);
+		}
+
+		cymbTokenBufferFree(&chunk->tokens);
+		cymbArenaFree(&chunk->arena);
+	}
+
+	free(chunks);
+
+	// Identifiers are interned in order, so that symbols are the same as with cymbLex.
+	CymbToken* const bufferTokens = buffer.tokens.data;
+	for(size_t tokenIndex = 0; interner && result == CYMB_SUCCESS && tokenIndex < buffer.tokens.count; ++tokenIndex)
+	{
+		CymbToken* const token = &bufferTokens[tokenIndex];
+		if(token->type == CYMB_TOKEN_IDENTIFIER)
+		{
+			result = cymbIntern(interner, (CymbStringView){string + token->offset, token->length}, &token->symbol);
+		}
+	}
+
+	if(result == CYMB_SUCCESS && lexer.invalid)
+	{
+		result = CYMB_INVALID;
+	}
+
+	return cymbTokenBufferFinish(result, &buffer, tokens);
+}
+
+CymbResult cymbLexRange(const char* const string, const CymbStandard standard, const size_t start, const size_t bound, CymbInterner* const interner, CymbTokenList* const tokens, size_t* const end, CymbDiagnosticList* const diagnostics)
+{
+	*tokens = (CymbTokenList){};
+
+	CymbLexer lexer;
+	cymbLexerCreate(&lexer, string, standard, interner, diagnostics);
+	lexer.reader.string = string + start;
+
+	CymbTokenBuffer buffer;
+	CymbResult result = cymbTokenBufferCreate(&buffer, bound - start);
+	if(result == CYMB_SUCCESS)
+	{
+		result = cymbLexUntil(&lexer, string + bound, &buffer);
+	}
+
+	if(result == CYMB_SUCCESS && lexer.invalid)
+	{
+		result = CYMB_INVALID;
+	}
+
+	*end = lexer.reader.string - string;
+
+	return cymbTokenBufferFinish(result, &buffer, tokens);
+}
+
+CymbResult cymbReplaceTokens(CymbTokenList* const tokens, const size_t start, const size_t end, const CymbTokenList* const replacement, const ptrdiff_t shift)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	const size_t count = tokens->count - (end - start) + replacement->count;
+
+	// The constants of the replaced tokens are reused first, so that repeated edits do not grow the constants.
+	CymbArray slots;
+	cymbArrayCreate(&slots, sizeof(uint32_t));
+
+	size_t constantCount = 0;
+	for(size_t tokenIndex = 0; tokenIndex < replacement->count; ++tokenIndex)
+	{
+		constantCount += replacement->tokens[tokenIndex].type == CYMB_TOKEN_CONSTANT;
+	}
+
+	for(size_t tokenIndex = start; tokenIndex < end && slots.count < constantCount; ++tokenIndex)
+	{
+		if(tokens->tokens[tokenIndex].type != CYMB_TOKEN_CONSTANT)
+		{
+			continue;
+		}
+
+		uint32_t* const slot = cymbArrayPush(&slots, 1);
+		if(!slot)
 		{
 			result = CYMB_OUT_OF_MEMORY;
-			goto clear;
+			goto end;
 		}
-		tokens->tokens = newTokens;
+		*slot = tokens->tokens[tokenIndex].constant;
 	}
-	goto end;
 
-	clear:
-	cymbFreeTokenList(tokens);
+	CymbArray constants = {
+		.data = tokens->constants,
+		.count = tokens->constantCount,
+		.capacity = tokens->constantCapacity,
+		.elementSize = sizeof(CymbConstant)
+	};
+	const size_t firstConstant = constants.count;
+	if(constantCount > slots.count && (constants.count + constantCount - slots.count > UINT32_MAX || !cymbArrayPush(&constants, constantCount - slots.count)))
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto end;
+	}
+	tokens->constants = constants.data;
+	tokens->constantCount = constants.count;
+	tokens->constantCapacity = constants.capacity;
+
+	CymbArray array = {
+		.data = tokens->tokens,
+		.count = tokens->count,
+		.capacity = tokens->capacity,
+		.elementSize = sizeof(CymbToken)
+	};
+	if(count > array.count && !cymbArrayPush(&array, count - array.count))
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto end;
+	}
+	tokens->tokens = array.data;
+	tokens->capacity = array.capacity;
+
+	// The following tokens move to their new index and offset.
+	CymbToken* const following = tokens->tokens + start + replacement->count;
+	memmove(following, tokens->tokens + end, (tokens->count - end) * sizeof(*following));
+	for(size_t tokenIndex = 0; tokenIndex < tokens->count - end; ++tokenIndex)
+	{
+		following[tokenIndex].offset = (uint32_t)(following[tokenIndex].offset + shift);
+	}
+
+	size_t constantIndex = 0;
+	for(size_t tokenIndex = 0; tokenIndex < replacement->count; ++tokenIndex)
+	{
+		CymbToken* const token = &tokens->tokens[start + tokenIndex];
+		*token = replacement->tokens[tokenIndex];
+
+		if(token->type == CYMB_TOKEN_CONSTANT)
+		{
+			const uint32_t slot = constantIndex < slots.count ? ((const uint32_t*)slots.data)[constantIndex] : firstConstant + constantIndex - slots.count;
+			tokens->constants[slot] = replacement->constants[token->constant];
+			token->constant = slot;
+			++constantIndex;
+		}
+	}
+
+	tokens->count = count;
+
+	// The other tokens are matched among themselves, so their partners are unchanged and no bracket of the new tokens can match them.
+	cymbMatchBrackets(tokens->tokens + start, replacement->count);
 
 	end:
+	cymbArrayFree(&slots);
+
 	return result;
 }
 
+void cymbMatchBrackets(CymbToken* const tokens, const size_t count)
+{
+	// The unmatched opening tokens of each kind form a stack, linked through their partners as indices plus one.
+	uint32_t parentheses = 0;
+	uint32_t brackets = 0;
+	uint32_t braces = 0;
+
+	for(size_t tokenIndex = 0; tokenIndex < count; ++tokenIndex)
+	{
+		CymbToken* const token = &tokens[tokenIndex];
+
+		uint32_t* top;
+		bool opening;
+		switch(token->type)
+		{
+			case CYMB_TOKEN_OPEN_PARENTHESIS:
+			case CYMB_TOKEN_CLOSE_PARENTHESIS:
+				top = &parentheses;
+				opening = token->type == CYMB_TOKEN_OPEN_PARENTHESIS;
+				break;
+
+			case CYMB_TOKEN_OPEN_BRACKET:
+			case CYMB_TOKEN_CLOSE_BRACKET:
+				top = &brackets;
+				opening = token->type == CYMB_TOKEN_OPEN_BRACKET;
+				break;
+
+			case CYMB_TOKEN_OPEN_BRACE:
+			case CYMB_TOKEN_CLOSE_BRACE:
+				top = &braces;
+				opening = token->type == CYMB_TOKEN_OPEN_BRACE;
+				break;
+
+			default:
+				continue;
+		}
+
+		if(opening)
+		{
+			token->partner = *top;
+			*top = tokenIndex + 1;
+			continue;
+		}
+
+		if(*top == 0)
+		{
+			token->partner = 0;
+			continue;
+		}
+
+		CymbToken* const match = &tokens[*top - 1];
+		*top = match->partner;
+
+		token->partner = token - match;
+		match->partner = token->partner;
+	}
+
+	// The remaining opening tokens are unmatched.
+	const uint32_t tops[] = {parentheses, brackets, braces};
+	for(size_t topIndex = 0; topIndex < CYMB_LENGTH(tops); ++topIndex)
+	{
+		uint32_t index = tops[topIndex];
+		while(index != 0)
+		{
+			CymbToken* const token = &tokens[index - 1];
+			index = token->partner;
+			token->partner = 0;
+		}
+	}
+}
+
 void cymbFreeTokenList(CymbTokenList* const tokens)
 {
-	CYMB_FREE(tokens->tokens);
+	cymbArrayDataFree(tokens->tokens);
+	cymbArrayDataFree(tokens->constants);
 	*tokens = (CymbTokenList){};
 }
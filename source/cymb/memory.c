@@ -1,8 +1,28 @@
 #include "cymb/memory.h"
 
+#include <stdbit.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __SIZEOF_INT128__
+	__extension__ typedef unsigned __int128 CymbUint128;
+#elif defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#include <emmintrin.h>
+	#define CYMB_SSE2
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define CYMB_NEON
+#endif
+
 #undef cymbFind
 void* cymbFind(const void* const valueVoid, const void* const arrayVoid, const size_t count, const size_t size, const CymbCompare compare)
 {
@@ -18,29 +38,429 @@ void* cymbFind(const void* const valueVoid, const void* const arrayVoid, const s
 }
 
 constexpr size_t cymbRegionSize = 0x4000;
+constexpr size_t cymbRegionMaxSize = 0x1000000;
+constexpr size_t cymbLargeSize = 0x10000;
+constexpr size_t cymbHugePageSize = 0x200000;
 
-void cymbArenaCreate(CymbArena* const arena)
+/*
+ * Create a region.
+ * Regions of at least a huge page are mapped, so that they can be backed by huge pages.
+ *
+ * Parameters:
+ * - capacity: The minimum capacity of the region.
+ *
+ * Returns:
+ * - The region on success.
+ * - nullptr if memory allocation failed.
+ */
+static CymbRegion* cymbRegionCreate(size_t capacity)
 {
-	*arena = (CymbArena){};
+	if(capacity > cymbSizeMax - sizeof(CymbRegion) - cymbHugePageSize)
+	{
+		return nullptr;
+	}
+
+	size_t mappingSize = 0;
+
+	CymbRegion* region = nullptr;
+
+#ifdef __linux__
+	if(sizeof(*region) + capacity >= cymbHugePageSize)
+	{
+		mappingSize = (sizeof(*region) + capacity + cymbHugePageSize - 1) / cymbHugePageSize * cymbHugePageSize;
+
+		region = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(region == MAP_FAILED)
+		{
+			region = nullptr;
+			mappingSize = 0;
+		}
+		else
+		{
+#ifdef MADV_HUGEPAGE
+			// Huge pages are only a hint, the region is usable either way.
+			madvise(region, mappingSize, MADV_HUGEPAGE);
+#endif
+
+			capacity = mappingSize - sizeof(*region);
+		}
+	}
+#endif
+
+	if(!region)
+	{
+		region = malloc(sizeof(*region) + capacity);
+		if(!region)
+		{
+			return nullptr;
+		}
+	}
+
+	*region = (CymbRegion){
+		.capacity = capacity,
+		.mappingSize = mappingSize
+	};
+
+	return region;
 }
 
-void cymbArenaFree(CymbArena* const arena)
+/*
+ * Free a region.
+ *
+ * Parameters:
+ * - region: The region.
+ */
+static void cymbRegionFree(CymbRegion* const region)
+{
+#ifdef __linux__
+	if(region->mappingSize != 0)
+	{
+		munmap(region, region->mappingSize);
+		return;
+	}
+#endif
+
+	free(region);
+}
+
+/*
+ * Push a chain of regions on a pool class.
+ *
+ * Parameters:
+ * - pool: The pool.
+ * - sizeClass: The size class.
+ * - first: The first region of the chain.
+ * - last: The last region of the chain.
+ */
+static void cymbRegionPoolPush(CymbRegionPool* const pool, const size_t sizeClass, CymbRegion* const first, CymbRegion* const last)
+{
+	mtx_lock(&pool->locks[sizeClass]);
+	last->next = pool->classes[sizeClass];
+	pool->classes[sizeClass] = first;
+	mtx_unlock(&pool->locks[sizeClass]);
+}
+
+/*
+ * Take all the regions of a pool class.
+ *
+ * Parameters:
+ * - pool: The pool.
+ * - sizeClass: The size class.
+ *
+ * Returns:
+ * - The chain of regions, or nullptr if the class is empty.
+ */
+static CymbRegion* cymbRegionPoolTake(CymbRegionPool* const pool, const size_t sizeClass)
+{
+	mtx_lock(&pool->locks[sizeClass]);
+	CymbRegion* const regions = pool->classes[sizeClass];
+	pool->classes[sizeClass] = nullptr;
+	mtx_unlock(&pool->locks[sizeClass]);
+
+	return regions;
+}
+
+/*
+ * Take a region from a pool, or create it.
+ *
+ * Parameters:
+ * - pool: The pool, or nullptr.
+ * - capacity: The minimum capacity of the region.
+ *
+ * Returns:
+ * - The region on success.
+ * - nullptr if memory allocation failed.
+ */
+static CymbRegion* cymbRegionAcquire(CymbRegionPool* const pool, const size_t capacity)
+{
+	if(!pool)
+	{
+		return cymbRegionCreate(capacity);
+	}
+
+	// Every region of the smallest class at least as large as the capacity fits.
+	size_t sizeClass = 0;
+	while(sizeClass < cymbRegionClassCount && cymbRegionSize << sizeClass < capacity)
+	{
+		++sizeClass;
+	}
+	if(sizeClass == cymbRegionClassCount)
+	{
+		return cymbRegionCreate(capacity);
+	}
+
+	mtx_lock(&pool->locks[sizeClass]);
+	CymbRegion* const region = pool->classes[sizeClass];
+	if(region)
+	{
+		pool->classes[sizeClass] = region->next;
+	}
+	mtx_unlock(&pool->locks[sizeClass]);
+
+	if(!region)
+	{
+		return cymbRegionCreate(capacity);
+	}
+
+	atomic_fetch_sub_explicit(&pool->size, sizeof(*region) + region->capacity, memory_order_relaxed);
+
+	region->next = nullptr;
+	region->size = 0;
+
+	return region;
+}
+
+/*
+ * Return a region to a pool, or free it.
+ *
+ * Parameters:
+ * - pool: The pool, or nullptr.
+ * - region: The region.
+ */
+static void cymbRegionRelease(CymbRegionPool* const pool, CymbRegion* const region)
+{
+	if(!pool || region->capacity < cymbRegionSize)
+	{
+		cymbRegionFree(region);
+		return;
+	}
+
+	// The class is the largest one the capacity reaches.
+	size_t sizeClass = 0;
+	while(sizeClass < cymbRegionClassCount && cymbRegionSize << (sizeClass + 1) <= region->capacity)
+	{
+		++sizeClass;
+	}
+	if(sizeClass == cymbRegionClassCount)
+	{
+		cymbRegionFree(region);
+		return;
+	}
+
+	// The size is reserved before pushing, so that concurrent releases cannot exceed the maximum together.
+	const size_t size = sizeof(*region) + region->capacity;
+	if(size > pool->maxSize)
+	{
+		cymbRegionFree(region);
+		return;
+	}
+	if(atomic_fetch_add_explicit(&pool->size, size, memory_order_relaxed) > pool->maxSize - size)
+	{
+		atomic_fetch_sub_explicit(&pool->size, size, memory_order_relaxed);
+		cymbRegionFree(region);
+		return;
+	}
+
+	cymbRegionPoolPush(pool, sizeClass, region, region);
+}
+
+CymbResult cymbRegionPoolCreate(CymbRegionPool* const pool, const size_t maxSize)
+{
+	for(size_t sizeClass = 0; sizeClass < cymbRegionClassCount; ++sizeClass)
+	{
+		if(mtx_init(&pool->locks[sizeClass], mtx_plain) != thrd_success)
+		{
+			while(sizeClass--)
+			{
+				mtx_destroy(&pool->locks[sizeClass]);
+			}
+
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		pool->classes[sizeClass] = nullptr;
+	}
+
+	atomic_init(&pool->size, 0);
+	pool->maxSize = maxSize;
+
+	return CYMB_SUCCESS;
+}
+
+void cymbRegionPoolTrim(CymbRegionPool* const pool, const size_t retainedSize)
+{
+	size_t keptSize = 0;
+
+	for(size_t sizeClass = 0; sizeClass < cymbRegionClassCount; ++sizeClass)
+	{
+		CymbRegion* region = cymbRegionPoolTake(pool, sizeClass);
+
+		CymbRegion* first = nullptr;
+		CymbRegion* last = nullptr;
+		while(region)
+		{
+			CymbRegion* const next = region->next;
+
+			const size_t size = sizeof(*region) + region->capacity;
+			if(size <= retainedSize - keptSize)
+			{
+				keptSize += size;
+
+				region->next = first;
+				first = region;
+				if(!last)
+				{
+					last = region;
+				}
+			}
+			else
+			{
+				atomic_fetch_sub_explicit(&pool->size, size, memory_order_relaxed);
+				cymbRegionFree(region);
+			}
+
+			region = next;
+		}
+
+		if(first)
+		{
+			cymbRegionPoolPush(pool, sizeClass, first, last);
+		}
+	}
+}
+
+void cymbRegionPoolFree(CymbRegionPool* const pool)
+{
+	for(size_t sizeClass = 0; sizeClass < cymbRegionClassCount; ++sizeClass)
+	{
+		CymbRegion* region = pool->classes[sizeClass];
+		while(region)
+		{
+			CymbRegion* const next = region->next;
+
+			cymbRegionFree(region);
+
+			region = next;
+		}
+
+		mtx_destroy(&pool->locks[sizeClass]);
+	}
+
+	atomic_store_explicit(&pool->size, 0, memory_order_relaxed);
+}
+
+/*
+ * Count a region added to an arena.
+ *
+ * Parameters:
+ * - arena: The arena.
+ * - region: The region.
+ */
+static void cymbArenaAddRegion(CymbArena* const arena, const CymbRegion* const region)
+{
+	++arena->stats.regionCount;
+	arena->stats.size += sizeof(*region) + region->capacity;
+	arena->stats.peakSize = CYMB_MAX(arena->stats.peakSize, arena->stats.size);
+}
+
+/*
+ * Release a region of an arena.
+ *
+ * Parameters:
+ * - arena: The arena.
+ * - region: The region.
+ */
+static void cymbArenaReleaseRegion(CymbArena* const arena, CymbRegion* const region)
+{
+	--arena->stats.regionCount;
+	arena->stats.size -= sizeof(*region) + region->capacity;
+
+	cymbRegionRelease(arena->pool, region);
+}
+
+/*
+ * Free the large allocations of an arena down to a given one.
+ *
+ * Parameters:
+ * - arena: The arena.
+ * - large: The large allocation to stop at.
+ */
+static void cymbArenaFreeLarge(CymbArena* const arena, const CymbRegion* const large)
+{
+	while(arena->large != large)
+	{
+		CymbRegion* const next = arena->large->next;
+
+		cymbArenaReleaseRegion(arena, arena->large);
+
+		arena->large = next;
+	}
+}
+
+/*
+ * Free the regions of an arena.
+ *
+ * Parameters:
+ * - arena: The arena.
+ */
+static void cymbArenaFreeRegions(CymbArena* const arena)
 {
 	CymbRegion* region = arena->start;
 	while(region)
 	{
 		CymbRegion* const next = region->next;
 
-		free(region);
+		cymbArenaReleaseRegion(arena, region);
 
 		region = next;
 	}
 
+	arena->start = nullptr;
+	arena->end = nullptr;
+}
+
+void cymbArenaCreate(CymbArena* const arena)
+{
+	*arena = (CymbArena){};
+}
+
+void cymbArenaCreatePooled(CymbArena* const arena, CymbRegionPool* const pool)
+{
+	*arena = (CymbArena){
+		.pool = pool
+	};
+}
+
+void cymbArenaFree(CymbArena* const arena)
+{
+	cymbArenaFreeLarge(arena, nullptr);
+	cymbArenaFreeRegions(arena);
+
 	*arena = (CymbArena){};
 }
 
 void* cymbArenaAllocate(CymbArena* const arena, const size_t size, const size_t alignment)
 {
+	// Large allocations get their own region, so that they do not waste the end of regular ones.
+	if(size > cymbLargeSize)
+	{
+		const size_t padding = alignment > alignof(max_align_t) ? alignment - 1 : 0;
+		if(size > cymbSizeMax - padding)
+		{
+			return nullptr;
+		}
+
+		CymbRegion* const large = cymbRegionAcquire(arena->pool, size + padding);
+		if(!large)
+		{
+			return nullptr;
+		}
+
+		large->size = size + padding;
+		large->next = arena->large;
+		arena->large = large;
+
+		cymbArenaAddRegion(arena, large);
+
+		const size_t offset = (uintptr_t)large->data % alignment;
+		const size_t alignmentOffset = offset == 0 ? 0 : alignment - offset;
+
+		arena->stats.requestedSize += size;
+		arena->stats.paddingSize += alignmentOffset;
+
+		return large->data + alignmentOffset;
+	}
+
 	CymbRegion* region = arena->end;
 	while(region)
 	{
@@ -62,25 +482,29 @@ void* cymbArenaAllocate(CymbArena* const arena, const size_t size, const size_t
 
 			region->size = offset + size;
 
+			arena->stats.requestedSize += size;
+			arena->stats.paddingSize += alignmentOffset;
+
 			return result;
 		}
 
 		next:
+		++arena->stats.fullRegionCount;
 		region = region->next;
 	}
 
-	const size_t capacity = CYMB_MAX(size, cymbRegionSize);
+	// Each new region is twice as large as the last one, up to a maximum.
+	const size_t capacity = arena->end ? CYMB_MIN(arena->end->capacity * 2, cymbRegionMaxSize) : cymbRegionSize;
 
-	region = malloc(sizeof(*region) + capacity);
+	region = cymbRegionAcquire(arena->pool, CYMB_MAX(size, capacity));
 	if(!region)
 	{
 		return nullptr;
 	}
+	region->size = size;
 
-	*region = (CymbRegion){
-		.size = size,
-		.capacity = capacity
-	};
+	cymbArenaAddRegion(arena, region);
+	arena->stats.requestedSize += size;
 
 	if(arena->end)
 	{
@@ -97,6 +521,8 @@ void* cymbArenaAllocate(CymbArena* const arena, const size_t size, const size_t
 
 void cymbArenaClear(CymbArena* arena)
 {
+	cymbArenaFreeLarge(arena, nullptr);
+
 	CymbRegion* region = arena->start;
 	while(region)
 	{
@@ -107,27 +533,78 @@ void cymbArenaClear(CymbArena* arena)
 	arena->end = arena->start;
 }
 
+void cymbArenaTrim(CymbArena* const arena, const CymbRetention retention)
+{
+	size_t retainedSize = 0;
+
+	CymbRegion** link = &arena->start;
+	while(*link)
+	{
+		CymbRegion* const region = *link;
+
+		const size_t size = sizeof(*region) + region->capacity;
+		if((region == arena->start && retention.keepFirstRegion) || size <= retention.retainedSize - CYMB_MIN(retainedSize, retention.retainedSize))
+		{
+			retainedSize += size;
+			link = &region->next;
+			continue;
+		}
+
+#ifdef __linux__
+		// Mapped regions keep their address range and only give back their pages, which come back zeroed when touched.
+		if(!arena->pool && region->mappingSize != 0)
+		{
+			const size_t pageSize = sysconf(_SC_PAGESIZE);
+			madvise((char*)region + pageSize, region->mappingSize - pageSize, MADV_DONTNEED);
+
+			link = &region->next;
+			continue;
+		}
+#endif
+
+		*link = region->next;
+		cymbArenaReleaseRegion(arena, region);
+	}
+
+	arena->end = arena->start;
+}
+
+void cymbArenaResetStats(CymbArena* const arena)
+{
+	arena->stats = (CymbArenaStats){
+		.regionCount = arena->stats.regionCount,
+		.size = arena->stats.size,
+		.peakSize = arena->stats.size
+	};
+}
+
 CymbArenaSave cymbArenaSave(CymbArena* const arena)
 {
 	return (CymbArenaSave){
 		.region = arena->end,
-		.size = arena->end ? arena->end->size : 0
+		.size = arena->end ? arena->end->size : 0,
+		.large = arena->large
 	};
 }
 
 void cymbArenaRestore(CymbArena* const arena, const CymbArenaSave save)
 {
+	cymbArenaFreeLarge(arena, save.large);
+
+	CymbRegion* region;
 	if(save.region)
 	{
 		save.region->size = save.size;
+
+		region = save.region->next;
+		arena->end = save.region;
 	}
 	else
 	{
-		arena->start = save.region;
+		region = arena->start;
+		arena->end = arena->start;
 	}
-	arena->end = save.region;
 
-	CymbRegion* region = save.region ? save.region->next : nullptr;
 	while(region)
 	{
 		region->size = 0;
@@ -135,45 +612,193 @@ void cymbArenaRestore(CymbArena* const arena, const CymbArenaSave save)
 	}
 }
 
-uint32_t cymbRotateLeft32(const uint32_t value, const unsigned char rotation)
+/*
+ * The header of the data of an array.
+ *
+ * Fields:
+ * - mappingSize: The size of the mapping if the data is mapped, 0 if it is allocated.
+ * - data: The data.
+ */
+typedef struct CymbArrayHeader
 {
-	return (value << rotation) | (value >> (32 - rotation));
-}
+	size_t mappingSize;
 
-uint64_t cymbRotateRight64(const uint64_t value, const unsigned char rotation)
-{
-	return (value >> rotation) | (value << (64 - rotation));
-}
+	alignas(max_align_t) char data[];
+} CymbArrayHeader;
+
+constexpr size_t cymbArrayMapSize = 0x10000;
 
 /*
- * Perform the scramble step of Murmur3 hash.
+ * Get the header of the data of an array.
  *
  * Parameters:
- * - chunk: A chunk of bytes.
+ * - data: The data.
  *
  * Returns:
- * - The scrambled chunk.
+ * - The header.
  */
-static uint32_t cymbMurmur3Scramble(uint32_t chunk)
+static CymbArrayHeader* cymbArrayHeader(void* const data)
 {
-	chunk *= 0xCC9E2D51;
-	chunk = cymbRotateLeft32(chunk, 15);
-	chunk *= 0x1B873593;
+	return (CymbArrayHeader*)((char*)data - offsetof(CymbArrayHeader, data));
+}
 
-	return chunk;
+void cymbArrayCreate(CymbArray* const array, const size_t elementSize)
+{
+	*array = (CymbArray){
+		.elementSize = elementSize
+	};
 }
 
-uint32_t cymbMurmur3(const unsigned char* string, const size_t length)
+void cymbArrayFree(CymbArray* const array)
 {
-	uint32_t hash = 0;
-	uint32_t chunk;
+	cymbArrayDataFree(array->data);
 
-	for(size_t blockIndex = length >> 2; blockIndex > 0; --blockIndex)
-	{
-		memcpy(&chunk, string, sizeof(uint32_t));
-		string += sizeof(uint32_t);
+	cymbArrayCreate(array, array->elementSize);
+}
 
-		hash ^= cymbMurmur3Scramble(chunk);
+void cymbArrayDataFree(void* const data)
+{
+	if(!data)
+	{
+		return;
+	}
+
+	CymbArrayHeader* const header = cymbArrayHeader(data);
+
+#ifdef __linux__
+	if(header->mappingSize != 0)
+	{
+		munmap(header, header->mappingSize);
+		return;
+	}
+#endif
+
+	free(header);
+}
+
+CymbResult cymbArrayReserve(CymbArray* const array, size_t capacity)
+{
+	if(capacity <= array->capacity)
+	{
+		return CYMB_SUCCESS;
+	}
+
+	const size_t maxCapacity = (cymbSizeMax - sizeof(CymbArrayHeader) - cymbArrayMapSize) / array->elementSize;
+	if(capacity > maxCapacity)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	// Grow at least geometrically to keep appending linear.
+	capacity = CYMB_MAX(capacity, array->capacity > maxCapacity / 2 ? maxCapacity : array->capacity * 2);
+
+	CymbArrayHeader* header = array->data ? cymbArrayHeader(array->data) : nullptr;
+	const size_t size = sizeof(*header) + capacity * array->elementSize;
+
+#ifdef __linux__
+	if(size >= cymbArrayMapSize)
+	{
+		const size_t mappingSize = (size + cymbArrayMapSize - 1) / cymbArrayMapSize * cymbArrayMapSize;
+
+		CymbArrayHeader* newHeader;
+		if(header && header->mappingSize != 0)
+		{
+			newHeader = mremap(header, header->mappingSize, mappingSize, MREMAP_MAYMOVE);
+			if(newHeader == MAP_FAILED)
+			{
+				return CYMB_OUT_OF_MEMORY;
+			}
+		}
+		else
+		{
+			newHeader = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if(newHeader == MAP_FAILED)
+			{
+				return CYMB_OUT_OF_MEMORY;
+			}
+
+			// Only small arrays are copied, once.
+			if(header)
+			{
+				memcpy(newHeader->data, header->data, array->count * array->elementSize);
+				free(header);
+			}
+		}
+
+		newHeader->mappingSize = mappingSize;
+
+		array->data = newHeader->data;
+		array->capacity = (mappingSize - sizeof(*newHeader)) / array->elementSize;
+
+		return CYMB_SUCCESS;
+	}
+#endif
+
+	CymbArrayHeader* const newHeader = realloc(header, size);
+	if(!newHeader)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+	newHeader->mappingSize = 0;
+
+	array->data = newHeader->data;
+	array->capacity = capacity;
+
+	return CYMB_SUCCESS;
+}
+
+void* cymbArrayPush(CymbArray* const array, const size_t count)
+{
+	if(count > array->capacity - array->count && (array->count > SIZE_MAX - count || cymbArrayReserve(array, array->count + count) != CYMB_SUCCESS))
+	{
+		return nullptr;
+	}
+
+	void* const elements = (char*)array->data + array->count * array->elementSize;
+	array->count += count;
+
+	return elements;
+}
+
+uint32_t cymbRotateLeft32(const uint32_t value, const unsigned char rotation)
+{
+	return (value << rotation) | (value >> (32 - rotation));
+}
+
+uint64_t cymbRotateRight64(const uint64_t value, const unsigned char rotation)
+{
+	return (value >> rotation) | (value << (64 - rotation));
+}
+
+/*
+ * Perform the scramble step of Murmur3 hash.
+ *
+ * Parameters:
+ * - chunk: A chunk of bytes.
+ *
+ * Returns:
+ * - The scrambled chunk.
+ */
+static uint32_t cymbMurmur3Scramble(uint32_t chunk)
+{
+	chunk *= 0xCC9E2D51;
+	chunk = cymbRotateLeft32(chunk, 15);
+	chunk *= 0x1B873593;
+
+	return chunk;
+}
+
+uint32_t cymbMurmur3(const unsigned char* string, const size_t length)
+{
+	uint32_t hash = 0;
+	uint32_t chunk;
+
+	for(size_t blockIndex = length >> 2; blockIndex > 0; --blockIndex)
+	{
+		memcpy(&chunk, string, sizeof(uint32_t));
+		string += sizeof(uint32_t);
+
+		hash ^= cymbMurmur3Scramble(chunk);
 		hash = cymbRotateLeft32(hash, 13);
 		hash = hash * 5 + 0xE6546B64;
 	}
@@ -197,153 +822,663 @@ uint32_t cymbMurmur3(const unsigned char* string, const size_t length)
 	return hash;
 }
 
-CymbResult cymbMapCreate(CymbMap* const map, CymbArena* const arena, const size_t binCount, const size_t elementSize, const size_t elementAlignment)
+/*
+ * Secret constants of the hash.
+ */
+static const uint64_t cymbHashSecrets[] = {0x2D35'8DCC'AA6C'78A5, 0x8BB8'4B93'962E'ACC9, 0x4B33'A62E'D433'D4A3, 0x4D5A'2DA5'1DE1'AA47};
+
+/*
+ * Multiply two 64-bit integers into a 128-bit one.
+ *
+ * Parameters:
+ * - first: The first factor, set to the low half of the product.
+ * - second: The second factor, set to the high half of the product.
+ */
+static void cymbHashMultiply(uint64_t* const first, uint64_t* const second)
 {
-	CymbResult result = CYMB_SUCCESS;
+#ifdef __SIZEOF_INT128__
+	const CymbUint128 product = (CymbUint128)*first * *second;
+	*first = (uint64_t)product;
+	*second = (uint64_t)(product >> 64);
+#elif defined(_M_X64)
+	*first = _umul128(*first, *second, second);
+#else
+	const uint64_t firstLow = *first & 0xFFFF'FFFF;
+	const uint64_t firstHigh = *first >> 32;
+	const uint64_t secondLow = *second & 0xFFFF'FFFF;
+	const uint64_t secondHigh = *second >> 32;
+
+	const uint64_t low = firstLow * secondLow;
+	const uint64_t middleFirst = firstHigh * secondLow;
+	const uint64_t middleSecond = firstLow * secondHigh;
+	const uint64_t high = firstHigh * secondHigh;
+
+	const uint64_t carry = ((low >> 32) + (middleFirst & 0xFFFF'FFFF) + (middleSecond & 0xFFFF'FFFF)) >> 32;
+
+	*first = *first * *second;
+	*second = high + (middleFirst >> 32) + (middleSecond >> 32) + carry;
+#endif
+}
 
-	*map = (CymbMap){
-		.binCount = binCount,
-		.elementSize = elementSize,
-		.elementAlignment = elementAlignment,
-		.arena = arena
-	};
+/*
+ * Mix two 64-bit integers by folding their 128-bit product.
+ *
+ * Parameters:
+ * - first: The first integer.
+ * - second: The second integer.
+ *
+ * Returns:
+ * - The mixed integer.
+ */
+static uint64_t cymbHashMix(uint64_t first, uint64_t second)
+{
+	cymbHashMultiply(&first, &second);
+
+	return first ^ second;
+}
+
+/*
+ * Read 8 bytes as an integer.
+ *
+ * Parameters:
+ * - string: The bytes.
+ *
+ * Returns:
+ * - The integer.
+ */
+static uint64_t cymbHashRead64(const unsigned char* const string)
+{
+	uint64_t value;
+	memcpy(&value, string, sizeof(value));
+
+	return value;
+}
 
-	map->bins = cymbArenaAllocate(map->arena, binCount * sizeof(map->bins[0]), alignof(typeof(map->bins[0])));
-	if(!map->bins)
+/*
+ * Read 4 bytes as an integer.
+ *
+ * Parameters:
+ * - string: The bytes.
+ *
+ * Returns:
+ * - The integer.
+ */
+static uint64_t cymbHashRead32(const unsigned char* const string)
+{
+	uint32_t value;
+	memcpy(&value, string, sizeof(value));
+
+	return value;
+}
+
+uint64_t cymbHash(const unsigned char* string, const size_t length)
+{
+	uint64_t seed = cymbHashMix(cymbHashSecrets[0], cymbHashSecrets[1]);
+
+	uint64_t first;
+	uint64_t second;
+
+	if(length <= 16)
 	{
-		result = CYMB_OUT_OF_MEMORY;
-		goto error;
+		// Two overlapping reads at each end cover every length from 4 to 16.
+		if(length >= 4)
+		{
+			const size_t offset = (length >> 3) << 2;
+			first = (cymbHashRead32(string) << 32) | cymbHashRead32(string + offset);
+			second = (cymbHashRead32(string + length - 4) << 32) | cymbHashRead32(string + length - 4 - offset);
+		}
+		else if(length > 0)
+		{
+			first = ((uint64_t)string[0] << 16) | ((uint64_t)string[length >> 1] << 8) | string[length - 1];
+			second = 0;
+		}
+		else
+		{
+			first = 0;
+			second = 0;
+		}
 	}
-	for(size_t bin = 0; bin < binCount; ++bin)
+	else
 	{
-		map->bins[bin].key.string = nullptr;
+		size_t remaining = length;
+
+		// Three independent lanes hide the latency of the multiplications.
+		if(remaining > 48)
+		{
+			uint64_t firstLane = seed;
+			uint64_t secondLane = seed;
+
+			do
+			{
+				seed = cymbHashMix(cymbHashRead64(string) ^ cymbHashSecrets[1], cymbHashRead64(string + 8) ^ seed);
+				firstLane = cymbHashMix(cymbHashRead64(string + 16) ^ cymbHashSecrets[2], cymbHashRead64(string + 24) ^ firstLane);
+				secondLane = cymbHashMix(cymbHashRead64(string + 32) ^ cymbHashSecrets[3], cymbHashRead64(string + 40) ^ secondLane);
+
+				string += 48;
+				remaining -= 48;
+			} while(remaining > 48);
+
+			seed ^= firstLane ^ secondLane;
+		}
+
+		while(remaining > 16)
+		{
+			seed = cymbHashMix(cymbHashRead64(string) ^ cymbHashSecrets[1], cymbHashRead64(string + 8) ^ seed);
+
+			string += 16;
+			remaining -= 16;
+		}
+
+		first = cymbHashRead64(string + remaining - 16);
+		second = cymbHashRead64(string + remaining - 8);
 	}
 
-	map->binElements = cymbArenaAllocate(map->arena, binCount * elementSize, elementAlignment);
-	if(!map->binElements)
+	first ^= cymbHashSecrets[1];
+	second ^= seed;
+	cymbHashMultiply(&first, &second);
+
+	return cymbHashMix(first ^ cymbHashSecrets[0] ^ length, second ^ cymbHashSecrets[1]);
+}
+
+/*
+ * Control byte of an empty slot.
+ * Other control bytes hold the 7 low bits of the hash of their key.
+ */
+constexpr unsigned char cymbMapEmpty = 0x80;
+
+/*
+ * Number of control bytes probed at once.
+ */
+constexpr size_t cymbMapGroupSize = 16;
+
+/*
+ * Maximum load of a map, in eighths of its capacity.
+ */
+constexpr size_t cymbMapMaxLoad = 7;
+
+#ifdef CYMB_SSE2
+
+/*
+ * Number of mask bits per control byte of a group.
+ */
+constexpr unsigned char cymbMapMaskStride = 1;
+
+/*
+ * Get the mask of the control bytes of a group equal to a value.
+ *
+ * Parameters:
+ * - group: The first control byte of the group.
+ * - control: The value to match.
+ *
+ * Returns:
+ * - The mask of the matching control bytes.
+ */
+static uint64_t cymbMapMatch(const unsigned char* const group, const unsigned char control)
+{
+	const __m128i controls = _mm_loadu_si128((const __m128i*)group);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8((char)control)));
+}
+
+#elif defined(CYMB_NEON)
+
+constexpr unsigned char cymbMapMaskStride = 4;
+
+static uint64_t cymbMapMatch(const unsigned char* const group, const unsigned char control)
+{
+	const uint8x16_t comparison = vceqq_u8(vld1q_u8(group), vdupq_n_u8(control));
+
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4)), 0) & 0x8888'8888'8888'8888;
+}
+
+#else
+
+constexpr unsigned char cymbMapMaskStride = 1;
+
+static uint64_t cymbMapMatch(const unsigned char* const group, const unsigned char control)
+{
+	uint64_t mask = 0;
+	for(size_t index = 0; index < cymbMapGroupSize; ++index)
 	{
-		result = CYMB_OUT_OF_MEMORY;
-		goto error;
+		mask |= (uint64_t)(group[index] == control) << index;
 	}
 
-	goto end;
+	return mask;
+}
 
-	error:
-	cymbMapFree(map);
+#endif
 
-	end:
-	return result;
+/*
+ * Hash a key.
+ *
+ * Parameters:
+ * - key: The key.
+ *
+ * Returns:
+ * - The hash.
+ */
+static uint64_t cymbMapHash(const CymbConstString key)
+{
+	return cymbHash((const unsigned char*)key.string, key.length);
 }
 
-void cymbMapFree(CymbMap* const map)
+/*
+ * Get the first slot to probe for a hash.
+ *
+ * Parameters:
+ * - map: The map.
+ * - hash: The hash.
+ *
+ * Returns:
+ * - The slot index.
+ */
+static size_t cymbMapHome(const CymbMap* const map, const uint64_t hash)
 {
-	*map = (CymbMap){};
+	return (hash >> 7) & (map->capacity - 1);
 }
 
 /*
- * Compare two keys.
+ * The start of a map slot, followed by its element.
+ *
+ * Fields:
+ * - hash: The hash of the key.
+ * - key: The key.
+ */
+typedef struct CymbMapSlot
+{
+	uint64_t hash;
+	CymbStringView key;
+} CymbMapSlot;
+
+/*
+ * Get a slot.
  *
  * Parameters:
- * - pairKey: The key of a pair in a map.
- * - key: The key to find in the map.
+ * - map: The map.
+ * - slot: The slot index.
  *
  * Returns:
- * - true if the keys are identical.
- * - false otherwise.
+ * - The slot.
  */
-static bool cymbMapCompareKeys(const CymbStringView pairKey, const CymbConstString key)
+static CymbMapSlot* cymbMapSlot(const CymbMap* const map, const size_t slot)
 {
-	return pairKey.length == key.length && memcmp(pairKey.string, key.string, key.length) == 0;
+	return (CymbMapSlot*)((char*)map->slots + slot * map->slotSize);
 }
 
 /*
- * Get the map bin for a key.
+ * Get the element of a slot.
  *
  * Parameters:
  * - map: The map.
- * - key: The key.
+ * - slot: The slot index.
  *
  * Returns:
- * - The bin index.
+ * - The element.
  */
-static size_t cymbMapBin(const CymbMap* const map, const CymbConstString key)
+static void* cymbMapElement(const CymbMap* const map, const size_t slot)
 {
-	return cymbMurmur3((const unsigned char*)key.string, key.length) % map->binCount;
+	return (char*)cymbMapSlot(map, slot) + map->elementOffset;
 }
 
-CymbResult cymbMapStore(CymbMap* const map, const CymbStringView key, const void* const element)
+/*
+ * Set the control byte of a slot, and its copy after the end.
+ *
+ * Parameters:
+ * - map: The map.
+ * - slot: The slot index.
+ * - control: The control byte.
+ */
+static void cymbMapSetControl(CymbMap* const map, const size_t slot, const unsigned char control)
+{
+	map->controls[slot] = control;
+	if(slot < cymbMapGroupSize - 1)
+	{
+		map->controls[map->capacity + slot] = control;
+	}
+}
+
+/*
+ * Find the slot of a key, or the empty slot where it would be stored.
+ *
+ * Parameters:
+ * - map: The map.
+ * - key: The key.
+ * - hash: The hash of the key.
+ * - slot: The slot index.
+ *
+ * Returns:
+ * - true if the key was found.
+ * - false otherwise.
+ */
+static bool cymbMapFind(const CymbMap* const map, const CymbConstString key, const uint64_t hash, size_t* const slot)
 {
-	const size_t bin = cymbMapBin(map, key);
+	const size_t capacityMask = map->capacity - 1;
+	const unsigned char control = hash & 0x7F;
 
-	CymbMapPair* pair = &map->bins[bin];
-	if(!pair->key.string)
+	size_t group = cymbMapHome(map, hash);
+	while(true)
 	{
-		pair->key = key;
+		const unsigned char* const controls = map->controls + group;
 
-		pair->element = (char*)map->binElements + bin * map->elementSize;
-		memcpy(pair->element, element, map->elementSize);
+		const uint64_t emptyMask = cymbMapMatch(controls, cymbMapEmpty);
+		uint64_t mask = cymbMapMatch(controls, control);
 
-		pair->next = nullptr;
+		// Keys are stored contiguously from their home slot, so only slots before the first empty one are candidates.
+		if(emptyMask != 0)
+		{
+			mask &= (emptyMask & -emptyMask) - 1;
+		}
 
-		return CYMB_SUCCESS;
+		while(mask != 0)
+		{
+			const size_t candidate = (group + stdc_trailing_zeros(mask) / cymbMapMaskStride) & capacityMask;
+			mask &= mask - 1;
+
+			const CymbMapSlot* const candidateSlot = cymbMapSlot(map, candidate);
+			if(candidateSlot->hash == hash && candidateSlot->key.length == key.length && memcmp(candidateSlot->key.string, key.string, key.length) == 0)
+			{
+				*slot = candidate;
+				return true;
+			}
+		}
+
+		if(emptyMask != 0)
+		{
+			*slot = (group + stdc_trailing_zeros(emptyMask) / cymbMapMaskStride) & capacityMask;
+			return false;
+		}
+
+		group = (group + cymbMapGroupSize) & capacityMask;
+	}
+}
+
+/*
+ * Allocate the slots of a map.
+ *
+ * Parameters:
+ * - map: The map, with its capacity set.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+static CymbResult cymbMapAllocate(CymbMap* const map)
+{
+	if(map->capacity > cymbSizeMax / map->slotSize)
+	{
+		return CYMB_OUT_OF_MEMORY;
 	}
 
-	if(cymbMapCompareKeys(pair->key, key))
+	map->controls = cymbArenaAllocate(map->arena, map->capacity + cymbMapGroupSize - 1, 1);
+	map->slots = cymbArenaAllocate(map->arena, map->capacity * map->slotSize, CYMB_MAX(alignof(CymbMapSlot), map->elementAlignment));
+	if(!map->controls || !map->slots)
 	{
-		memcpy(pair->element, element, map->elementSize);
+		return CYMB_OUT_OF_MEMORY;
+	}
 
-		return CYMB_SUCCESS;
+	memset(map->controls, cymbMapEmpty, map->capacity + cymbMapGroupSize - 1);
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Double the capacity of a map.
+ * The previous slots are left in the arena.
+ *
+ * Parameters:
+ * - map: The map.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if allocation failed.
+ */
+static CymbResult cymbMapGrow(CymbMap* const map)
+{
+	if(map->capacity > cymbSizeMax / 2)
+	{
+		return CYMB_OUT_OF_MEMORY;
 	}
 
-	while(pair->next)
+	const CymbMap old = *map;
+
+	map->capacity *= 2;
+	const CymbResult result = cymbMapAllocate(map);
+	if(result != CYMB_SUCCESS)
 	{
-		pair = pair->next;
+		*map = old;
+		return result;
+	}
 
-		if(cymbMapCompareKeys(pair->key, key))
+	for(size_t oldSlot = 0; oldSlot < old.capacity; ++oldSlot)
+	{
+		if(old.controls[oldSlot] == cymbMapEmpty)
 		{
-			memcpy(pair->element, element, map->elementSize);
+			continue;
+		}
+
+		const CymbMapSlot* const moved = cymbMapSlot(&old, oldSlot);
 
-			return CYMB_SUCCESS;
+		// Keys are unique, so the first empty slot from the home slot is the right one.
+		size_t slot = cymbMapHome(map, moved->hash);
+		while(map->controls[slot] != cymbMapEmpty)
+		{
+			slot = (slot + 1) & (map->capacity - 1);
 		}
+
+		cymbMapSetControl(map, slot, old.controls[oldSlot]);
+		memcpy(cymbMapSlot(map, slot), moved, map->slotSize);
 	}
-	
-	CymbMapPair* const next = cymbArenaAllocate(map->arena, sizeof(*next), alignof(typeof(*next)));
-	if(!next)
+
+	return CYMB_SUCCESS;
+}
+
+CymbResult cymbMapCreate(CymbMap* const map, CymbArena* const arena, const size_t capacity, const size_t elementSize, const size_t elementAlignment)
+{
+	*map = (CymbMap){
+		.capacity = cymbMapGroupSize,
+		.elementSize = elementSize,
+		.elementAlignment = elementAlignment,
+		.arena = arena
+	};
+
+	if(elementSize > cymbSizeMax / 2)
 	{
+		cymbMapFree(map);
 		return CYMB_OUT_OF_MEMORY;
 	}
 
-	next->next = nullptr;
+	const size_t slotAlignment = CYMB_MAX(alignof(CymbMapSlot), elementAlignment);
+	map->elementOffset = (sizeof(CymbMapSlot) + elementAlignment - 1) / elementAlignment * elementAlignment;
+	map->slotSize = (map->elementOffset + elementSize + slotAlignment - 1) / slotAlignment * slotAlignment;
+
+	// Leave room for the expected elements below the maximum load.
+	while(map->capacity / 8 * cymbMapMaxLoad < capacity)
+	{
+		if(map->capacity > cymbSizeMax / 2)
+		{
+			cymbMapFree(map);
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		map->capacity *= 2;
+	}
+
+	const CymbResult result = cymbMapAllocate(map);
+	if(result != CYMB_SUCCESS)
+	{
+		cymbMapFree(map);
+	}
+
+	return result;
+}
+
+void cymbMapFree(CymbMap* const map)
+{
+	*map = (CymbMap){};
+}
+
+CymbResult cymbMapStore(CymbMap* const map, const CymbStringView key, const void* const element)
+{
+	const uint64_t hash = cymbMapHash(key);
+
+	size_t slot;
+	if(cymbMapFind(map, key, hash, &slot))
+	{
+		memcpy(cymbMapElement(map, slot), element, map->elementSize);
+
+		return CYMB_SUCCESS;
+	}
+
+	if(map->count + 1 > map->capacity / 8 * cymbMapMaxLoad)
+	{
+		const CymbResult result = cymbMapGrow(map);
+		if(result != CYMB_SUCCESS)
+		{
+			return result;
+		}
 
-	next->key = key;
+		cymbMapFind(map, key, hash, &slot);
+	}
 
-	next->element = cymbArenaAllocate(map->arena, map->elementSize, map->elementAlignment);
-	memcpy(next->element, element, map->elementSize);
+	cymbMapSetControl(map, slot, hash & 0x7F);
+	*cymbMapSlot(map, slot) = (CymbMapSlot){hash, key};
+	memcpy(cymbMapElement(map, slot), element, map->elementSize);
 
-	pair->next = next;
+	++map->count;
 
 	return CYMB_SUCCESS;
 }
 
 void* cymbMapRead(const CymbMap* const map, const CymbStringView key)
 {
-	const size_t bin = cymbMapBin(map, key);
-
-	const CymbMapPair* pair = &map->bins[bin];
-	if(!pair->key.string)
+	size_t slot;
+	if(!cymbMapFind(map, key, cymbMapHash(key), &slot))
 	{
 		return nullptr;
 	}
 
-	while(pair)
+	return cymbMapElement(map, slot);
+}
+
+bool cymbMapRemove(CymbMap* const map, const CymbStringView key)
+{
+	size_t hole;
+	if(!cymbMapFind(map, key, cymbMapHash(key), &hole))
+	{
+		return false;
+	}
+
+	const size_t capacityMask = map->capacity - 1;
+
+	// Shift back the following keys which may fill the hole without moving before their home slot.
+	for(size_t slot = (hole + 1) & capacityMask; map->controls[slot] != cymbMapEmpty; slot = (slot + 1) & capacityMask)
 	{
-		if(cymbMapCompareKeys(pair->key, key))
+		const size_t home = cymbMapHome(map, cymbMapSlot(map, slot)->hash);
+		if(((slot - home) & capacityMask) < ((slot - hole) & capacityMask))
 		{
-			return pair->element;
+			continue;
 		}
 
-		pair = pair->next;
+		cymbMapSetControl(map, hole, map->controls[slot]);
+		memcpy(cymbMapSlot(map, hole), cymbMapSlot(map, slot), map->slotSize);
+
+		hole = slot;
 	}
 
-	return nullptr;
+	cymbMapSetControl(map, hole, cymbMapEmpty);
+	--map->count;
+
+	return true;
+}
+
+/*
+ * Number of elements the map of an interner is created for.
+ */
+constexpr size_t cymbInternerCapacity = 256;
+
+CymbResult cymbInternerCreate(CymbInterner* const interner, CymbArena* const arena)
+{
+	*interner = (CymbInterner){};
+
+	return cymbMapCreate(&interner->map, arena, cymbInternerCapacity, sizeof(uint32_t), alignof(uint32_t));
+}
+
+void cymbInternerFree(CymbInterner* const interner)
+{
+	cymbMapFree(&interner->map);
+	free(interner->strings);
+
+	*interner = (CymbInterner){};
+}
+
+CymbResult cymbIntern(CymbInterner* const interner, const CymbStringView string, uint32_t* const symbol)
+{
+	const uint32_t* const existing = cymbMapRead(&interner->map, string);
+	if(existing)
+	{
+		*symbol = *existing;
+		return CYMB_SUCCESS;
+	}
+
+	if(interner->count == interner->capacity)
+	{
+		if(interner->capacity == UINT32_MAX)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		const uint32_t capacity = interner->capacity == 0 ? 64 : interner->capacity > UINT32_MAX / 2 ? UINT32_MAX : interner->capacity * 2;
+		CymbStringView* const strings = realloc(interner->strings, capacity * sizeof(interner->strings[0]));
+		if(!strings)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		interner->strings = strings;
+		interner->capacity = capacity;
+	}
+
+	if(string.length == cymbSizeMax)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	char* const copy = cymbArenaAllocate(interner->map.arena, string.length + 1, 1);
+	if(!copy)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+	memcpy(copy, string.string, string.length);
+	copy[string.length] = '\0';
+
+	const CymbStringView key = {copy, string.length};
+
+	const CymbResult result = cymbMapStore(&interner->map, key, &interner->count);
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
+	}
+
+	interner->strings[interner->count] = key;
+	*symbol = interner->count;
+	++interner->count;
+
+	return CYMB_SUCCESS;
+}
+
+bool cymbInternerFind(const CymbInterner* const interner, const CymbStringView string, uint32_t* const symbol)
+{
+	const uint32_t* const existing = cymbMapRead(&interner->map, string);
+	if(!existing)
+	{
+		return false;
+	}
+
+	*symbol = *existing;
+	return true;
+}
+
+CymbStringView cymbInternerString(const CymbInterner* const interner, const uint32_t symbol)
+{
+	return interner->strings[symbol];
 }
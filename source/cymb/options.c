@@ -1,6 +1,7 @@
 #include "cymb/options.h"
 
 #include <ctype.h>
+#include <limits.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,10 +15,14 @@
 typedef enum CymbOption
 {
 	CYMB_OPTION_DEBUG,
+	CYMB_OPTION_ERROR_LIMIT,
 	CYMB_OPTION_HELP,
 	CYMB_OPTION_OUTPUT,
+	CYMB_OPTION_RETAIN,
 	CYMB_OPTION_STANDARD,
+	CYMB_OPTION_STATS,
 	CYMB_OPTION_TAB_WIDTH,
+	CYMB_OPTION_THREADS,
 	CYMB_OPTION_VERSION
 } CymbOption;
 
@@ -37,10 +42,14 @@ typedef struct CymbLongOption
 // The long options must be stored in the same order as the options enum and in alphabetical order.
 const CymbLongOption longOptions[] = {
 	{CYMB_STRING("debug"), false},
+	{CYMB_STRING("error-limit"), true},
 	{CYMB_STRING("help"), false},
 	{CYMB_STRING("output"), true},
+	{CYMB_STRING("retain"), true},
 	{CYMB_STRING("standard"), true},
+	{CYMB_STRING("stats"), false},
 	{CYMB_STRING("tab-width"), true},
+	{CYMB_STRING("threads"), true},
 	{CYMB_STRING("version"), false}
 };
 constexpr size_t longOptionCount = CYMB_LENGTH(longOptions);
@@ -63,6 +72,7 @@ typedef struct CymbShortOption
 const CymbShortOption shortOptions[] = {
 	{'g', CYMB_OPTION_DEBUG},
 	{'h', CYMB_OPTION_HELP},
+	{'j', CYMB_OPTION_THREADS},
 	{'o', CYMB_OPTION_OUTPUT},
 	{'v', CYMB_OPTION_VERSION}
 };
@@ -142,6 +152,10 @@ static CymbResult cymbApplyOption(CymbOptions* const options, const CymbOption o
 			options->debug = true;
 			break;
 
+		case CYMB_OPTION_STATS:
+			options->stats = true;
+			break;
+
 		case CYMB_OPTION_OUTPUT:
 			options->output = argument->string;
 			break;
@@ -257,6 +271,145 @@ static CymbResult cymbApplyOption(CymbOptions* const options, const CymbOption o
 
 			break;
 
+		case CYMB_OPTION_ERROR_LIMIT:
+			if(!isdigit((unsigned char)*argument->string))
+			{
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_INVALID_ARGUMENT,
+					.info = {
+						.hint = *argument
+					}
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				break;
+			}
+
+			char* limitEnd;
+			const unsigned long errorLimit = strtoul(argument->string, &limitEnd, 10);
+
+			if(errorLimit > USHRT_MAX || limitEnd == argument->string || *limitEnd != '\0')
+			{
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_INVALID_ARGUMENT,
+					.info = {
+						.hint = *argument
+					}
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				break;
+			}
+
+			options->errorLimit = errorLimit;
+
+			break;
+
+		case CYMB_OPTION_RETAIN:
+			if(!isdigit((unsigned char)*argument->string))
+			{
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_INVALID_ARGUMENT,
+					.info = {
+						.hint = *argument
+					}
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				break;
+			}
+
+			// The size is given in mebibytes.
+			char* retainEnd;
+			const unsigned long retainedSize = strtoul(argument->string, &retainEnd, 10);
+
+			if(retainedSize > 0x100 || retainEnd == argument->string || *retainEnd != '\0')
+			{
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_INVALID_ARGUMENT,
+					.info = {
+						.hint = *argument
+					}
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				break;
+			}
+
+			options->retainedSize = (size_t)retainedSize << 20;
+
+			break;
+
+		case CYMB_OPTION_THREADS:
+			if(!isdigit((unsigned char)*argument->string))
+			{
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_INVALID_ARGUMENT,
+					.info = {
+						.hint = *argument
+					}
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				break;
+			}
+
+			char* threadsEnd;
+			const unsigned long threadCount = strtoul(argument->string, &threadsEnd, 10);
+
+			if(threadCount == 0 || threadCount > 256 || threadsEnd == argument->string || *threadsEnd != '\0')
+			{
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_INVALID_ARGUMENT,
+					.info = {
+						.hint = *argument
+					}
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				break;
+			}
+
+			options->threadCount = threadCount;
+
+			break;
+
 		default:
 			unreachable();
 	}
@@ -332,6 +485,9 @@ static CymbResult cymbParseShortOptions(CymbArgumentsParser* const parser)
 			{
 				optionArgument = (CymbConstString){argument, parser->arguments->length - (argument - parser->arguments->string)};
 
+				// The rest of the argument is the option argument.
+				argument = parser->arguments->string + parser->arguments->length;
+
 				goto apply;
 			}
 
@@ -515,8 +671,10 @@ CymbResult cymbParseArguments(const CymbConstString* const arguments, const size
 	CymbResult result = CYMB_SUCCESS;
 
 	*options = (CymbOptions){
+		.retainedSize = cymbDefaultRetainedSize,
 		.standard = CYMB_C23,
-		.tabWidth = 8
+		.tabWidth = 8,
+		.threadCount = 1
 	};
 
 	CymbArgumentsParser parser = {
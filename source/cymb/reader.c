@@ -1,6 +1,30 @@
 #include "cymb/reader.h"
 
 #include <ctype.h>
+#include <stdbit.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#include <emmintrin.h>
+	#define CYMB_SSE2
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define CYMB_NEON
+#endif
+
+/*
+ * Chunks are read aligned so they never cross a page boundary, but they may extend past the null terminator.
+ * The address sanitizer would report these reads.
+ */
+#ifdef __has_c_attribute
+	#if __has_c_attribute(gnu::no_sanitize_address)
+		#define CYMB_CHUNK_READ [[gnu::no_sanitize_address]]
+	#endif
+#endif
+#ifndef CYMB_CHUNK_READ
+	#define CYMB_CHUNK_READ
+#endif
 
 /*
  * Get the next line bounds.
@@ -34,8 +58,22 @@ void cymbReaderCreate(const char* const string, const unsigned char tabWidth, Cy
 	cymbReaderLine(reader);
 }
 
+void cymbReaderCreateLazy(const char* const string, CymbReader* const reader)
+{
+	*reader = (CymbReader){
+		.string = string,
+		.lazy = true
+	};
+}
+
 void cymbReaderPop(CymbReader* const reader)
 {
+	if(reader->lazy)
+	{
+		++reader->string;
+		return;
+	}
+
 	switch(*reader->string)
 	{
 		case '\n':
@@ -61,6 +99,12 @@ void cymbReaderPop(CymbReader* const reader)
 
 void cymbReaderSkip(CymbReader* const reader, size_t count)
 {
+	if(reader->lazy)
+	{
+		reader->string += count;
+		return;
+	}
+
 	while(count--)
 	{
 		cymbReaderPop(reader);
@@ -69,6 +113,13 @@ void cymbReaderSkip(CymbReader* const reader, size_t count)
 
 void cymbReaderSkipLine(CymbReader* const reader)
 {
+	if(reader->lazy)
+	{
+		const char* const newline = strchr(reader->string, '\n');
+		reader->string = newline ? newline + 1 : reader->string + strlen(reader->string);
+		return;
+	}
+
 	reader->string = reader->line.string + reader->line.length;
 	reader->string += *reader->string == '\n';
 
@@ -78,8 +129,199 @@ void cymbReaderSkipLine(CymbReader* const reader)
 	cymbReaderLine(reader);
 }
 
+/*
+ * Check if a character is a space, as isspace in the C locale.
+ *
+ * Parameters:
+ * - character: A character.
+ *
+ * Returns:
+ * - true if the character is a space.
+ * - false otherwise.
+ */
+static bool cymbIsSpace(const char character)
+{
+	return character == ' ' || (unsigned char)(character - '\t') <= '\r' - '\t';
+}
+
+#if defined(CYMB_SSE2) || defined(CYMB_NEON)
+
+/*
+ * Size of the chunks searched at once.
+ */
+constexpr size_t cymbChunkSize = 16;
+
+#ifdef CYMB_SSE2
+
+/*
+ * Number of mask bits per character of a chunk.
+ */
+constexpr unsigned char cymbMaskStride = 1;
+
+/*
+ * Get the mask of the characters of a chunk which are not spaces.
+ *
+ * Parameters:
+ * - chunk: An aligned chunk.
+ *
+ * Returns:
+ * - The mask of the characters which are not spaces.
+ */
+CYMB_CHUNK_READ static uint64_t cymbNonSpaceMask(const char* const chunk)
+{
+	const __m128i characters = _mm_load_si128((const __m128i*)chunk);
+
+	// Control spaces are the characters from '\t' to '\r'.
+	const __m128i shifted = _mm_sub_epi8(characters, _mm_set1_epi8('\t'));
+	const __m128i controls = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+	const __m128i spaces = _mm_or_si128(controls, _mm_cmpeq_epi8(characters, _mm_set1_epi8(' ')));
+
+	return ~_mm_movemask_epi8(spaces) & 0xFFFF;
+}
+
+/*
+ * Get the mask of the stars and null characters of a chunk.
+ *
+ * Parameters:
+ * - chunk: An aligned chunk.
+ *
+ * Returns:
+ * - The mask of the stars and null characters.
+ */
+CYMB_CHUNK_READ static uint64_t cymbStarMask(const char* const chunk)
+{
+	const __m128i characters = _mm_load_si128((const __m128i*)chunk);
+
+	const __m128i stars = _mm_cmpeq_epi8(characters, _mm_set1_epi8('*'));
+	const __m128i terminators = _mm_cmpeq_epi8(characters, _mm_setzero_si128());
+
+	return _mm_movemask_epi8(_mm_or_si128(stars, terminators));
+}
+
+#else
+
+constexpr unsigned char cymbMaskStride = 4;
+
+/*
+ * Narrow a comparison result to a mask with 4 bits per character.
+ *
+ * Parameters:
+ * - comparison: A comparison result.
+ *
+ * Returns:
+ * - The mask.
+ */
+static uint64_t cymbNarrowMask(const uint8x16_t comparison)
+{
+	return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4)), 0);
+}
+
+CYMB_CHUNK_READ static uint64_t cymbNonSpaceMask(const char* const chunk)
+{
+	const uint8x16_t characters = vld1q_u8((const uint8_t*)chunk);
+
+	const uint8x16_t controls = vcleq_u8(vsubq_u8(characters, vdupq_n_u8('\t')), vdupq_n_u8('\r' - '\t'));
+	const uint8x16_t spaces = vorrq_u8(controls, vceqq_u8(characters, vdupq_n_u8(' ')));
+
+	return cymbNarrowMask(vmvnq_u8(spaces));
+}
+
+CYMB_CHUNK_READ static uint64_t cymbStarMask(const char* const chunk)
+{
+	const uint8x16_t characters = vld1q_u8((const uint8_t*)chunk);
+
+	const uint8x16_t stars = vceqq_u8(characters, vdupq_n_u8('*'));
+	const uint8x16_t terminators = vceqq_u8(characters, vdupq_n_u8(0));
+
+	return cymbNarrowMask(vorrq_u8(stars, terminators));
+}
+
+#endif
+
+const char* cymbFindNonSpace(const char* string)
+{
+	// Most runs are short, so they are scanned one character at a time until the string is aligned.
+	while((uintptr_t)string % cymbChunkSize != 0)
+	{
+		if(!cymbIsSpace(*string))
+		{
+			return string;
+		}
+
+		++string;
+	}
+
+	while(true)
+	{
+		const uint64_t mask = cymbNonSpaceMask(string);
+		if(mask != 0)
+		{
+			return string + stdc_trailing_zeros(mask) / cymbMaskStride;
+		}
+
+		string += cymbChunkSize;
+	}
+}
+
+const char* cymbFindCommentEnd(const char* string)
+{
+	const char* chunk = string - (uintptr_t)string % cymbChunkSize;
+
+	// Ignore the characters of the first chunk before the string.
+	uint64_t mask = cymbStarMask(chunk) >> (string - chunk) * cymbMaskStride << (string - chunk) * cymbMaskStride;
+
+	while(true)
+	{
+		while(mask != 0)
+		{
+			const unsigned int bit = stdc_trailing_zeros(mask);
+
+			const char* const character = chunk + bit / cymbMaskStride;
+			if(*character == '\0' || character[1] == '/')
+			{
+				return character;
+			}
+
+			mask ^= (((uint64_t)1 << cymbMaskStride) - 1) << bit;
+		}
+
+		chunk += cymbChunkSize;
+		mask = cymbStarMask(chunk);
+	}
+}
+
+#else
+
+const char* cymbFindNonSpace(const char* string)
+{
+	while(cymbIsSpace(*string))
+	{
+		++string;
+	}
+
+	return string;
+}
+
+const char* cymbFindCommentEnd(const char* string)
+{
+	while(*string != '\0' && (string[0] != '*' || string[1] != '/'))
+	{
+		++string;
+	}
+
+	return string;
+}
+
+#endif
+
 void cymbReaderSkipSpaces(CymbReader* const reader)
 {
+	if(reader->lazy)
+	{
+		reader->string = cymbFindNonSpace(reader->string);
+		return;
+	}
+
 	while(isspace((unsigned char)*reader->string))
 	{
 		cymbReaderPop(reader);
@@ -1,67 +1,169 @@
 #include "cymb/tree.h"
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 
 #include "cymb/memory.h"
 
 /*
- * Create a child node from the last node added and append it to the children list.
+ * Get a node of a tree.
  *
  * Parameters:
  * - tree: The tree.
- * - child: The last child in the list.
+ * - index: The index of the node.
+ *
+ * Returns:
+ * - The node, valid until the next node is added.
+ */
+static CymbNode* cymbGetNode(const CymbTree* const tree, const CymbNodeIndex index)
+{
+	return (CymbNode*)tree->nodes.data + index;
+}
+
+/*
+ * Get the index of a token of a tree.
+ *
+ * Parameters:
+ * - tree: The tree.
+ * - token: A token of the tree.
+ *
+ * Returns:
+ * - The index of the token.
+ */
+static uint32_t cymbGetTokenIndex(const CymbTree* const tree, const CymbToken* const token)
+{
+	return token - tree->tokens;
+}
+
+/*
+ * Add a node to a tree, making it the root.
+ *
+ * Parameters:
+ * - tree: The tree.
+ * - node: The node.
  *
  * Returns:
  * - CYMB_SUCCESS on success.
- * - CYMB_OUT_OF_MEMORY if the child could not be created.
+ * - CYMB_OUT_OF_MEMORY if the node could not be added.
  */
-static CymbResult cymbCreateChild(CymbTree* const tree, CymbNodeChild** const child)
+static CymbResult cymbAddNode(CymbTree* const tree, const CymbNode* const node)
 {
-	CymbNodeChild* const newChild = cymbArenaAllocate(tree->arena, sizeof(*newChild), alignof(typeof(*newChild)));
-	if(!newChild)
+	// Node 0 is reserved with the first node, so that 0 means no node.
+	const size_t count = tree->nodes.count == 0 ? 2 : 1;
+	if(tree->nodes.count > UINT32_MAX - count)
 	{
 		return CYMB_OUT_OF_MEMORY;
 	}
 
-	*newChild = (CymbNodeChild){
-		.node = tree->root
-	};
+	CymbNode* const nodes = cymbArrayPush(&tree->nodes, count);
+	if(!nodes)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
 
-	if(*child)
+	if(count == 2)
 	{
-		(*child)->next = newChild;
+		nodes[0] = (CymbNode){};
 	}
-	
-	*child = newChild;
+	nodes[count - 1] = *node;
+
+	tree->root = tree->nodes.count - 1;
+	++tree->nodeCount;
 
 	return CYMB_SUCCESS;
 }
 
 /*
- * Add a node to a tree.
+ * Gather the root of a tree as a child of the list being parsed.
  *
  * Parameters:
  * - tree: The tree.
- * - node: The node.
  *
  * Returns:
  * - CYMB_SUCCESS on success.
- * - CYMB_OUT_OF_MEMORY if the node could not be added.
+ * - CYMB_OUT_OF_MEMORY if the child could not be gathered.
  */
-static CymbResult cymbAddNode(CymbTree* const tree, const CymbNode* const node)
+static CymbResult cymbGatherChild(CymbTree* const tree)
+{
+	CymbNodeIndex* const child = cymbArrayPush(&tree->scratch, 1);
+	if(!child)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	*child = tree->root;
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Move the children gathered for a list to the children of a tree.
+ *
+ * Lists are gathered on a stack, so that nested lists can be parsed while gathering, and are moved once complete so that each is contiguous.
+ *
+ * Parameters:
+ * - tree: The tree.
+ * - start: The number of gathered children before the list.
+ * - span: The span to set to the list.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if the children could not be moved.
+ */
+static CymbResult cymbMoveChildren(CymbTree* const tree, const size_t start, CymbNodeSpan* const span)
 {
-	tree->root = cymbArenaAllocate(tree->arena, sizeof(*node), alignof(typeof(*node)));
-	if(!tree->root)
+	const size_t count = tree->scratch.count - start;
+	if(count == 0)
+	{
+		*span = (CymbNodeSpan){};
+		return CYMB_SUCCESS;
+	}
+
+	*span = (CymbNodeSpan){
+		.start = tree->children.count,
+		.count = count
+	};
+
+	CymbNodeIndex* const children = cymbArrayPush(&tree->children, count);
+	if(!children)
 	{
 		return CYMB_OUT_OF_MEMORY;
 	}
 
-	memcpy(tree->root, node, sizeof(*node));
+	memcpy(children, (const CymbNodeIndex*)tree->scratch.data + start, count * sizeof(*children));
+	tree->scratch.count = start;
 
 	return CYMB_SUCCESS;
 }
 
+/*
+ * Find the matching token of a parenthesis, bracket or brace in a list of tokens.
+ *
+ * Parameters:
+ * - tokens: The tokens.
+ * - token: A parenthesis, bracket or brace of the tokens.
+ *
+ * Returns:
+ * - The matching token if it is in the list.
+ * - nullptr otherwise.
+ */
+static CymbToken* cymbFindPartner(const CymbTokenList* const tokens, CymbToken* const token)
+{
+	if(token->partner == 0)
+	{
+		return nullptr;
+	}
+
+	if(token->type == CYMB_TOKEN_OPEN_PARENTHESIS || token->type == CYMB_TOKEN_OPEN_BRACKET || token->type == CYMB_TOKEN_OPEN_BRACE)
+	{
+		return token->partner < (size_t)(tokens->tokens + tokens->count - token) ? token + token->partner : nullptr;
+	}
+
+	return token->partner <= (size_t)(token - tokens->tokens) ? token - token->partner : nullptr;
+}
+
 CymbResult cymbSkipParentheses(const CymbTokenList* const tokens, const CymbDirection direction, size_t* const tokenIndex, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
@@ -70,33 +172,24 @@ CymbResult cymbSkipParentheses(const CymbTokenList* const tokens, const CymbDire
 	const CymbTokenType minusType = direction == CYMB_DIRECTION_FORWARD ? CYMB_TOKEN_CLOSE_PARENTHESIS : CYMB_TOKEN_OPEN_PARENTHESIS;
 
 	const size_t startIndex = *tokenIndex;
-	CymbTokenType type = tokens->tokens[startIndex].type;
+	CymbToken* const token = &tokens->tokens[startIndex];
 
-	if(type == minusType)
+	if(token->type == minusType)
 	{
 		goto error;
 	}
 
-	if(type != plusType)
+	if(token->type != plusType)
 	{
 		result = CYMB_NO_MATCH;
 		goto end;
 	}
 
-	size_t parenthesisCount = 1;
-	while(direction == CYMB_DIRECTION_FORWARD ? *tokenIndex < tokens->count - 1 : *tokenIndex > 0)
+	const CymbToken* const partner = cymbFindPartner(tokens, token);
+	if(partner)
 	{
-		*tokenIndex += direction;
-
-		type = tokens->tokens[*tokenIndex].type;
-
-		parenthesisCount += type == plusType;
-		parenthesisCount -= type == minusType;
-
-		if(parenthesisCount == 0)
-		{
-			goto end;
-		}
+		*tokenIndex = partner - tokens->tokens;
+		goto end;
 	}
 
 	error:
@@ -104,7 +197,7 @@ CymbResult cymbSkipParentheses(const CymbTokenList* const tokens, const CymbDire
 
 	const CymbDiagnostic diagnostic = {
 		.type = CYMB_UNMATCHED_PARENTHESIS,
-		.info = tokens->tokens[startIndex].info
+		.info = cymbTokenInfo(diagnostics, &tokens->tokens[startIndex])
 	};
 
 	const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -127,148 +220,133 @@ typedef enum CymbAssociativity
 } CymbAssociativity;
 
 /*
- * A mapping from a token to a binary operator.
+ * The binary operator of a token.
  *
  * Fields:
- * - token: The token.
  * - operator: The operator.
- * - precedence: The precedence of the operator.
+ * - precedence: The precedence of the operator, 0 if the token is not a binary operator.
  * - associativity: The associativity of the operator.
  */
 typedef struct CymbBinaryOperatorMapping
 {
-	
-	CymbTokenType token;
 	CymbBinaryOperator operator;
 	unsigned char precedence;
 	CymbAssociativity associativity;
 } CymbBinaryOperatorMapping;
 
-constexpr CymbBinaryOperatorMapping binaryOperators[] = {
-	{CYMB_TOKEN_STAR, CYMB_BINARY_OPERATOR_MULTIPLICATION, 11, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_SLASH, CYMB_BINARY_OPERATOR_DIVISION, 11, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_PERCENT, CYMB_BINARY_OPERATOR_REMAINDER, 11, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_PLUS, CYMB_BINARY_OPERATOR_ADDITION, 10, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_MINUS, CYMB_BINARY_OPERATOR_SUBTRACTION, 10, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_LEFT_SHIFT, CYMB_BINARY_OPERATOR_LESSFT_SHIFT, 9, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_RIGHT_SHIFT, CYMB_BINARY_OPERATOR_RIGHT_SHIFT, 9, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_LESS, CYMB_BINARY_OPERATOR_LESS, 8, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_LESS_EQUAL, CYMB_BINARY_OPERATOR_LESS_EQUAL, 8, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_GREATER, CYMB_BINARY_OPERATOR_GREATER, 8, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_GREATER_EQUAL, CYMB_BINARY_OPERATOR_GREATER_EQUAL, 8, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_EQUAL_EQUAL, CYMB_BINARY_OPERATOR_EQUAL, 7, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_NOT_EQUAL, CYMB_BINARY_OPERATOR_NOT_EQUAL, 7, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_AMPERSAND, CYMB_BINARY_OPERATOR_BITWISE_AND, 6, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_CARET, CYMB_BINARY_OPERATOR_BITWISE_EXCLUSIVE_OR, 5, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_BAR, CYMB_BINARY_OPERATOR_BITWISE_OR, 4, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_AMPERSAND_AMPERSAND, CYMB_BINARY_OPERATOR_LOGICAL_AND, 3, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_BAR_BAR, CYMB_BINARY_OPERATOR_LOGICAL_OR, 2, CYMB_LEFT_TO_RIGHT},
-	{CYMB_TOKEN_EQUAL, CYMB_BINARY_OPERATOR_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_PLUS_EQUAL, CYMB_BINARY_OPERATOR_ADDITION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_MINUS_EQUAL, CYMB_BINARY_OPERATOR_SUBTRACTION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_STAR_EQUAL, CYMB_BINARY_OPERATOR_MULTIPLICATION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_SLASH_EQUAL, CYMB_BINARY_OPERATOR_DIVISION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_PERCENT_EQUAL, CYMB_BINARY_OPERATOR_REMAINDER_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_LEFT_SHIFT_EQUAL, CYMB_BINARY_OPERATOR_LEFT_SHIFT_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_RIGHT_SHIFT_EQUAL, CYMB_BINARY_OPERATOR_RIGHT_SHIFT_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_AMPERSAND_EQUAL, CYMB_BINARY_OPERATOR_BITWISE_AND_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_CARET_EQUAL, CYMB_BINARY_OPERATOR_BITWISE_EXCLUSIVE_OR_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
-	{CYMB_TOKEN_BAR_EQUAL, CYMB_BINARY_OPERATOR_BITWISE_OR_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT}
+// Token types fit in an unsigned char, so that any token type indexes the operator tables.
+constexpr CymbBinaryOperatorMapping binaryOperators[UCHAR_MAX + 1] = {
+	[CYMB_TOKEN_STAR] = {CYMB_BINARY_OPERATOR_MULTIPLICATION, 11, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_SLASH] = {CYMB_BINARY_OPERATOR_DIVISION, 11, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_PERCENT] = {CYMB_BINARY_OPERATOR_REMAINDER, 11, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_PLUS] = {CYMB_BINARY_OPERATOR_ADDITION, 10, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_MINUS] = {CYMB_BINARY_OPERATOR_SUBTRACTION, 10, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_LEFT_SHIFT] = {CYMB_BINARY_OPERATOR_LESSFT_SHIFT, 9, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_RIGHT_SHIFT] = {CYMB_BINARY_OPERATOR_RIGHT_SHIFT, 9, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_LESS] = {CYMB_BINARY_OPERATOR_LESS, 8, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_LESS_EQUAL] = {CYMB_BINARY_OPERATOR_LESS_EQUAL, 8, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_GREATER] = {CYMB_BINARY_OPERATOR_GREATER, 8, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_GREATER_EQUAL] = {CYMB_BINARY_OPERATOR_GREATER_EQUAL, 8, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_EQUAL_EQUAL] = {CYMB_BINARY_OPERATOR_EQUAL, 7, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_NOT_EQUAL] = {CYMB_BINARY_OPERATOR_NOT_EQUAL, 7, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_AMPERSAND] = {CYMB_BINARY_OPERATOR_BITWISE_AND, 6, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_CARET] = {CYMB_BINARY_OPERATOR_BITWISE_EXCLUSIVE_OR, 5, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_BAR] = {CYMB_BINARY_OPERATOR_BITWISE_OR, 4, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_AMPERSAND_AMPERSAND] = {CYMB_BINARY_OPERATOR_LOGICAL_AND, 3, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_BAR_BAR] = {CYMB_BINARY_OPERATOR_LOGICAL_OR, 2, CYMB_LEFT_TO_RIGHT},
+	[CYMB_TOKEN_EQUAL] = {CYMB_BINARY_OPERATOR_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_PLUS_EQUAL] = {CYMB_BINARY_OPERATOR_ADDITION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_MINUS_EQUAL] = {CYMB_BINARY_OPERATOR_SUBTRACTION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_STAR_EQUAL] = {CYMB_BINARY_OPERATOR_MULTIPLICATION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_SLASH_EQUAL] = {CYMB_BINARY_OPERATOR_DIVISION_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_PERCENT_EQUAL] = {CYMB_BINARY_OPERATOR_REMAINDER_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_LEFT_SHIFT_EQUAL] = {CYMB_BINARY_OPERATOR_LEFT_SHIFT_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_RIGHT_SHIFT_EQUAL] = {CYMB_BINARY_OPERATOR_RIGHT_SHIFT_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_AMPERSAND_EQUAL] = {CYMB_BINARY_OPERATOR_BITWISE_AND_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_CARET_EQUAL] = {CYMB_BINARY_OPERATOR_BITWISE_EXCLUSIVE_OR_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT},
+	[CYMB_TOKEN_BAR_EQUAL] = {CYMB_BINARY_OPERATOR_BITWISE_OR_ASSIGNMENT, 1, CYMB_RIGHT_TO_LEFT}
 };
-constexpr size_t binaryOperatorCount = CYMB_LENGTH(binaryOperators);
-constexpr size_t binaryOperatorSize = sizeof(binaryOperators[0]);
-
-/*
- * Compare two binary operators.
- *
- * Parameters:
- * - tokenVoid: A token type.
- * - operatorVoid: A binary operator mapping.
- *
- * Returns:
- * - true if the operators are the same.
- * - false if they are different.
- */
-static int cymbCompareBinaryOperator(const void* const tokenVoid, const void* const operatorVoid)
-{
-	const CymbTokenType token = *(const CymbTokenType*)tokenVoid;
-	const CymbBinaryOperatorMapping* operator = operatorVoid;
-
-	return token != operator->token;
-}
 
 /*
- * A mapping from a token to a unary operator.
+ * The unary operator of a token.
  *
  * Fields:
- * - token: The token.
  * - operator: The operator.
+ * - isOperator: Flag indicating if the token is a unary operator.
  */
 typedef struct CymbUnaryOperatorMapping
 {
-	CymbTokenType token;
-
 	CymbUnaryOperator operator;
+	bool isOperator;
 } CymbUnaryOperatorMapping;
 
-constexpr CymbUnaryOperatorMapping unaryOperators[] = {
-	{CYMB_TOKEN_PLUS, CYMB_UNARY_OPERATOR_POSITIVE},
-	{CYMB_TOKEN_MINUS, CYMB_UNARY_OPERATOR_NEGATIVE},
-	{CYMB_TOKEN_PLUS_PLUS, CYMB_UNARY_OPERATOR_INCREMENT},
-	{CYMB_TOKEN_MINUS_MINUS, CYMB_UNARY_OPERATOR_DECREMENT},
-	{CYMB_TOKEN_TILDE, CYMB_UNARY_OPERATOR_BITWISE_NOT},
-	{CYMB_TOKEN_EXCLAMATION, CYMB_UNARY_OPERATOR_LOGICAL_NOT},
-	{CYMB_TOKEN_AMPERSAND, CYMB_UNARY_OPERATOR_ADDRESS},
-	{CYMB_TOKEN_STAR, CYMB_UNARY_OPERATOR_INDIRECTION}
+constexpr CymbUnaryOperatorMapping unaryOperators[UCHAR_MAX + 1] = {
+	[CYMB_TOKEN_PLUS] = {CYMB_UNARY_OPERATOR_POSITIVE, true},
+	[CYMB_TOKEN_MINUS] = {CYMB_UNARY_OPERATOR_NEGATIVE, true},
+	[CYMB_TOKEN_PLUS_PLUS] = {CYMB_UNARY_OPERATOR_INCREMENT, true},
+	[CYMB_TOKEN_MINUS_MINUS] = {CYMB_UNARY_OPERATOR_DECREMENT, true},
+	[CYMB_TOKEN_TILDE] = {CYMB_UNARY_OPERATOR_BITWISE_NOT, true},
+	[CYMB_TOKEN_EXCLAMATION] = {CYMB_UNARY_OPERATOR_LOGICAL_NOT, true},
+	[CYMB_TOKEN_AMPERSAND] = {CYMB_UNARY_OPERATOR_ADDRESS, true},
+	[CYMB_TOKEN_STAR] = {CYMB_UNARY_OPERATOR_INDIRECTION, true}
 };
-constexpr size_t unaryOperatorCount = CYMB_LENGTH(unaryOperators);
-constexpr size_t unaryOperatorSize = sizeof(unaryOperators[0]);
+
+// The operand of a unary operator binds tighter than any binary operator.
+constexpr unsigned char unaryPrecedence = 12;
 
 /*
- * Compare two unary operators.
- *
- * Parameters:
- * - tokenVoid: A token type.
- * - operatorVoid: A unary operator mapping.
- *
- * Returns:
- * - true if the operators are the same.
- * - false if they are different.
+ * A pending operator type.
  */
-static int cymbCompareUnaryOperator(const void* const tokenVoid, const void* const operatorVoid)
+typedef enum CymbPendingType
 {
-	const CymbTokenType token = *(const CymbTokenType*)tokenVoid;
-	const CymbUnaryOperatorMapping* operator = operatorVoid;
-
-	return token != operator->token;
-}
+	CYMB_PENDING_PARENTHESIS,
+	CYMB_PENDING_UNARY_OPERATOR,
+	CYMB_PENDING_BINARY_OPERATOR
+} CymbPendingType;
 
 /*
- * Parse a subexpression.
- *
- * Parameters:
- * - tree: The tree.
- * - tokens: The tokens.
- * - diagnostics: A list of diagnostics.
- * - minimumPrecedence: The minimum precedence to consider the subexpression finished.
- * - hadParenthesis: A flag indicating if seeing a closed parenthesis is valid.
+ * An operator waiting for its right operand.
  *
- * Returns:
- * - CYMB_SUCCESS on success.
- * - CYMB_INVALID if it is invalid.
- * - CYMB_OUT_OF_MEMORY if a node or diagnostic could not be added.
+ * Fields:
+ * - type: The pending operator type.
+ * - token: The index of the token of the operator.
+ * - unaryOperator: The operator if it is a unary operator.
+ * - binaryOperator: The operator if it is a binary operator.
+ * - leftNode: The left operand if it is a binary operator.
+ * - minimumPrecedence: The minimum precedence to restore once the operator is complete.
  */
-static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics, const unsigned char minimumPrecedence, const bool hadParenthesis)
+typedef struct CymbPendingOperator
+{
+	CymbPendingType type;
+	uint32_t token;
+
+	union
+	{
+		CymbUnaryOperator unaryOperator;
+		CymbBinaryOperator binaryOperator;
+	};
+	CymbNodeIndex leftNode;
+
+	unsigned char minimumPrecedence;
+} CymbPendingOperator;
+
+CymbResult cymbParseExpression(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
 
+	// Operators waiting for their right operand are stacked rather than recursed into, so that long expressions cannot overflow the call stack.
+	const size_t pendingStart = tree->operators.count;
+	unsigned char minimumPrecedence = 0;
+	size_t parenthesisDepth = 0;
+
+	operand:
 	if(tokens->count == 0)
 	{
 		result = CYMB_INVALID;
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_EXPRESSION,
-			.info = (tokens->tokens - 1)->info
+			.info = cymbTokenInfo(diagnostics, tokens->tokens - 1)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -279,170 +357,123 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 		goto end;
 	}
 
-	if(tokens->tokens[0].type == CYMB_TOKEN_OPEN_PARENTHESIS)
+	const CymbTokenType type = tokens->tokens[0].type;
+	if(type == CYMB_TOKEN_OPEN_PARENTHESIS || unaryOperators[type].isOperator)
 	{
-		const CymbToken* const parenthesisToken = tokens->tokens;
-
-		++tokens->tokens;
-		--tokens->count;
-
-		result = cymbParseSubexpression(tree, tokens, diagnostics, 0, true);
-		if(result != CYMB_SUCCESS)
+		CymbPendingOperator* const pending = cymbArrayPush(&tree->operators, 1);
+		if(!pending)
 		{
+			result = CYMB_OUT_OF_MEMORY;
 			goto end;
 		}
 
-		if(tokens->count == 0)
-		{
-			result = CYMB_INVALID;
-
-			const CymbDiagnostic diagnostic = {
-				.type = CYMB_UNMATCHED_PARENTHESIS,
-				.info = parenthesisToken->info
-			};
-			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
-			if(diagnosticResult != CYMB_SUCCESS)
-			{
-				result = diagnosticResult;
-			}
+		*pending = (CymbPendingOperator){
+			.type = type == CYMB_TOKEN_OPEN_PARENTHESIS ? CYMB_PENDING_PARENTHESIS : CYMB_PENDING_UNARY_OPERATOR,
+			.token = cymbGetTokenIndex(tree, &tokens->tokens[0]),
+			.unaryOperator = unaryOperators[type].operator,
+			.minimumPrecedence = minimumPrecedence
+		};
 
-			goto end;
+		if(type == CYMB_TOKEN_OPEN_PARENTHESIS)
+		{
+			minimumPrecedence = 0;
+			++parenthesisDepth;
+		}
+		else
+		{
+			minimumPrecedence = unaryPrecedence;
 		}
 
 		++tokens->tokens;
 		--tokens->count;
-	}
-	else
-	{
-		const CymbUnaryOperatorMapping* const operator = cymbFind(&tokens->tokens[0].type, unaryOperators, unaryOperatorCount, unaryOperatorSize, cymbCompareUnaryOperator);
-		if(operator)
-		{
-			CymbNode node = {
-				.type = CYMB_NODE_UNARY_OPERATOR,
-				.info = tokens->tokens[0].info,
-				.unaryOperatorNode = {
-					.operator = operator->operator
-				}
-			};
-
-			++tokens->tokens;
-			--tokens->count;
 
-			result = cymbParseSubexpression(tree, tokens, diagnostics, binaryOperators[0].precedence + 1, hadParenthesis);
-			if(result != CYMB_SUCCESS)
-			{
-				goto end;
-			}
+		goto operand;
+	}
 
-			node.unaryOperatorNode.node = tree->root;
+	if(type != CYMB_TOKEN_CONSTANT && type != CYMB_TOKEN_IDENTIFIER)
+	{
+		result = CYMB_INVALID;
 
-			result = cymbAddNode(tree, &node);
-			if(result != CYMB_SUCCESS)
-			{
-				goto end;
-			}
-		}
-		else
+		const CymbDiagnostic diagnostic = {
+			.type = CYMB_UNEXPECTED_TOKEN,
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
+		};
+		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+		if(diagnosticResult != CYMB_SUCCESS)
 		{
-			if(tokens->tokens[0].type != CYMB_TOKEN_CONSTANT && tokens->tokens[0].type != CYMB_TOKEN_IDENTIFIER)
-			{
-				result = CYMB_INVALID;
-
-				const CymbDiagnostic diagnostic = {
-					.type = CYMB_UNEXPECTED_TOKEN,
-					.info = tokens->tokens[0].info
-				};
-				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
-				if(diagnosticResult != CYMB_SUCCESS)
-				{
-					result = diagnosticResult;
-				}
-
-				goto end;
-			}
+			result = diagnosticResult;
+		}
 
-			CymbNode leftNode = {
-				.type = tokens->tokens[0].type == CYMB_TOKEN_CONSTANT ? CYMB_NODE_CONSTANT : CYMB_NODE_IDENTIFIER,
-				.info = tokens->tokens[0].info
-			};
+		goto end;
+	}
 
-			if(tokens->tokens[0].type == CYMB_TOKEN_CONSTANT)
-			{
-				leftNode.constantNode = tokens->tokens[0].constant;
-			}
+	CymbNode leftNode = {
+		.type = type == CYMB_TOKEN_CONSTANT ? CYMB_NODE_CONSTANT : CYMB_NODE_IDENTIFIER,
+		.token = cymbGetTokenIndex(tree, &tokens->tokens[0])
+	};
 
-			result = cymbAddNode(tree, &leftNode);
-			if(result != CYMB_SUCCESS)
-			{
-				goto end;
-			}
+	if(type == CYMB_TOKEN_CONSTANT)
+	{
+		leftNode.constantNode = tokens->constants[tokens->tokens[0].constant];
+	}
 
-			++tokens->tokens;
-			--tokens->count;
-		}
+	result = cymbAddNode(tree, &leftNode);
+	if(result != CYMB_SUCCESS)
+	{
+		goto end;
 	}
 
+	++tokens->tokens;
+	--tokens->count;
+
+	postfix:
 	while(tokens->count > 0)
 	{
 		if(tokens->tokens[0].type == CYMB_TOKEN_CLOSE_PARENTHESIS)
 		{
-			if(!hadParenthesis)
+			if(parenthesisDepth == 0)
 			{
 				result = CYMB_INVALID;
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_UNMATCHED_PARENTHESIS,
-					.info = tokens->tokens[0].info
+					.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
 				{
 					result = diagnosticResult;
 				}
+
+				goto end;
 			}
 
-			goto end;
+			goto reduce;
 		}
 
 		if(tokens->tokens[0].type == CYMB_TOKEN_OPEN_BRACKET)
 		{
-			const CymbDiagnosticInfo bracketInfo = tokens->tokens[0].info;
+			const CymbToken* const bracketToken = &tokens->tokens[0];
+			CymbToken* const token = cymbFindPartner(tokens, &tokens->tokens[0]);
 
 			++tokens->tokens;
 			--tokens->count;
 
 			CymbNode node = {
 				.type = CYMB_NODE_ARRAY_SUBSCRIPT,
-				.info = tree->root->info,
+				.token = cymbGetNode(tree, tree->root)->token,
 				.arraySubscriptNode = {
 					.name = tree->root
 				}
 			};
 
-			CymbToken* token = tokens->tokens;
-
-			size_t parenthesisCount = 0;
-			size_t bracketCount = 0;
-			while(
-				token < tokens->tokens + tokens->count &&
-				!(parenthesisCount == 0 && bracketCount == 0 && token->type == CYMB_TOKEN_CLOSE_BRACKET)
-			)
-			{
-				parenthesisCount += token->type == CYMB_TOKEN_OPEN_PARENTHESIS;
-				parenthesisCount -= token->type == CYMB_TOKEN_CLOSE_PARENTHESIS;
-
-				bracketCount += token->type == CYMB_TOKEN_OPEN_BRACKET;
-				bracketCount -= token->type == CYMB_TOKEN_CLOSE_BRACKET;
-
-				++token;
-			}
-			if(token == tokens->tokens + tokens->count)
+			if(!token)
 			{
 				result = CYMB_INVALID;
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_UNMATCHED_BRACKET,
-					.info = bracketInfo
+					.info = cymbTokenInfo(diagnostics, bracketToken)
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -461,7 +492,7 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_EXPECTED_EXPRESSION,
-					.info = token->info
+					.info = cymbTokenInfo(diagnostics, token)
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -472,10 +503,11 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 				goto end;
 			}
 
-			result = cymbParseSubexpression(tree, &(CymbTokenList){
+			result = cymbParseExpression(tree, &(CymbTokenList){
 				.tokens = tokens->tokens,
-				.count = argumentLength
-			}, diagnostics, 0, false);
+				.count = argumentLength,
+				.constants = tokens->constants
+			}, diagnostics);
 			if(result != CYMB_SUCCESS)
 			{
 				goto end;
@@ -497,44 +529,45 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 
 		if(tokens->tokens[0].type == CYMB_TOKEN_OPEN_PARENTHESIS)
 		{
-			const CymbDiagnosticInfo parenthesisInfo = tokens->tokens[0].info;
+			const CymbToken* const parenthesisToken = &tokens->tokens[0];
 
 			++tokens->tokens;
 			--tokens->count;
 
 			CymbNode node = {
 				.type = CYMB_NODE_FUNCTION_CALL,
-				.info = tree->root->info,
+				.token = cymbGetNode(tree, tree->root)->token,
 				.functionCallNode = {
 					.name = tree->root
 				}
 			};
 
-			CymbNodeChild* arguments = nullptr;
+			const size_t scratchStart = tree->scratch.count;
 
 			while(true)
 			{
+				// Nested parentheses are jumped over, so that each argument is scanned once.
 				CymbToken* token = tokens->tokens;
-
-				size_t parenthesisCount = 0;
 				while(
+					token &&
 					token < tokens->tokens + tokens->count &&
-					!(parenthesisCount == 0 && token->type == CYMB_TOKEN_COMMA) &&
-					!(parenthesisCount == 0 && token->type == CYMB_TOKEN_CLOSE_PARENTHESIS)
+					token->type != CYMB_TOKEN_COMMA &&
+					token->type != CYMB_TOKEN_CLOSE_PARENTHESIS
 				)
 				{
-					parenthesisCount += token->type == CYMB_TOKEN_OPEN_PARENTHESIS;
-					parenthesisCount -= token->type == CYMB_TOKEN_CLOSE_PARENTHESIS;
-
-					++token;
+					token = token->type == CYMB_TOKEN_OPEN_PARENTHESIS ? cymbFindPartner(tokens, token) : token;
+					if(token)
+					{
+						++token;
+					}
 				}
-				if(token == tokens->tokens + tokens->count)
+				if(!token || token == tokens->tokens + tokens->count)
 				{
 					result = CYMB_INVALID;
 
 					const CymbDiagnostic diagnostic = {
 						.type = CYMB_UNMATCHED_PARENTHESIS,
-						.info = parenthesisInfo
+						.info = cymbTokenInfo(diagnostics, parenthesisToken)
 					};
 					const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 					if(diagnosticResult != CYMB_SUCCESS)
@@ -549,7 +582,7 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 
 				if(argumentLength == 0)
 				{
-					if(!node.functionCallNode.arguments)
+					if(tree->scratch.count == scratchStart)
 					{
 						++tokens->tokens;
 						--tokens->count;
@@ -561,7 +594,7 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 
 					const CymbDiagnostic diagnostic = {
 						.type = CYMB_EXPECTED_EXPRESSION,
-						.info = token->info
+						.info = cymbTokenInfo(diagnostics, token)
 					};
 					const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 					if(diagnosticResult != CYMB_SUCCESS)
@@ -572,26 +605,22 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 					goto end;
 				}
 
-				result = cymbParseSubexpression(tree, &(CymbTokenList){
+				result = cymbParseExpression(tree, &(CymbTokenList){
 					.tokens = tokens->tokens,
-					.count = argumentLength
-				}, diagnostics, 0, false);
+					.count = argumentLength,
+					.constants = tokens->constants
+				}, diagnostics);
 				if(result != CYMB_SUCCESS)
 				{
 					goto end;
 				}
 
-				result = cymbCreateChild(tree, &arguments);
+				result = cymbGatherChild(tree);
 				if(result != CYMB_SUCCESS)
 				{
 					goto end;
 				}
 
-				if(!node.functionCallNode.arguments)
-				{
-					node.functionCallNode.arguments = arguments;
-				}
-
 				tokens->tokens = token + 1;
 				tokens->count -= argumentLength + 1;
 
@@ -601,6 +630,12 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 				}
 			}
 
+			result = cymbMoveChildren(tree, scratchStart, &node.functionCallNode.arguments);
+			if(result != CYMB_SUCCESS)
+			{
+				goto end;
+			}
+
 			result = cymbAddNode(tree, &node);
 			if(result != CYMB_SUCCESS)
 			{
@@ -618,7 +653,7 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_EXPECTED_IDENTIFIER,
-					.info = tokens->tokens[0].info
+					.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 				};
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 				if(diagnosticResult != CYMB_SUCCESS)
@@ -629,11 +664,11 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 				goto end;
 			}
 
-			CymbNode* const name = tree->root;
+			const CymbNodeIndex name = tree->root;
 
 			CymbNode node = {
 				.type = CYMB_NODE_IDENTIFIER,
-				.info = tokens->tokens[1].info
+				.token = cymbGetTokenIndex(tree, &tokens->tokens[1])
 			};
 			result = cymbAddNode(tree, &node);
 			if(result != CYMB_SUCCESS)
@@ -648,7 +683,7 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 					.name = name,
 					.member = tree->root
 				},
-				.info = tokens->tokens[0].info
+				.token = cymbGetTokenIndex(tree, &tokens->tokens[0])
 			};
 			result = cymbAddNode(tree, &node);
 			if(result != CYMB_SUCCESS)
@@ -670,7 +705,7 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 					.operator = tokens->tokens[0].type == CYMB_TOKEN_PLUS_PLUS ? CYMB_POSTFIX_OPERATOR_INCREMENT : CYMB_POSTFIX_OPERATOR_DECREMENT,
 					.node = tree->root
 				},
-				.info = tokens->tokens[0].info
+				.token = cymbGetTokenIndex(tree, &tokens->tokens[0])
 			};
 
 			result = cymbAddNode(tree, &node);
@@ -685,14 +720,14 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 			continue;
 		}
 
-		const CymbBinaryOperatorMapping* const operator = cymbFind(&tokens->tokens[0].type, binaryOperators, binaryOperatorCount, binaryOperatorSize, cymbCompareBinaryOperator);
-		if(!operator)
+		const CymbBinaryOperatorMapping* const operator = &binaryOperators[tokens->tokens[0].type];
+		if(operator->precedence == 0)
 		{
 			result = CYMB_INVALID;
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_UNEXPECTED_TOKEN,
-				.info = tokens->tokens[0].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -705,66 +740,144 @@ static CymbResult cymbParseSubexpression(CymbTree* const tree, CymbTokenList* co
 
 		if(operator->precedence < minimumPrecedence || (operator->associativity == CYMB_LEFT_TO_RIGHT && operator->precedence == minimumPrecedence))
 		{
+			goto reduce;
+		}
+
+		CymbPendingOperator* const pending = cymbArrayPush(&tree->operators, 1);
+		if(!pending)
+		{
+			result = CYMB_OUT_OF_MEMORY;
 			goto end;
 		}
 
-		CymbNode operatorNode = {
-			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tokens->tokens[0].info,
-			.binaryOperatorNode = {
-				.operator = operator->operator,
-				.leftNode = tree->root
-			}
+		*pending = (CymbPendingOperator){
+			.type = CYMB_PENDING_BINARY_OPERATOR,
+			.token = cymbGetTokenIndex(tree, &tokens->tokens[0]),
+			.binaryOperator = operator->operator,
+			.leftNode = tree->root,
+			.minimumPrecedence = minimumPrecedence
 		};
 
+		minimumPrecedence = operator->precedence;
+
 		++tokens->tokens;
 		--tokens->count;
 
-		result = cymbParseSubexpression(tree, tokens, diagnostics, operator->precedence, hadParenthesis);
-		if(result != CYMB_SUCCESS)
-		{
-			goto end;
-		}
-
-		operatorNode.binaryOperatorNode.rightNode = tree->root;
-
-		result = cymbAddNode(tree, &operatorNode);
-		if(result != CYMB_SUCCESS)
-		{
-			goto end;
-		}
+		goto operand;
 	}
 
-	end:
-	return result;
-}
-
-CymbResult cymbParseExpression(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
-{
-	return cymbParseSubexpression(tree, tokens, diagnostics, 0, false);
-}
+	// The innermost pending operator is complete.
+	reduce:
+	if(tree->operators.count == pendingStart)
+	{
+		goto end;
+	}
 
-CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
-{
-	CymbResult result = CYMB_SUCCESS;
+	--tree->operators.count;
+	const CymbPendingOperator pending = ((const CymbPendingOperator*)tree->operators.data)[tree->operators.count];
+	minimumPrecedence = pending.minimumPrecedence;
 
-	for(size_t pointerIndex = tokens->count - 1; pointerIndex > 0 && tokens->count - pointerIndex <= 3; --pointerIndex)
+	switch(pending.type)
 	{
-		if(tokens->tokens[pointerIndex].type == CYMB_TOKEN_STAR)
+		case CYMB_PENDING_PARENTHESIS:
 		{
-			CymbPointerNode pointer = {};
+			--parenthesisDepth;
 
-			for(size_t qualifierIndex = pointerIndex + 1; qualifierIndex < tokens->count; ++qualifierIndex)
+			if(tokens->count == 0)
 			{
-				if(tokens->tokens[qualifierIndex].type == CYMB_TOKEN_CONST)
-				{
-					if(pointer.isConst)
+				result = CYMB_INVALID;
+
+				const CymbDiagnostic diagnostic = {
+					.type = CYMB_UNMATCHED_PARENTHESIS,
+					.info = cymbTokenInfo(diagnostics, &tree->tokens[pending.token])
+				};
+				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
+				if(diagnosticResult != CYMB_SUCCESS)
+				{
+					result = diagnosticResult;
+				}
+
+				goto end;
+			}
+
+			++tokens->tokens;
+			--tokens->count;
+
+			break;
+		}
+
+		case CYMB_PENDING_UNARY_OPERATOR:
+		{
+			const CymbNode node = {
+				.type = CYMB_NODE_UNARY_OPERATOR,
+				.token = pending.token,
+				.unaryOperatorNode = {
+					.operator = pending.unaryOperator,
+					.node = tree->root
+				}
+			};
+			result = cymbAddNode(tree, &node);
+			if(result != CYMB_SUCCESS)
+			{
+				goto end;
+			}
+
+			break;
+		}
+
+		case CYMB_PENDING_BINARY_OPERATOR:
+		{
+			const CymbNode node = {
+				.type = CYMB_NODE_BINARY_OPERATOR,
+				.token = pending.token,
+				.binaryOperatorNode = {
+					.operator = pending.binaryOperator,
+					.leftNode = pending.leftNode,
+					.rightNode = tree->root
+				}
+			};
+			result = cymbAddNode(tree, &node);
+			if(result != CYMB_SUCCESS)
+			{
+				goto end;
+			}
+
+			break;
+		}
+
+		default:
+			unreachable();
+	}
+
+	goto postfix;
+
+	end:
+	tree->operators.count = pendingStart;
+
+	return result;
+}
+
+CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
+{
+	CymbResult result = CYMB_SUCCESS;
+
+	for(size_t pointerIndex = tokens->count - 1; pointerIndex > 0 && tokens->count - pointerIndex <= 3; --pointerIndex)
+	{
+		if(tokens->tokens[pointerIndex].type == CYMB_TOKEN_STAR)
+		{
+			CymbPointerNode pointer = {};
+
+			for(size_t qualifierIndex = pointerIndex + 1; qualifierIndex < tokens->count; ++qualifierIndex)
+			{
+				if(tokens->tokens[qualifierIndex].type == CYMB_TOKEN_CONST)
+				{
+					if(pointer.isConst)
 					{
 						result = CYMB_INVALID;
 
 						const CymbDiagnostic diagnostic = {
 							.type = CYMB_MULTIPLE_CONST,
-							.info = tokens->tokens[qualifierIndex].info
+							.info = cymbTokenInfo(diagnostics, &tokens->tokens[qualifierIndex])
 						};
 
 						const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -787,7 +900,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 						const CymbDiagnostic diagnostic = {
 							.type = CYMB_MULTIPLE_RESTRICT,
-							.info = tokens->tokens[qualifierIndex].info
+							.info = cymbTokenInfo(diagnostics, &tokens->tokens[qualifierIndex])
 						};
 
 						const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -808,7 +921,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 					const CymbDiagnostic diagnostic = {
 						.type = CYMB_UNEXPECTED_TOKEN,
-						.info = tokens->tokens[qualifierIndex].info
+						.info = cymbTokenInfo(diagnostics, &tokens->tokens[qualifierIndex])
 					};
 
 					const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -823,7 +936,8 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 			result = cymbParseType(tree, &(CymbTokenList){
 				.tokens = tokens->tokens,
-				.count = pointerIndex
+				.count = pointerIndex,
+				.constants = tokens->constants
 			}, diagnostics);
 			if(result != CYMB_SUCCESS)
 			{
@@ -835,7 +949,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 			const CymbNode node = {
 				.type = CYMB_NODE_POINTER,
 				.pointerNode = pointer,
-				.info = tokens->tokens[pointerIndex].info
+				.token = cymbGetTokenIndex(tree, &tokens->tokens[pointerIndex])
 			};
 			result = cymbAddNode(tree, &node);
 
@@ -844,7 +958,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 	}
 
 	CymbTypeNode type = {};
-	CymbDiagnosticInfo info;
+	const CymbToken* token;
 
 	while(tokens->tokens[0].type == CYMB_TOKEN_STATIC || tokens->tokens[0].type == CYMB_TOKEN_CONST)
 	{
@@ -856,7 +970,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 				const CymbDiagnostic diagnostic = {
 					.type = CYMB_MULTIPLE_STATIC,
-					.info = tokens->tokens[0].info
+					.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 				};
 
 				const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -879,7 +993,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 					const CymbDiagnostic diagnostic = {
 						.type = CYMB_MULTIPLE_CONST,
-						.info = tokens->tokens[0].info
+						.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 					};
 
 					const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -903,7 +1017,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_MISSING_TYPE,
-				.info = (tokens->tokens - 1)->info
+				.info = cymbTokenInfo(diagnostics, tokens->tokens - 1)
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -923,7 +1037,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_MULTIPLE_CONST,
-				.info = tokens->tokens[tokens->count - 1].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[tokens->count - 1])
 			};
 
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
@@ -945,7 +1059,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_MISSING_TYPE,
-				.info = tokens->tokens[0].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -965,7 +1079,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_INVALID_TYPE,
-				.info = tokens->tokens[1].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[1])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -983,7 +1097,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 		)
 		{
 			type.type = CYMB_TYPE_UNSIGNED_LONG_LONG;
-			info = tokens->tokens[1 + (tokens->tokens[2].type == CYMB_TOKEN_LONG)].info;
+			token = &tokens->tokens[1 + (tokens->tokens[2].type == CYMB_TOKEN_LONG)];
 			goto append;
 		}
 
@@ -994,7 +1108,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 		)
 		{
 			type.type = CYMB_TYPE_LONG_LONG;
-			info = tokens->tokens[1 + (tokens->tokens[2].type == CYMB_TOKEN_LONG)].info;
+			token = &tokens->tokens[1 + (tokens->tokens[2].type == CYMB_TOKEN_LONG)];
 			goto append;
 		}
 
@@ -1002,7 +1116,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_INVALID_TYPE,
-			.info = tokens->tokens[1].info
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[1])
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1018,7 +1132,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 		if(tokens->tokens[0].type == CYMB_TOKEN_LONG && tokens->tokens[1].type == CYMB_TOKEN_LONG)
 		{
 			type.type = CYMB_TYPE_LONG_LONG;
-			info = tokens->tokens[1].info;
+			token = &tokens->tokens[1];
 			goto append;
 		}
 
@@ -1048,7 +1162,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 					const CymbDiagnostic diagnostic = {
 						.type = CYMB_INVALID_TYPE,
-						.info = tokens->tokens[typeIndex].info
+						.info = cymbTokenInfo(diagnostics, &tokens->tokens[typeIndex])
 					};
 					const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 					if(diagnosticResult != CYMB_SUCCESS)
@@ -1059,7 +1173,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 					goto end;
 			}
 
-			info = tokens->tokens[typeIndex].info;
+			token = &tokens->tokens[typeIndex];
 
 			goto append;
 		}
@@ -1090,7 +1204,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 					const CymbDiagnostic diagnostic = {
 						.type = CYMB_INVALID_TYPE,
-						.info = tokens->tokens[typeIndex].info
+						.info = cymbTokenInfo(diagnostics, &tokens->tokens[typeIndex])
 					};
 					const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 					if(diagnosticResult != CYMB_SUCCESS)
@@ -1101,7 +1215,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 					goto end;
 			}
 
-			info = tokens->tokens[typeIndex].info;
+			token = &tokens->tokens[typeIndex];
 
 			goto append;
 		}
@@ -1110,7 +1224,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_INVALID_TYPE,
-			.info = tokens->tokens[1].info
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[1])
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1127,7 +1241,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_INVALID_TYPE,
-			.info = tokens->tokens[0].info
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1178,7 +1292,7 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_INVALID_TYPE,
-				.info = tokens->tokens[0].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -1189,13 +1303,13 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 			goto end;
 	}
 
-	info = tokens->tokens[0].info;
+	token = &tokens->tokens[0];
 
 	append:
 	const CymbNode node = {
 		.type = CYMB_NODE_TYPE,
 		.typeNode = type,
-		.info = info
+		.token = cymbGetTokenIndex(tree, token)
 	};
 	result = cymbAddNode(tree, &node);
 
@@ -1204,12 +1318,11 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
 }
 
 /*
- * Parse statement block.
+ * Parse statement block, gathering its statements as children.
  *
  * Parameters:
  * - tree: A tree.
  * - tokens: The tokens to parse.
- * - children: The child nodes of the block.
  * - diagnostics: A list of diagnostics.
  *
  * Returns:
@@ -1217,13 +1330,10 @@ CymbResult cymbParseType(CymbTree* const tree, CymbTokenList* const tokens, Cymb
  * - CYMB_INVALID if it is invalid.
  * - CYMB_OUT_OF_MEMORY if an allocation failed.
  */
-static CymbResult cymbParseBlock(CymbTree* const tree, CymbTokenList* const tokens, CymbNodeChild** const children, CymbDiagnosticList* const diagnostics)
+static CymbResult cymbParseBlock(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
 {
 	CymbResult result = CYMB_SUCCESS;
 
-	*children = nullptr;
-	CymbNodeChild* childrenList = nullptr;
-
 	// Single statement.
 	if(tokens->tokens->type != CYMB_TOKEN_OPEN_BRACE)
 	{
@@ -1233,33 +1343,20 @@ static CymbResult cymbParseBlock(CymbTree* const tree, CymbTokenList* const toke
 			goto end;
 		}
 
-		result = cymbCreateChild(tree, children);
+		result = cymbGatherChild(tree);
 
 		goto end;
 	}
 
 	// Block.
-	size_t braceCount = 1;
-	CymbToken* endBrace = tokens->tokens + 1;
-	while(endBrace < tokens->tokens + tokens->count)
-	{
-		braceCount += endBrace->type == CYMB_TOKEN_OPEN_BRACE;
-		braceCount -= endBrace->type == CYMB_TOKEN_CLOSE_BRACE;
-
-		if(braceCount == 0)
-		{
-			break;
-		}
-
-		++endBrace;
-	}
-	if(endBrace == tokens->tokens + tokens->count)
+	CymbToken* const endBrace = cymbFindPartner(tokens, tokens->tokens);
+	if(!endBrace)
 	{
 		result = CYMB_INVALID;
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_UNMATCHED_BRACE,
-			.info = tokens->tokens[0].info
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1273,7 +1370,8 @@ static CymbResult cymbParseBlock(CymbTree* const tree, CymbTokenList* const toke
 	const size_t blockSize = endBrace - tokens->tokens - 1;
 	CymbTokenList blockTokens = {
 		.tokens = tokens->tokens + 1,
-		.count = blockSize
+		.count = blockSize,
+		.constants = tokens->constants
 	};
 
 	while(blockTokens.count > 0)
@@ -1284,16 +1382,11 @@ static CymbResult cymbParseBlock(CymbTree* const tree, CymbTokenList* const toke
 			goto end;
 		}
 
-		result = cymbCreateChild(tree, &childrenList);
+		result = cymbGatherChild(tree);
 		if(result != CYMB_SUCCESS)
 		{
 			goto end;
 		}
-
-		if(!*children)
-		{
-			*children = childrenList;
-		}
 	}
 
 	tokens->tokens = endBrace + 1;
@@ -1345,7 +1438,7 @@ static CymbResult cymbParseDeclaration(CymbTree* const tree, CymbTokenList* cons
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_EXPRESSION,
-			.info = equalToken->info
+			.info = cymbTokenInfo(diagnostics, equalToken)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1362,7 +1455,7 @@ static CymbResult cymbParseDeclaration(CymbTree* const tree, CymbTokenList* cons
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_INVALID_DECLARATION,
-			.info = equalToken->info
+			.info = cymbTokenInfo(diagnostics, equalToken)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1380,7 +1473,7 @@ static CymbResult cymbParseDeclaration(CymbTree* const tree, CymbTokenList* cons
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_INVALID_DECLARATION,
-			.info = identifierToken->info
+			.info = cymbTokenInfo(diagnostics, identifierToken)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1407,7 +1500,7 @@ static CymbResult cymbParseDeclaration(CymbTree* const tree, CymbTokenList* cons
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_UNEXPECTED_TOKEN,
-				.info = typeToken->info
+				.info = cymbTokenInfo(diagnostics, typeToken)
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -1421,30 +1514,32 @@ static CymbResult cymbParseDeclaration(CymbTree* const tree, CymbTokenList* cons
 
 	result = cymbParseType(tree, &(CymbTokenList){
 		.tokens = tokens->tokens,
-		.count = equalToken - tokens->tokens - 1
+		.count = equalToken - tokens->tokens - 1,
+		.constants = tokens->constants
 	}, diagnostics);
 	if(result != CYMB_SUCCESS)
 	{
 		goto end;
 	}
-	CymbNode* const typeNode = tree->root;
+	const CymbNodeIndex typeNode = tree->root;
 
 	const CymbNode identifierNode = {
 		.type = CYMB_NODE_IDENTIFIER,
-		.info = identifierToken->info
+		.token = cymbGetTokenIndex(tree, identifierToken)
 	};
 	result = cymbAddNode(tree, &identifierNode);
 	if(result != CYMB_SUCCESS)
 	{
 		goto end;
 	}
-	CymbNode* const identifierNodePointer = tree->root;
+	const CymbNodeIndex identifierNodeIndex = tree->root;
 
 	if(hasInitializer)
 	{
 		result = cymbParseExpression(tree, &(CymbTokenList){
 			.tokens = equalToken + 1,
-			.count = tokens->tokens + tokens->count - equalToken - 1
+			.count = tokens->tokens + tokens->count - equalToken - 1,
+			.constants = tokens->constants
 		}, diagnostics);
 		if(result != CYMB_SUCCESS)
 		{
@@ -1455,11 +1550,11 @@ static CymbResult cymbParseDeclaration(CymbTree* const tree, CymbTokenList* cons
 	const CymbNode node = {
 		.type = CYMB_NODE_DECLARATION,
 		.declarationNode = {
-			.identifier = identifierNodePointer,
+			.identifier = identifierNodeIndex,
 			.type = typeNode,
-			.initializer = hasInitializer ? tree->root : nullptr
+			.initializer = hasInitializer ? tree->root : 0
 		},
-		.info = identifierToken->info
+		.token = cymbGetTokenIndex(tree, identifierToken)
 	};
 	result = cymbAddNode(tree, &node);
 
@@ -1475,7 +1570,7 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 	{
 		CymbNode node = {
 			.type = CYMB_NODE_WHILE,
-			.info = tokens->tokens[0].info
+			.token = cymbGetTokenIndex(tree, &tokens->tokens[0])
 		};
 
 		++tokens->tokens;
@@ -1487,7 +1582,7 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_EXPECTED_PARENTHESIS,
-				.info = (tokens->tokens - 1)->info
+				.info = cymbTokenInfo(diagnostics, tokens->tokens - 1)
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -1510,7 +1605,7 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_EXPECTED_EXPRESSION,
-				.info = tokens->tokens[0].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -1523,7 +1618,8 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 		result = cymbParseExpression(tree, &(CymbTokenList){
 			.tokens = tokens->tokens + 1,
-			.count = endTokenIndex - 1
+			.count = endTokenIndex - 1,
+			.constants = tokens->constants
 		}, diagnostics);
 		if(result != CYMB_SUCCESS)
 		{
@@ -1535,7 +1631,15 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 		tokens->tokens += endTokenIndex + 1;
 		tokens->count -= endTokenIndex + 1;
 
-		result = cymbParseBlock(tree, tokens, &node.whileNode.body, diagnostics);
+		const size_t scratchStart = tree->scratch.count;
+
+		result = cymbParseBlock(tree, tokens, diagnostics);
+		if(result != CYMB_SUCCESS)
+		{
+			goto end;
+		}
+
+		result = cymbMoveChildren(tree, scratchStart, &node.whileNode.body);
 		if(result != CYMB_SUCCESS)
 		{
 			goto end;
@@ -1567,7 +1671,7 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_SEMICOLON,
-			.info = (endToken - 1)->info
+			.info = cymbTokenInfo(diagnostics, endToken - 1)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1586,7 +1690,8 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 		{
 			result = cymbParseExpression(tree, &(CymbTokenList){
 				.tokens = tokens->tokens + 1,
-				.count = endToken - tokens->tokens - 1
+				.count = endToken - tokens->tokens - 1,
+				.constants = tokens->constants
 			}, diagnostics);
 			if(result != CYMB_SUCCESS)
 			{
@@ -1596,8 +1701,8 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbNode node = {
 			.type = CYMB_NODE_RETURN,
-			.returnNode = empty ? nullptr : tree->root,
-			.info = tokens->tokens[0].info
+			.returnNode = empty ? 0 : tree->root,
+			.token = cymbGetTokenIndex(tree, &tokens->tokens[0])
 		};
 		result = cymbAddNode(tree, &node);
 		if(result != CYMB_SUCCESS)
@@ -1610,7 +1715,8 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 	result = cymbParseDeclaration(tree, &(CymbTokenList){
 		.tokens = tokens->tokens,
-		.count = endToken - tokens->tokens
+		.count = endToken - tokens->tokens,
+		.constants = tokens->constants
 	}, diagnostics);
 	if(result == CYMB_SUCCESS)
 	{
@@ -1623,7 +1729,8 @@ CymbResult cymbParseStatement(CymbTree* const tree, CymbTokenList* const tokens,
 
 	result = cymbParseExpression(tree, &(CymbTokenList){
 		.tokens = tokens->tokens,
-		.count = endToken - tokens->tokens
+		.count = endToken - tokens->tokens,
+		.constants = tokens->constants
 	}, diagnostics);
 	if(result != CYMB_SUCCESS)
 	{
@@ -1650,8 +1757,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 		.type = CYMB_NODE_FUNCTION
 	};
 
-	CymbNodeChild* parameterTypes = nullptr;
-	CymbNodeChild* parameters = nullptr;
+	const size_t scratchStart = tree->scratch.count;
 
 	// Find function name.
 	const CymbToken* name = tokens->tokens;
@@ -1669,7 +1775,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_FUNCTION,
-			.info = tokens->tokens[0].info
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1687,7 +1793,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_FUNCTION,
-			.info = tokens->tokens[0].info
+			.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1703,7 +1809,8 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 	result = cymbParseType(tree, &(CymbTokenList){
 		.tokens = tokens->tokens,
-		.count = typeCount
+		.count = typeCount,
+		.constants = tokens->constants
 	}, diagnostics);
 	if(result != CYMB_SUCCESS)
 	{
@@ -1711,7 +1818,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 	}
 
 	typeNode.functionTypeNode.returnType = tree->root;
-	typeNode.info = typeNode.functionTypeNode.returnType->info;
+	typeNode.token = cymbGetNode(tree, tree->root)->token;
 
 	// Parse parameters.
 	const size_t parametersOffset = typeCount + 2;
@@ -1723,7 +1830,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_UNMATCHED_PARENTHESIS,
-			.info = (tokens->tokens - 1)->info
+			.info = cymbTokenInfo(diagnostics, tokens->tokens - 1)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1757,7 +1864,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_EXPECTED_PARAMETER,
-				.info = tokens->tokens[0].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -1775,7 +1882,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 			const CymbDiagnostic diagnostic = {
 				.type = CYMB_EXPECTED_PARAMETER,
-				.info = tokens->tokens[0].info
+				.info = cymbTokenInfo(diagnostics, &tokens->tokens[0])
 			};
 			const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 			if(diagnosticResult != CYMB_SUCCESS)
@@ -1789,27 +1896,24 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 		const size_t parameterTypeCount = parameterName - tokens->tokens;
 		result = cymbParseType(tree, &(CymbTokenList){
 			.tokens = tokens->tokens,
-			.count = parameterTypeCount
+			.count = parameterTypeCount,
+			.constants = tokens->constants
 		}, diagnostics);
 		if(result != CYMB_SUCCESS)
 		{
 			goto end;
 		}
 
-		result = cymbCreateChild(tree, &parameterTypes);
+		result = cymbGatherChild(tree);
 		if(result != CYMB_SUCCESS)
 		{
 			goto end;
 		}
 
-		if(!typeNode.functionTypeNode.parameterTypes)
-		{
-			typeNode.functionTypeNode.parameterTypes = parameterTypes;
-		}
-
+		// The name is added right after its type, so that it can be found from it.
 		const CymbNode parameterNameNode = {
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = parameterName->info
+			.token = cymbGetTokenIndex(tree, parameterName)
 		};
 		result = cymbAddNode(tree, &parameterNameNode);
 		if(result != CYMB_SUCCESS)
@@ -1817,17 +1921,6 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 			goto end;
 		}
 
-		result = cymbCreateChild(tree, &parameters);
-		if(result != CYMB_SUCCESS)
-		{
-			goto end;
-		}
-
-		if(!node.functionNode.parameters)
-		{
-			node.functionNode.parameters = parameters;
-		}
-
 		const size_t parameterOffset = parameterTypeCount + 1 + ((parameterName + 1)->type == CYMB_TOKEN_COMMA);
 		tokens->count -= parameterOffset;
 		tokens->tokens += parameterOffset;
@@ -1839,7 +1932,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_FUNCTION,
-			.info = (tokens->tokens - 1)->info
+			.info = cymbTokenInfo(diagnostics, tokens->tokens - 1)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1850,6 +1943,29 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 		goto end;
 	}
 
+	result = cymbMoveChildren(tree, scratchStart, &typeNode.functionTypeNode.parameterTypes);
+	if(result != CYMB_SUCCESS)
+	{
+		goto end;
+	}
+
+	const CymbNodeSpan parameterTypes = typeNode.functionTypeNode.parameterTypes;
+	if(parameterTypes.count > 0)
+	{
+		CymbNodeIndex* const parameters = cymbArrayPush(&tree->scratch, parameterTypes.count);
+		if(!parameters)
+		{
+			result = CYMB_OUT_OF_MEMORY;
+			goto end;
+		}
+
+		const CymbNodeIndex* const types = (const CymbNodeIndex*)tree->children.data + parameterTypes.start;
+		for(uint32_t parameterIndex = 0; parameterIndex < parameterTypes.count; ++parameterIndex)
+		{
+			parameters[parameterIndex] = types[parameterIndex] + 1;
+		}
+	}
+
 	result = cymbAddNode(tree, &typeNode);
 	if(result != CYMB_SUCCESS)
 	{
@@ -1859,7 +1975,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 	const CymbNode nameNode = {
 		.type = CYMB_NODE_IDENTIFIER,
-		.info = name->info
+		.token = cymbGetTokenIndex(tree, name)
 	};
 	result = cymbAddNode(tree, &nameNode);
 	if(result != CYMB_SUCCESS)
@@ -1867,7 +1983,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 		goto end;
 	}
 	node.functionNode.name = tree->root;
-	node.info = node.functionNode.name->info;
+	node.token = nameNode.token;
 
 	++tokens->tokens;
 	--tokens->count;
@@ -1879,7 +1995,7 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 
 		const CymbDiagnostic diagnostic = {
 			.type = CYMB_EXPECTED_FUNCTION,
-			.info = (tokens->tokens - 1)->info
+			.info = cymbTokenInfo(diagnostics, tokens->tokens - 1)
 		};
 		const CymbResult diagnosticResult = cymbDiagnosticAdd(diagnostics, &diagnostic);
 		if(diagnosticResult != CYMB_SUCCESS)
@@ -1890,7 +2006,13 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 		goto end;
 	}
 
-	result = cymbParseBlock(tree, tokens, &node.functionNode.statements, diagnostics);
+	result = cymbParseBlock(tree, tokens, diagnostics);
+	if(result != CYMB_SUCCESS)
+	{
+		goto end;
+	}
+
+	result = cymbMoveChildren(tree, scratchStart, &node.functionNode.children);
 	if(result != CYMB_SUCCESS)
 	{
 		goto end;
@@ -1902,56 +2024,98 @@ CymbResult cymbParseFunction(CymbTree* const tree, CymbTokenList* const tokens,
 	return result;
 }
 
-CymbResult cymbParseProgram(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
+/*
+ * Parse functions until the tokens are exhausted, gathering each as a child of the list being parsed.
+ *
+ * Parameters:
+ * - tree: A tree.
+ * - tokens: The tokens to parse.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_INVALID if it is invalid.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbParseFunctions(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
 {
-	CymbResult result = CYMB_SUCCESS;
-
-	CymbNode node = {
-		.type = CYMB_NODE_PROGRAM
-	};
-
-	CymbNodeChild* children = nullptr;
-
 	while(tokens->count > 0)
 	{
-		result = cymbParseFunction(tree, tokens, diagnostics);
+		CymbResult result = cymbParseFunction(tree, tokens, diagnostics);
 		if(result != CYMB_SUCCESS)
 		{
-			goto end;
+			return result;
 		}
 
-		result = cymbCreateChild(tree, &children);
+		result = cymbGatherChild(tree);
 		if(result != CYMB_SUCCESS)
 		{
-			goto end;
+			return result;
 		}
+	}
 
-		if(!node.programNode.children)
-		{
-			node.programNode.children = children;
-		}
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Add the program node of a tree, whose functions were gathered since a given count.
+ *
+ * Parameters:
+ * - tree: A tree.
+ * - scratchStart: The number of gathered children before the functions.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbAddProgram(CymbTree* const tree, const size_t scratchStart)
+{
+	CymbNode node = {
+		.type = CYMB_NODE_PROGRAM
+	};
+
+	const CymbResult result = cymbMoveChildren(tree, scratchStart, &node.programNode.children);
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
 	}
 
-	result = cymbAddNode(tree, &node);
+	return cymbAddNode(tree, &node);
+}
+
+CymbResult cymbParseProgram(CymbTree* const tree, CymbTokenList* const tokens, CymbDiagnosticList* const diagnostics)
+{
+	const size_t scratchStart = tree->scratch.count;
+
+	const CymbResult result = cymbParseFunctions(tree, tokens, diagnostics);
 	if(result != CYMB_SUCCESS)
 	{
-		goto end;
+		return result;
 	}
 
-	result = tokens->count == 0 ? CYMB_SUCCESS : CYMB_INVALID;
+	return cymbAddProgram(tree, scratchStart);
+}
 
-	end:
-	return result;
+void cymbTreeCreate(CymbTree* const tree, const CymbToken* const tokens)
+{
+	*tree = (CymbTree){
+		.tokens = tokens
+	};
+
+	cymbArrayCreate(&tree->nodes, sizeof(CymbNode));
+	cymbArrayCreate(&tree->children, sizeof(CymbNodeIndex));
+	cymbArrayCreate(&tree->scratch, sizeof(CymbNodeIndex));
+	cymbArrayCreate(&tree->operators, sizeof(CymbPendingOperator));
 }
 
-CymbResult cymbParse(const CymbTokenList* const tokens, CymbArena* const arena, CymbTree* const tree, CymbDiagnosticList* const diagnostics)
+CymbResult cymbParse(const CymbTokenList* const tokens, CymbTree* const tree, CymbDiagnosticList* const diagnostics)
 {
-	tree->root = nullptr;
-	tree->arena = arena;
+	cymbTreeCreate(tree, tokens->tokens);
 
 	CymbResult result = cymbParseProgram(tree, &(CymbTokenList){
 		.tokens = tokens->tokens,
-		.count = tokens->count
+		.count = tokens->count,
+		.constants = tokens->constants
 	}, diagnostics);
 	if(result != CYMB_SUCCESS)
 	{
@@ -1967,7 +2131,831 @@ CymbResult cymbParse(const CymbTokenList* const tokens, CymbArena* const arena,
 	return result;
 }
 
-void cymbFreeTree(CymbTree* const tree)
+/*
+ * Minimum number of tokens in a chunk parsed by a thread.
+ */
+constexpr size_t cymbParseChunkSize = 0x4000;
+
+/*
+ * A chunk of functions parsed by another thread.
+ *
+ * Fields:
+ * - tokens: The tokens of the functions.
+ * - arena: The arena used for the diagnostics.
+ * - diagnostics: The diagnostics of the chunk.
+ * - tree: The tree of the chunk, whose functions are gathered in its scratch.
+ * - result: The result of the parsing.
+ * - thread: The thread parsing the chunk.
+ * - threaded: Flag indicating if the thread was started.
+ */
+typedef struct CymbParseChunk
+{
+	CymbTokenList tokens;
+
+	CymbArena arena;
+	CymbDiagnosticList diagnostics;
+
+	CymbTree tree;
+
+	CymbResult result;
+
+	thrd_t thread;
+	bool threaded;
+} CymbParseChunk;
+
+/*
+ * Parse a chunk.
+ *
+ * Parameters:
+ * - chunkVoid: The chunk.
+ *
+ * Returns:
+ * - 0.
+ */
+static int cymbParseChunk(void* const chunkVoid)
+{
+	CymbParseChunk* const chunk = chunkVoid;
+
+	// The tokens of the chunk are kept, in case it is parsed again.
+	CymbTokenList tokens = chunk->tokens;
+	chunk->result = cymbParseFunctions(&chunk->tree, &tokens, &chunk->diagnostics);
+
+	return 0;
+}
+
+/*
+ * Find the end of the function starting at a token.
+ *
+ * Function bodies are the first brace of a function, so the function ends at its partner.
+ *
+ * Parameters:
+ * - tokens: The tokens.
+ * - tokenIndex: The index of the first token of the function.
+ *
+ * Returns:
+ * - The index of the token after the function.
+ * - The count of the tokens if the function has no matched body.
+ */
+static size_t cymbFindFunctionEnd(const CymbTokenList* const tokens, size_t tokenIndex)
+{
+	while(tokenIndex < tokens->count && tokens->tokens[tokenIndex].type != CYMB_TOKEN_OPEN_BRACE)
+	{
+		++tokenIndex;
+	}
+
+	if(tokenIndex == tokens->count || tokens->tokens[tokenIndex].partner == 0)
+	{
+		return tokens->count;
+	}
+
+	return tokenIndex + tokens->tokens[tokenIndex].partner + 1;
+}
+
+/*
+ * Offset a node index, keeping 0 as no node.
+ *
+ * Parameters:
+ * - index: The node index.
+ * - offset: The offset.
+ */
+static void cymbRebaseIndex(CymbNodeIndex* const index, const uint32_t offset)
+{
+	if(*index != 0)
+	{
+		*index += offset;
+	}
+}
+
+/*
+ * Offset a span, keeping empty spans empty.
+ *
+ * Parameters:
+ * - span: The span.
+ * - offset: The offset.
+ */
+static void cymbRebaseSpan(CymbNodeSpan* const span, const uint32_t offset)
+{
+	if(span->count != 0)
+	{
+		span->start += offset;
+	}
+}
+
+/*
+ * Offset the node indices and spans of a node.
+ *
+ * Parameters:
+ * - node: The node.
+ * - nodeOffset: The offset of the node indices.
+ * - childOffset: The offset of the spans.
+ */
+static void cymbRebaseNode(CymbNode* const node, const uint32_t nodeOffset, const uint32_t childOffset)
 {
+	switch(node->type)
+	{
+		case CYMB_NODE_PROGRAM:
+			cymbRebaseSpan(&node->programNode.children, childOffset);
+			break;
+
+		case CYMB_NODE_FUNCTION:
+			cymbRebaseIndex(&node->functionNode.name, nodeOffset);
+			cymbRebaseIndex(&node->functionNode.type, nodeOffset);
+			cymbRebaseSpan(&node->functionNode.children, childOffset);
+			break;
+
+		case CYMB_NODE_DECLARATION:
+			cymbRebaseIndex(&node->declarationNode.identifier, nodeOffset);
+			cymbRebaseIndex(&node->declarationNode.type, nodeOffset);
+			cymbRebaseIndex(&node->declarationNode.initializer, nodeOffset);
+			break;
+
+		case CYMB_NODE_POINTER:
+			cymbRebaseIndex(&node->pointerNode.pointedNode, nodeOffset);
+			break;
+
+		case CYMB_NODE_FUNCTION_TYPE:
+			cymbRebaseIndex(&node->functionTypeNode.returnType, nodeOffset);
+			cymbRebaseSpan(&node->functionTypeNode.parameterTypes, childOffset);
+			break;
+
+		case CYMB_NODE_WHILE:
+			cymbRebaseIndex(&node->whileNode.expression, nodeOffset);
+			cymbRebaseSpan(&node->whileNode.body, childOffset);
+			break;
+
+		case CYMB_NODE_RETURN:
+			cymbRebaseIndex(&node->returnNode, nodeOffset);
+			break;
+
+		case CYMB_NODE_BINARY_OPERATOR:
+			cymbRebaseIndex(&node->binaryOperatorNode.leftNode, nodeOffset);
+			cymbRebaseIndex(&node->binaryOperatorNode.rightNode, nodeOffset);
+			break;
+
+		case CYMB_NODE_UNARY_OPERATOR:
+			cymbRebaseIndex(&node->unaryOperatorNode.node, nodeOffset);
+			break;
+
+		case CYMB_NODE_FUNCTION_CALL:
+			cymbRebaseIndex(&node->functionCallNode.name, nodeOffset);
+			cymbRebaseSpan(&node->functionCallNode.arguments, childOffset);
+			break;
+
+		case CYMB_NODE_ARRAY_SUBSCRIPT:
+			cymbRebaseIndex(&node->arraySubscriptNode.name, nodeOffset);
+			cymbRebaseIndex(&node->arraySubscriptNode.expression, nodeOffset);
+			break;
+
+		case CYMB_NODE_MEMBER_ACCESS:
+			cymbRebaseIndex(&node->memberAccessNode.name, nodeOffset);
+			cymbRebaseIndex(&node->memberAccessNode.member, nodeOffset);
+			break;
+
+		case CYMB_NODE_POSTFIX_OPERATOR:
+			cymbRebaseIndex(&node->postfixOperatorNode.node, nodeOffset);
+			break;
+
+		case CYMB_NODE_TYPE:
+		case CYMB_NODE_IDENTIFIER:
+		case CYMB_NODE_CONSTANT:
+			break;
+
+		default:
+			unreachable();
+	}
+}
+
+/*
+ * Offset the node indices, spans and tokens of consecutive nodes.
+ *
+ * Parameters:
+ * - nodes: The nodes.
+ * - count: The number of nodes.
+ * - nodeOffset: The offset of the node indices.
+ * - childOffset: The offset of the spans.
+ * - tokenOffset: The offset of the token indices.
+ */
+static void cymbRebaseNodes(CymbNode* const nodes, const size_t count, const uint32_t nodeOffset, const uint32_t childOffset, const uint32_t tokenOffset)
+{
+	for(size_t nodeIndex = 0; nodeIndex < count; ++nodeIndex)
+	{
+		nodes[nodeIndex].token += tokenOffset;
+		cymbRebaseNode(&nodes[nodeIndex], nodeOffset, childOffset);
+	}
+}
+
+/*
+ * Offset consecutive children.
+ *
+ * Parameters:
+ * - children: The children.
+ * - count: The number of children.
+ * - nodeOffset: The offset of the node indices.
+ */
+static void cymbRebaseChildren(CymbNodeIndex* const children, const size_t count, const uint32_t nodeOffset)
+{
+	for(size_t childIndex = 0; childIndex < count; ++childIndex)
+	{
+		children[childIndex] += nodeOffset;
+	}
+}
+
+/*
+ * Append consecutive nodes and children of a tree to another tree, moving their node indices, spans and tokens.
+ *
+ * Parameters:
+ * - tree: The tree to append to, whose node 0 is reserved.
+ * - source: The tree of the nodes.
+ * - firstNode: The index of the first node.
+ * - nodeCount: The number of nodes, which only refer to each other.
+ * - firstChild: The index of the first child.
+ * - childCount: The number of children, which are the children of the nodes.
+ * - tokenOffset: The offset of the token indices.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbAppendNodes(CymbTree* const tree, const CymbTree* const source, const CymbNodeIndex firstNode, const size_t nodeCount, const uint32_t firstChild, const size_t childCount, const uint32_t tokenOffset)
+{
+	if(tree->nodes.count > UINT32_MAX - nodeCount || tree->children.count > UINT32_MAX - childCount)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	// Offsets wrap around when the nodes move backward.
+	const uint32_t nodeOffset = tree->nodes.count - firstNode;
+	const uint32_t childOffset = tree->children.count - firstChild;
+
+	if(nodeCount > 0)
+	{
+		CymbNode* const nodes = cymbArrayPush(&tree->nodes, nodeCount);
+		if(!nodes)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		memcpy(nodes, (const CymbNode*)source->nodes.data + firstNode, nodeCount * sizeof(*nodes));
+		cymbRebaseNodes(nodes, nodeCount, nodeOffset, childOffset, tokenOffset);
+	}
+
+	if(childCount > 0)
+	{
+		CymbNodeIndex* const children = cymbArrayPush(&tree->children, childCount);
+		if(!children)
+		{
+			return CYMB_OUT_OF_MEMORY;
+		}
+
+		memcpy(children, (const CymbNodeIndex*)source->children.data + firstChild, childCount * sizeof(*children));
+		cymbRebaseChildren(children, childCount, nodeOffset);
+	}
+
+	tree->nodeCount += nodeCount;
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Gather functions as children of the list being parsed, moving their node indices.
+ *
+ * Parameters:
+ * - tree: The tree.
+ * - functions: The functions.
+ * - count: The number of functions.
+ * - nodeOffset: The offset of the node indices.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbGatherFunctions(CymbTree* const tree, const CymbNodeIndex* const functions, const size_t count, const uint32_t nodeOffset)
+{
+	if(count == 0)
+	{
+		return CYMB_SUCCESS;
+	}
+
+	CymbNodeIndex* const children = cymbArrayPush(&tree->scratch, count);
+	if(!children)
+	{
+		return CYMB_OUT_OF_MEMORY;
+	}
+
+	for(size_t functionIndex = 0; functionIndex < count; ++functionIndex)
+	{
+		children[functionIndex] = functions[functionIndex] + nodeOffset;
+	}
+
+	return CYMB_SUCCESS;
+}
+
+/*
+ * Append the nodes, children and gathered functions of a chunk to a tree.
+ *
+ * The chunk refers to the same tokens as the tree, so only node indices and spans move.
+ * Appending the chunks in order gives the same arrays as parsing them one after the other.
+ *
+ * Parameters:
+ * - tree: The tree, whose node 0 is reserved.
+ * - chunk: The tree of the chunk, which is not empty.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbMergeTree(CymbTree* const tree, const CymbTree* const chunk)
+{
+	// Node 0 of the chunk is reserved, so it is not copied.
+	const uint32_t nodeOffset = tree->nodes.count - 1;
+
+	const CymbResult result = cymbAppendNodes(tree, chunk, 1, chunk->nodes.count - 1, 0, chunk->children.count, 0);
+	if(result != CYMB_SUCCESS)
+	{
+		return result;
+	}
+
+	return cymbGatherFunctions(tree, chunk->scratch.data, chunk->scratch.count, nodeOffset);
+}
+
+CymbResult cymbParseParallel(const CymbTokenList* const tokens, const unsigned int threadCount, CymbTree* const tree, CymbDiagnosticList* const diagnostics)
+{
+	// Small programs are not worth starting threads.
+	size_t chunkCount = CYMB_MIN(threadCount, tokens->count / cymbParseChunkSize);
+	if(chunkCount <= 1)
+	{
+		return cymbParse(tokens, tree, diagnostics);
+	}
+
+	cymbTreeCreate(tree, tokens->tokens);
+
+	CymbResult result = CYMB_SUCCESS;
+
+	// The first chunk is parsed by the calling thread.
+	CymbParseChunk* const chunks = calloc(chunkCount - 1, sizeof(chunks[0]));
+	if(!chunks)
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto error;
+	}
+
+	// Chunks start after a function, at the first one past an even share of the tokens.
+	size_t firstCount = tokens->count;
+	size_t startedCount = 0;
+	size_t functionEnd = 0;
+	while(startedCount < chunkCount - 1 && functionEnd < tokens->count)
+	{
+		functionEnd = cymbFindFunctionEnd(tokens, functionEnd);
+		if(functionEnd == tokens->count || functionEnd < tokens->count / chunkCount * (startedCount + 1))
+		{
+			continue;
+		}
+
+		chunks[startedCount].tokens = (CymbTokenList){
+			.tokens = tokens->tokens + functionEnd,
+			.count = tokens->count - functionEnd,
+			.constants = tokens->constants
+		};
+		if(startedCount == 0)
+		{
+			firstCount = functionEnd;
+		}
+		else
+		{
+			chunks[startedCount - 1].tokens.count -= chunks[startedCount].tokens.count;
+		}
+
+		++startedCount;
+	}
+	chunkCount = startedCount + 1;
+
+	for(size_t chunkIndex = 0; chunkIndex < chunkCount - 1; ++chunkIndex)
+	{
+		CymbParseChunk* const chunk = &chunks[chunkIndex];
+
+		// Chunk arenas take their regions from the pool of the caller, if any.
+		cymbArenaCreatePooled(&chunk->arena, diagnostics->arena->pool);
+		cymbDiagnosticListCreate(&chunk->diagnostics, &chunk->arena, diagnostics->file, diagnostics->tabWidth);
+		cymbDiagnosticListSetSource(&chunk->diagnostics, diagnostics->source);
+		chunk->diagnostics.limit = diagnostics->limit;
+
+		// Chunk trees index the same tokens, so that token indices need no change.
+		cymbTreeCreate(&chunk->tree, tokens->tokens);
+
+		chunk->threaded = thrd_create(&chunk->thread, cymbParseChunk, chunk) == thrd_success;
+		if(!chunk->threaded)
+		{
+			cymbParseChunk(chunk);
+		}
+	}
+
+	CymbTokenList remaining = {
+		.tokens = tokens->tokens,
+		.count = firstCount,
+		.constants = tokens->constants
+	};
+	result = cymbParseFunctions(tree, &remaining, diagnostics);
+	bool merging = result == CYMB_SUCCESS;
+
+	// Every thread is joined, even after a failure.
+	for(size_t chunkIndex = 0; chunkIndex < chunkCount - 1; ++chunkIndex)
+	{
+		CymbParseChunk* const chunk = &chunks[chunkIndex];
+
+		if(chunk->threaded)
+		{
+			thrd_join(chunk->thread, nullptr);
+		}
+
+		if(merging && chunk->result == CYMB_SUCCESS)
+		{
+			for(const CymbDiagnostic* diagnostic = chunk->diagnostics.start; result == CYMB_SUCCESS && diagnostic; diagnostic = diagnostic->next)
+			{
+				result = cymbDiagnosticAdd(diagnostics, diagnostic);
+			}
+
+			if(result == CYMB_SUCCESS)
+			{
+				result = cymbMergeTree(tree, &chunk->tree);
+			}
+			merging = result == CYMB_SUCCESS;
+		}
+		// The first failing chunk is parsed again with the following tokens, so that its diagnostics are the same as with cymbParse.
+		else if(merging)
+		{
+			remaining = (CymbTokenList){
+				.tokens = chunk->tokens.tokens,
+				.count = tokens->tokens + tokens->count - chunk->tokens.tokens,
+				.constants = tokens->constants
+			};
+			result = cymbParseFunctions(tree, &remaining, diagnostics);
+			merging = false;
+		}
+
+		cymbFreeTree(&chunk->tree);
+		cymbArenaFree(&chunk->arena);
+	}
+
+	free(chunks);
+
+	if(result != CYMB_SUCCESS)
+	{
+		goto error;
+	}
+
+	result = cymbAddProgram(tree, 0);
+	if(result != CYMB_SUCCESS)
+	{
+		goto error;
+	}
+
+	goto end;
+
+	error:
+	cymbFreeTree(tree);
+
+	end:
+	return result;
+}
+
+/*
+ * Lex and parse a whole source again, freeing the previous tokens and tree.
+ *
+ * Parameters:
+ * - string: The source.
+ * - standard: The standard in use.
+ * - interner: The interner in which identifiers are interned.
+ * - tokens: The previous tokens, replaced by the new ones.
+ * - tree: The previous tree, replaced by the new one.
+ * - diagnostics: A list of diagnostics.
+ *
+ * Returns:
+ * - CYMB_SUCCESS on success.
+ * - CYMB_INVALID if it is invalid.
+ * - CYMB_OUT_OF_MEMORY if an allocation failed.
+ */
+static CymbResult cymbParseAgain(const char* const string, const CymbStandard standard, CymbInterner* const interner, CymbTokenList* const tokens, CymbTree* const tree, CymbDiagnosticList* const diagnostics)
+{
+	cymbFreeTree(tree);
+	cymbFreeTokenList(tokens);
+
+	const CymbResult result = cymbLex(string, standard, interner, tokens, diagnostics);
+	if((result != CYMB_SUCCESS && result != CYMB_INVALID) || cymbDiagnosticListFull(diagnostics))
+	{
+		return result;
+	}
+
+	const CymbResult parseResult = cymbParse(tokens, tree, diagnostics);
+
+	return parseResult == CYMB_SUCCESS ? result : parseResult;
+}
+
+/*
+ * Get the end of the children of the first functions of a program.
+ *
+ * The children of a function are moved after those of its subtree, so a function without children has none in its subtree.
+ *
+ * Parameters:
+ * - tree: The tree.
+ * - functions: The functions of the program.
+ * - count: The number of first functions.
+ *
+ * Returns:
+ * - The index after the last child of the functions.
+ */
+static uint32_t cymbFunctionsChildrenEnd(const CymbTree* const tree, const CymbNodeIndex* const functions, size_t count)
+{
+	while(count > 0)
+	{
+		--count;
+
+		const CymbNodeSpan children = cymbGetNode(tree, functions[count])->functionNode.children;
+		if(children.count > 0)
+		{
+			return children.start + children.count;
+		}
+	}
+
+	return 0;
+}
+
+CymbResult cymbReparse(const char* const string, const CymbStandard standard, const CymbEdit* const edit, CymbInterner* const interner, CymbTokenList* const tokens, CymbTree* const tree, CymbDiagnosticList* const diagnostics)
+{
+	const size_t length = strlen(string);
+
+	// Only the functions of a successful lex and parse can be reused, as the errors of the others would be lost.
+	const CymbNode* const program = tree->root == 0 ? nullptr : cymbGetNode(tree, tree->root);
+	if(tokens->invalid || !program || program->type != CYMB_NODE_PROGRAM || program->programNode.children.count == 0 || length > UINT32_MAX)
+	{
+		return cymbParseAgain(string, standard, interner, tokens, tree, diagnostics);
+	}
+
+	const CymbNodeIndex* const functions = (const CymbNodeIndex*)tree->children.data + program->programNode.children.start;
+	const size_t functionCount = program->programNode.children.count;
+	const size_t editEnd = edit->offset + edit->removedLength;
+
+	// Find the first token ending at or after the edit, and the first one starting after it.
+	size_t touched = 0;
+	size_t last = tokens->count;
+	while(touched < last)
+	{
+		const size_t middle = touched + (last - touched) / 2;
+		if((size_t)tokens->tokens[middle].offset + tokens->tokens[middle].length < edit->offset)
+		{
+			touched = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	size_t after = touched;
+	last = tokens->count;
+	while(after < last)
+	{
+		const size_t middle = after + (last - after) / 2;
+		if(tokens->tokens[middle].offset <= editEnd)
+		{
+			after = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	// Find the function of the first touched token, or the previous one if the edit is before its first token.
+	size_t firstFunction = 0;
+	size_t regionStart = 0;
+	size_t regionEnd = cymbFindFunctionEnd(tokens, 0);
+	size_t previousStart = 0;
+	while(regionEnd <= touched && firstFunction + 1 < functionCount)
+	{
+		previousStart = regionStart;
+		regionStart = regionEnd;
+		regionEnd = cymbFindFunctionEnd(tokens, regionStart);
+		++firstFunction;
+	}
+
+	size_t lastFunction = firstFunction;
+	if(firstFunction > 0 && tokens->tokens[regionStart].offset > edit->offset)
+	{
+		--firstFunction;
+		regionStart = previousStart;
+	}
+
+	// Find the function of the last touched token, or the next one if the edit is after its last token.
+	while(regionEnd < after && lastFunction + 1 < functionCount)
+	{
+		regionEnd = cymbFindFunctionEnd(tokens, regionEnd);
+		++lastFunction;
+	}
+	if(regionEnd < tokens->count && (size_t)tokens->tokens[regionEnd - 1].offset + tokens->tokens[regionEnd - 1].length < editEnd)
+	{
+		regionEnd = cymbFindFunctionEnd(tokens, regionEnd);
+		++lastFunction;
+	}
+
+	// The functions found from the tokens must be those of the tree.
+	if(lastFunction >= functionCount || (lastFunction + 1 == functionCount) != (regionEnd == tokens->count))
+	{
+		return cymbParseAgain(string, standard, interner, tokens, tree, diagnostics);
+	}
+
+	// The characters before the start and after the bound are not edited.
+	const ptrdiff_t shift = (ptrdiff_t)edit->insertedLength - (ptrdiff_t)edit->removedLength;
+	const size_t start = regionStart == 0 ? 0 : tokens->tokens[regionStart].offset;
+	const size_t bound = regionEnd == tokens->count ? length : (size_t)((ptrdiff_t)(tokens->tokens[regionEnd - 1].offset + tokens->tokens[regionEnd - 1].length) + shift);
+
+	// The diagnostics of the region are kept apart until its tokens are known to be reused.
+	CymbDiagnosticList regionDiagnostics;
+	cymbDiagnosticListCreate(&regionDiagnostics, diagnostics->arena, diagnostics->file, diagnostics->tabWidth);
+	regionDiagnostics.limit = diagnostics->limit;
+
+	CymbTokenList region;
+	size_t end;
+	const CymbResult lexResult = cymbLexRange(string, standard, start, bound, interner, &region, &end, &regionDiagnostics);
+	if(lexResult != CYMB_SUCCESS && lexResult != CYMB_INVALID)
+	{
+		cymbFreeTree(tree);
+		cymbFreeTokenList(tokens);
+		return lexResult;
+	}
+
+	// Lexing only depends on the position, so the following tokens are unchanged if lexing stopped at the bound or at the first of them.
+	size_t regionCount = region.count;
+	if(end != bound && regionEnd < tokens->count)
+	{
+		if(regionCount == 0 || region.tokens[regionCount - 1].offset != tokens->tokens[regionEnd].offset + shift)
+		{
+			cymbFreeTokenList(&region);
+			return cymbParseAgain(string, standard, interner, tokens, tree, diagnostics);
+		}
+
+		--regionCount;
+	}
+
+	CymbResult result = cymbReplaceTokens(tokens, regionStart, regionEnd, &(CymbTokenList){
+		.tokens = region.tokens,
+		.count = regionCount,
+		.constants = region.constants
+	}, shift);
+	cymbFreeTokenList(&region);
+
+	// The other tokens were lexed without error.
+	tokens->invalid = lexResult == CYMB_INVALID;
+
+	cymbDiagnosticListSetSource(diagnostics, string);
+	for(const CymbDiagnostic* diagnostic = regionDiagnostics.start; result == CYMB_SUCCESS && diagnostic; diagnostic = diagnostic->next)
+	{
+		result = cymbDiagnosticAdd(diagnostics, diagnostic);
+	}
+
+	if(result != CYMB_SUCCESS)
+	{
+		cymbFreeTree(tree);
+		cymbFreeTokenList(tokens);
+		return result;
+	}
+
+	// Parsing is skipped once the error limit is reached.
+	if(cymbDiagnosticListFull(diagnostics))
+	{
+		cymbFreeTree(tree);
+		return lexResult;
+	}
+
+	// The edited functions are parsed in a tree of their own, with all the following tokens so that they are parsed as with cymbParse.
+	tree->tokens = tokens->tokens;
+
+	CymbTree edited;
+	cymbTreeCreate(&edited, tokens->tokens);
+
+	CymbTokenList remaining = {
+		.tokens = tokens->tokens + regionStart,
+		.count = tokens->count - regionStart,
+		.constants = tokens->constants
+	};
+	const CymbToken* const regionBound = remaining.tokens + regionCount;
+	while(remaining.tokens < regionBound)
+	{
+		result = cymbParseFunction(&edited, &remaining, diagnostics);
+		if(result != CYMB_SUCCESS)
+		{
+			goto error;
+		}
+
+		result = cymbGatherChild(&edited);
+		if(result != CYMB_SUCCESS)
+		{
+			goto error;
+		}
+	}
+
+	// If a function ends past the edited ones, the following ones are split differently and parsed again.
+	const bool reuse = remaining.tokens == regionBound;
+	if(!reuse)
+	{
+		result = cymbParseFunctions(&edited, &remaining, diagnostics);
+		if(result != CYMB_SUCCESS)
+		{
+			goto error;
+		}
+	}
+
+	// The functions before the edited ones stay in place, the edited ones come after them and the following ones move after these.
+	const CymbNodeIndex prefixEnd = firstFunction == 0 ? 0 : functions[firstFunction - 1];
+	const uint32_t prefixChildrenEnd = cymbFunctionsChildrenEnd(tree, functions, firstFunction);
+	const size_t editedCount = edited.nodes.count == 0 ? 0 : edited.nodes.count - 1;
+	const size_t editedChildCount = edited.children.count;
+	const CymbNodeIndex suffixStart = functions[lastFunction] + 1;
+	const size_t suffixCount = reuse ? functions[functionCount - 1] + 1 - suffixStart : 0;
+	const uint32_t suffixChildrenStart = cymbFunctionsChildrenEnd(tree, functions, lastFunction + 1);
+	const size_t suffixChildCount = reuse ? cymbFunctionsChildrenEnd(tree, functions, functionCount) - suffixChildrenStart : 0;
+
+	const size_t nodeCount = prefixEnd + 1 + editedCount + suffixCount;
+	const size_t childCount = prefixChildrenEnd + editedChildCount + suffixChildCount;
+	if(nodeCount >= UINT32_MAX || childCount > UINT32_MAX - functionCount - edited.scratch.count)
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto error;
+	}
+
+	// Offsets wrap around when the following nodes move backward.
+	const uint32_t nodeOffset = prefixEnd + 1 + editedCount - suffixStart;
+	const uint32_t childOffset = prefixChildrenEnd + editedChildCount - suffixChildrenStart;
+	const uint32_t tokenOffset = (uint32_t)(regionStart + regionCount - regionEnd);
+
+	// The functions are gathered before the children they are read from move.
+	tree->scratch.count = 0;
+	result = cymbGatherFunctions(tree, functions, firstFunction, 0);
+	if(result == CYMB_SUCCESS)
+	{
+		result = cymbGatherFunctions(tree, edited.scratch.data, edited.scratch.count, prefixEnd);
+	}
+	if(result == CYMB_SUCCESS && reuse)
+	{
+		result = cymbGatherFunctions(tree, functions + lastFunction + 1, functionCount - lastFunction - 1, nodeOffset);
+	}
+	if(result != CYMB_SUCCESS)
+	{
+		goto error;
+	}
+
+	if(
+		(nodeCount > tree->nodes.count && !cymbArrayPush(&tree->nodes, nodeCount - tree->nodes.count)) ||
+		(childCount > tree->children.count && !cymbArrayPush(&tree->children, childCount - tree->children.count))
+	)
+	{
+		result = CYMB_OUT_OF_MEMORY;
+		goto error;
+	}
+
+	CymbNode* const nodes = (CymbNode*)tree->nodes.data + prefixEnd + 1;
+	memmove(nodes + editedCount, nodes + suffixStart - prefixEnd - 1, suffixCount * sizeof(*nodes));
+	cymbRebaseNodes(nodes + editedCount, suffixCount, nodeOffset, childOffset, tokenOffset);
+	if(editedCount > 0)
+	{
+		memcpy(nodes, (const CymbNode*)edited.nodes.data + 1, editedCount * sizeof(*nodes));
+		cymbRebaseNodes(nodes, editedCount, prefixEnd, prefixChildrenEnd, 0);
+	}
+	tree->nodes.count = nodeCount;
+	tree->nodeCount = nodeCount - 1;
+
+	CymbNodeIndex* const children = (CymbNodeIndex*)tree->children.data + prefixChildrenEnd;
+	memmove(children + editedChildCount, children + suffixChildrenStart - prefixChildrenEnd, suffixChildCount * sizeof(*children));
+	cymbRebaseChildren(children + editedChildCount, suffixChildCount, nodeOffset);
+	if(editedChildCount > 0)
+	{
+		memcpy(children, edited.children.data, editedChildCount * sizeof(*children));
+		cymbRebaseChildren(children, editedChildCount, prefixEnd);
+	}
+	tree->children.count = childCount;
+
+	result = cymbAddProgram(tree, 0);
+	if(result != CYMB_SUCCESS)
+	{
+		goto error;
+	}
+
+	cymbFreeTree(&edited);
+
+	return lexResult;
+
+	error:
+	cymbFreeTree(&edited);
+	cymbFreeTree(tree);
+
+	return result;
+}
+
+void cymbFreeTree(CymbTree* const tree)
+{
+	cymbArrayFree(&tree->nodes);
+	cymbArrayFree(&tree->children);
+	cymbArrayFree(&tree->scratch);
+	cymbArrayFree(&tree->operators);
+
 	*tree = (CymbTree){};
 }
@@ -16,9 +16,13 @@ void cymbPrintHelp(void)
 		"Usage: cymb [options] input-files...\n"
 		"Options:\n"
 		"  -g --debug                  Compile in debug.\n"
+		"     --error-limit=<count>    Stop after <count> errors in an input, 0 for no limit.\n"
 		"  -h --help                   Show this help information.\n"
+		"  -j --threads=<count>        Set the maximum number of threads.\n"
 		"  -o --output=<output-file>   Set the output file.\n"
+		"     --retain=<size>          Keep up to <size> MiB of free memory between inputs.\n"
 		"     --standard=<standard>    Set the C standard.\n"
+		"     --stats                  Show memory and size statistics of each input.\n"
 		"     --tab-width=<tab-width>  Set the tab width for diagnostics.\n"
 		"  -v --version                Show the version information."
 	);
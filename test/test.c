@@ -1,8 +1,11 @@
 #include <limits.h>
+#include <stdbit.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 
+#include "cymb/lex.h"
 #include "cymb/memory.h"
 #include "cymb/options.h"
 #include "test.h"
@@ -113,6 +116,150 @@ static void cymbTestTab(CymbTestContext* const context)
 	cymbContextPop(context);
 }
 
+static void cymbTestLocate(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const char* const source = "int a;\n\tb =\t1;\n\nc";
+
+	const struct
+	{
+		CymbStringView hint;
+		CymbDiagnosticInfo solution;
+	} tests[] = {
+		{{source, 3}, {{1, 1}, {source, 6}, {source, 3}}},
+		{{source + 4, 1}, {{1, 5}, {source, 6}, {source + 4, 1}}},
+		{{source + 8, 1}, {{2, 5}, {source + 7, 7}, {source + 8, 1}}},
+		{{source + 12, 2}, {{2, 9}, {source + 7, 7}, {source + 12, 2}}},
+		{{source + 15, 0}, {{3, 1}, {source + 15, 0}, {source + 15, 0}}},
+		{{source + 16, 1}, {{4, 1}, {source + 16, 1}, {source + 16, 1}}}
+	};
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	cymbDiagnosticListSetSource(&context->diagnostics, source);
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		const CymbDiagnosticInfo info = cymbDiagnosticLocate(&context->diagnostics, tests[testIndex].hint);
+		cymbCompareDiagnosticInfo(&info, &tests[testIndex].solution, context);
+	}
+
+	if(context->diagnostics.lineCount != 4)
+	{
+		cymbFail(context, "Wrong line count.");
+	}
+
+	cymbDiagnosticListSetSource(&context->diagnostics, nullptr);
+	cymbArenaRestore(&context->arena, save);
+
+	cymbContextPop(context);
+}
+
+static void cymbTestRender(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const char* const source = "int a;\n\tb =\t1;\n";
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbDiagnosticList diagnostics;
+	cymbDiagnosticListCreate(&diagnostics, &context->arena, "main.c", 4);
+	cymbDiagnosticListSetSource(&diagnostics, source);
+
+	const CymbDiagnostic diagnosticsToAdd[] = {
+		{
+			.type = CYMB_UNKNOWN_TOKEN,
+			.info = cymbDiagnosticLocate(&diagnostics, (CymbStringView){source + 12, 2})
+		},
+		{
+			.type = CYMB_INVALID_ARGUMENT,
+			.info = {
+				.hint = CYMB_STRING("x")
+			}
+		},
+		{
+			.type = CYMB_UNFINISHED_STRING
+		}
+	};
+	constexpr size_t diagnosticCount = CYMB_LENGTH(diagnosticsToAdd);
+
+	// The last diagnostic is past the limit.
+	diagnostics.limit = diagnosticCount - 1;
+	for(size_t diagnosticIndex = 0; diagnosticIndex < diagnosticCount; ++diagnosticIndex)
+	{
+		if(cymbDiagnosticListFull(&diagnostics) != (diagnosticIndex == diagnosticCount - 1) || cymbDiagnosticAdd(&diagnostics, &diagnosticsToAdd[diagnosticIndex]) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Wrong limit.");
+		}
+	}
+	if(diagnostics.count != diagnosticCount - 1 || diagnostics.end->type != CYMB_INVALID_ARGUMENT)
+	{
+		cymbFail(context, "Diagnostics past the limit should be dropped.");
+	}
+
+	const char* const solution =
+		"In file main.c, line 2, column 9:\n"
+		"Unknown token.\n"
+		"2 |     b = 1;\n"
+		"            ~~\n"
+		"Invalid argument.\n"
+		"x\n"
+		"Error limit reached, stopping.\n";
+
+	CymbString string;
+	if(cymbDiagnosticListRender(&diagnostics, &string) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to render.");
+	}
+	else if(string.length != strlen(solution) || strcmp(string.string, solution) != 0)
+	{
+		cymbFail(context, "Wrong rendering.");
+	}
+	cymbArrayDataFree(string.string);
+
+	// Lexing stops at the limit, with or without threads.
+	constexpr size_t length = 0x40000;
+	char* const garbage = malloc(length + 1);
+	if(!garbage)
+	{
+		cymbFail(context, "Failed to allocate.");
+		goto end;
+	}
+	for(size_t characterIndex = 0; characterIndex < length; ++characterIndex)
+	{
+		garbage[characterIndex] = characterIndex % 0x40 == 0x3F ? '\n' : '`';
+	}
+	garbage[length] = '\0';
+
+	for(unsigned int threadCount = 1; threadCount <= 4; threadCount *= 4)
+	{
+		cymbContextSetIndex(context, threadCount);
+
+		cymbDiagnosticListFree(&diagnostics);
+		diagnostics.limit = 3;
+
+		CymbTokenList tokens;
+		const CymbResult result = cymbLexParallel(garbage, CYMB_C23, threadCount, nullptr, &tokens, &diagnostics);
+		if(result != CYMB_INVALID || diagnostics.count != 3 || !cymbDiagnosticListFull(&diagnostics))
+		{
+			cymbFail(context, "Lexing should stop at the limit.");
+		}
+		cymbFreeTokenList(&tokens);
+	}
+
+	free(garbage);
+
+	end:
+	cymbArenaRestore(&context->arena, save);
+
+	cymbContextPop(context);
+}
+
 static int cymbCompareInts(const void* const firstVoid, const void* const secondVoid)
 {
 	const int first = *(const int*)firstVoid;
@@ -185,8 +332,10 @@ static void cymbTestArguments(CymbTestContext* const context)
 				tests[0].arguments[0].string
 			},
 			.inputCount = 1,
+			.retainedSize = cymbDefaultRetainedSize,
 			.standard = CYMB_C23,
-			.tabWidth = 8
+			.tabWidth = 8,
+			.threadCount = 1
 		}, {}},
 		{(const CymbConstString[]){
 			CYMB_STRING("-o"),
@@ -198,9 +347,11 @@ static void cymbTestArguments(CymbTestContext* const context)
 				tests[1].arguments[2].string
 			},
 			.inputCount = 1,
+			.retainedSize = cymbDefaultRetainedSize,
 			.output = tests[1].arguments[3].string + 9,
 			.standard = CYMB_C23,
-			.tabWidth = 8
+			.tabWidth = 8,
+			.threadCount = 1
 		}, {}},
 		{(const CymbConstString[]){
 			CYMB_STRING("--output")
@@ -219,7 +370,9 @@ static void cymbTestArguments(CymbTestContext* const context)
 				tests[4].arguments[2].string
 			},
 			.inputCount = 1,
+			.retainedSize = cymbDefaultRetainedSize,
 			.tabWidth = 4,
+			.threadCount = 1,
 			.standard = CYMB_C11
 		}, {}},
 		{(const CymbConstString[]){
@@ -235,10 +388,71 @@ static void cymbTestArguments(CymbTestContext* const context)
 				tests[5].arguments[4].string
 			},
 			.inputCount = 3,
+			.retainedSize = cymbDefaultRetainedSize,
 			.tabWidth = 1,
+			.threadCount = 1,
 			.standard = CYMB_C23
 		}, {}},
-		{nullptr, 0, CYMB_INVALID, {}, {}}
+		{nullptr, 0, CYMB_INVALID, {}, {}},
+		{(const CymbConstString[]){
+			CYMB_STRING("-gj4"),
+			CYMB_STRING("main.c")
+		}, 2, CYMB_SUCCESS, {
+			.inputs = (const char*[]){
+				tests[7].arguments[1].string
+			},
+			.inputCount = 1,
+			.retainedSize = cymbDefaultRetainedSize,
+			.standard = CYMB_C23,
+			.tabWidth = 8,
+			.threadCount = 4,
+			.debug = true
+		}, {}},
+		{(const CymbConstString[]){
+			CYMB_STRING("main.c"),
+			CYMB_STRING("--threads=257")
+		}, 2, CYMB_INVALID, {}, {}},
+		{(const CymbConstString[]){
+			CYMB_STRING("--stats"),
+			CYMB_STRING("main.c")
+		}, 2, CYMB_SUCCESS, {
+			.inputs = (const char*[]){
+				tests[9].arguments[1].string
+			},
+			.inputCount = 1,
+			.retainedSize = cymbDefaultRetainedSize,
+			.standard = CYMB_C23,
+			.tabWidth = 8,
+			.threadCount = 1,
+			.stats = true
+		}, {}},
+		{(const CymbConstString[]){
+			CYMB_STRING("main.c"),
+			CYMB_STRING("--retain=64")
+		}, 2, CYMB_SUCCESS, {
+			.inputs = (const char*[]){
+				tests[10].arguments[0].string
+			},
+			.inputCount = 1,
+			.retainedSize = 0x4000000,
+			.standard = CYMB_C23,
+			.tabWidth = 8,
+			.threadCount = 1
+		}, {}},
+		{(const CymbConstString[]){
+			CYMB_STRING("--error-limit=20"),
+			CYMB_STRING("main.c")
+		}, 2, CYMB_SUCCESS, {
+			.inputs = (const char*[]){
+				tests[11].arguments[1].string
+			},
+			.inputCount = 1,
+			.retainedSize = cymbDefaultRetainedSize,
+			.standard = CYMB_C23,
+			.tabWidth = 8,
+			.threadCount = 1,
+			.errorLimit = 20
+		}, {}}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
@@ -273,6 +487,16 @@ static void cymbTestArguments(CymbTestContext* const context)
 	};
 	tests[6].diagnostics.start = diagnostics6;
 
+	CymbDiagnostic diagnostics8[] = {
+		{
+			.type = CYMB_INVALID_ARGUMENT,
+			.info = {
+				.hint = {tests[8].arguments[1].string + 10, 3}
+			}
+		}
+	};
+	tests[8].diagnostics.start = diagnostics8;
+
 	const CymbArenaSave save = cymbArenaSave(&context->arena);
 
 	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
@@ -293,16 +517,36 @@ static void cymbTestArguments(CymbTestContext* const context)
 				cymbFail(context, "Wrong debug.");
 			}
 
+			if(options.stats != tests[testIndex].options.stats)
+			{
+				cymbFail(context, "Wrong stats.");
+			}
+
 			if(options.help != tests[testIndex].options.help)
 			{
 				cymbFail(context, "Wrong version.");
 			}
 
+			if(options.errorLimit != tests[testIndex].options.errorLimit)
+			{
+				cymbFail(context, "Wrong error limit.");
+			}
+
+			if(options.retainedSize != tests[testIndex].options.retainedSize)
+			{
+				cymbFail(context, "Wrong retained size.");
+			}
+
 			if(options.tabWidth != tests[testIndex].options.tabWidth)
 			{
 				cymbFail(context, "Wrong tab width.");
 			}
 
+			if(options.threadCount != tests[testIndex].options.threadCount)
+			{
+				cymbFail(context, "Wrong thread count.");
+			}
+
 			if(options.standard != tests[testIndex].options.standard)
 			{
 				cymbFail(context, "Wrong standard.");
@@ -375,6 +619,438 @@ static void cymbTestMurmur3(CymbTestContext* const context)
 	cymbContextPop(context);
 }
 
+static int cymbCompareHashes(const void* const firstVoid, const void* const secondVoid)
+{
+	const uint64_t first = *(const uint64_t*)firstVoid;
+	const uint64_t second = *(const uint64_t*)secondVoid;
+
+	return (first > second) - (first < second);
+}
+
+static void cymbTestHash(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	// Every length of each read path, at every alignment.
+	alignas(8) unsigned char buffer[0x100];
+	for(size_t index = 0; index < sizeof(buffer); ++index)
+	{
+		buffer[index] = index * 0x9D + 0x31;
+	}
+
+	for(size_t length = 0; length <= 0x80; ++length)
+	{
+		cymbContextSetIndex(context, length);
+
+		const uint64_t hash = cymbHash(buffer, length);
+		for(size_t offset = 1; offset < 8; ++offset)
+		{
+			unsigned char copy[0x100];
+			memcpy(copy + offset, buffer, length);
+
+			if(cymbHash(copy + offset, length) != hash)
+			{
+				cymbFail(context, "Hash depends on alignment.");
+				break;
+			}
+		}
+
+		if(length > 0 && cymbHash(buffer, length - 1) == hash)
+		{
+			cymbFail(context, "Hash ignores the last byte.");
+		}
+	}
+
+	// Flipping any input bit should flip about half of the output bits.
+	size_t flipCount = 0;
+	size_t flippedBitCount = 0;
+	for(size_t length = 1; length <= 0x40; ++length)
+	{
+		cymbContextSetIndex(context, length);
+
+		const uint64_t hash = cymbHash(buffer, length);
+		for(size_t bit = 0; bit < length * 8; ++bit)
+		{
+			buffer[bit / 8] ^= 1 << (bit % 8);
+			const unsigned int flippedBits = stdc_count_ones(hash ^ cymbHash(buffer, length));
+			buffer[bit / 8] ^= 1 << (bit % 8);
+
+			if(flippedBits < 8 || flippedBits > 56)
+			{
+				cymbFail(context, "Poor avalanche.");
+			}
+
+			++flipCount;
+			flippedBitCount += flippedBits;
+		}
+	}
+
+	const double averageFlippedBits = (double)flippedBitCount / flipCount;
+	if(averageFlippedBits < 31.0 || averageFlippedBits > 33.0)
+	{
+		cymbFail(context, "Biased avalanche.");
+	}
+
+	// Similar identifiers should neither collide nor cluster in the bits maps use.
+	constexpr size_t keyCount = 0x10000;
+	constexpr size_t bucketCount = 0x100;
+
+	uint64_t* const hashes = cymbArenaAllocate(&context->arena, keyCount * sizeof(hashes[0]), alignof(typeof(hashes[0])));
+	if(!hashes)
+	{
+		cymbFail(context, "Allocation failed.");
+		goto end;
+	}
+
+	size_t buckets[bucketCount] = {};
+	for(size_t keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+	{
+		char key[0x20];
+		const int length = snprintf(key, sizeof(key), "symbol_%zu", keyIndex);
+
+		hashes[keyIndex] = cymbHash((const unsigned char*)key, length);
+		++buckets[(hashes[keyIndex] >> 7) % bucketCount];
+	}
+
+	// The chi-squared statistic has a mean of 255 and a standard deviation of about 23 for 256 buckets.
+	double chiSquared = 0.0;
+	for(size_t bucket = 0; bucket < bucketCount; ++bucket)
+	{
+		const double difference = (double)buckets[bucket] - (double)keyCount / bucketCount;
+		chiSquared += difference * difference / ((double)keyCount / bucketCount);
+	}
+	if(chiSquared > 400.0)
+	{
+		cymbFail(context, "Poor distribution.");
+	}
+
+	qsort(hashes, keyCount, sizeof(hashes[0]), cymbCompareHashes);
+	for(size_t keyIndex = 1; keyIndex < keyCount; ++keyIndex)
+	{
+		if(hashes[keyIndex] == hashes[keyIndex - 1])
+		{
+			cymbFail(context, "Hash collision.");
+			break;
+		}
+	}
+
+	end:
+	cymbContextPop(context);
+}
+
+static void cymbTestArena(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	CymbArena arena;
+	cymbArenaCreate(&arena);
+
+	const CymbArenaSave emptySave = cymbArenaSave(&arena);
+
+	// Fill a few regions.
+	for(size_t allocationIndex = 0; allocationIndex < 0x1000; ++allocationIndex)
+	{
+		cymbContextSetIndex(context, allocationIndex);
+
+		const unsigned long long* const allocation = cymbArenaAllocate(&arena, 0x18, alignof(unsigned long long));
+		if(!allocation || (uintptr_t)allocation % alignof(unsigned long long) != 0)
+		{
+			cymbFail(context, "Failed to allocate.");
+			goto end;
+		}
+	}
+
+	if(!arena.start || !arena.start->next || arena.start->next->capacity < arena.start->capacity * 2 || arena.large)
+	{
+		cymbFail(context, "Regions should grow geometrically.");
+	}
+
+	// Each region but the first was created after skipping the full one before.
+	size_t regionCount = 0;
+	for(const CymbRegion* region = arena.start; region; region = region->next)
+	{
+		++regionCount;
+	}
+	if(
+		arena.stats.requestedSize != 0x1000 * 0x18 ||
+		arena.stats.paddingSize != 0 ||
+		arena.stats.regionCount != regionCount ||
+		arena.stats.peakSize != arena.stats.size ||
+		arena.stats.fullRegionCount != regionCount - 1
+	)
+	{
+		cymbFail(context, "Wrong statistics.");
+	}
+
+	if(!cymbArenaAllocate(&arena, 1, 1) || !cymbArenaAllocate(&arena, 8, 8) || arena.stats.paddingSize != 7)
+	{
+		cymbFail(context, "Wrong padding.");
+	}
+
+	const CymbArenaSave save = cymbArenaSave(&arena);
+	const CymbRegion* const end = arena.end;
+
+	void* const large = cymbArenaAllocate(&arena, 0x40000, 64);
+	if(!large || (uintptr_t)large % 64 != 0)
+	{
+		cymbFail(context, "Failed to allocate large.");
+		goto end;
+	}
+	memset(large, 0, 0x40000);
+
+	if(!arena.large || arena.end != end || arena.end->next)
+	{
+		cymbFail(context, "Large allocations should not be regions.");
+	}
+
+	cymbArenaRestore(&arena, save);
+	if(arena.large || arena.end != end)
+	{
+		cymbFail(context, "Failed to restore.");
+	}
+
+	if(!cymbArenaAllocate(&arena, 0x40000, 1) || !arena.large)
+	{
+		cymbFail(context, "Failed to allocate large.");
+		goto end;
+	}
+
+	// Restoring an empty arena keeps its regions.
+	const CymbRegion* const start = arena.start;
+	cymbArenaRestore(&arena, emptySave);
+	if(arena.start != start || arena.end != start || start->size != 0 || arena.large)
+	{
+		cymbFail(context, "Failed to restore to empty.");
+	}
+
+	if(cymbArenaAllocate(&arena, 1, 1) != start->data)
+	{
+		cymbFail(context, "Regions should be reused.");
+	}
+
+	// Trimming with no retained size only keeps the first region.
+	cymbArenaClear(&arena);
+	cymbArenaTrim(&arena, (CymbRetention){
+		.keepFirstRegion = true
+	});
+	if(arena.start != start || arena.end != start || start->next || arena.stats.regionCount != 1)
+	{
+		cymbFail(context, "Failed to trim.");
+	}
+
+	cymbArenaTrim(&arena, (CymbRetention){});
+	if(arena.start || arena.end || arena.stats.size != 0)
+	{
+		cymbFail(context, "Failed to trim the first region.");
+	}
+
+	end:
+	cymbArenaFree(&arena);
+
+	cymbContextPop(context);
+}
+
+/*
+ * Fill and check pooled arenas concurrently.
+ *
+ * Parameters:
+ * - poolVoid: The pool.
+ *
+ * Returns:
+ * - 0 on success.
+ * - 1 if an allocation failed or was overwritten.
+ */
+static int cymbTestPoolThread(void* const poolVoid)
+{
+	int result = 0;
+
+	CymbArena arena;
+	cymbArenaCreatePooled(&arena, poolVoid);
+
+	for(unsigned int round = 0; round < 0x20 && result == 0; ++round)
+	{
+		unsigned char* allocations[0x40];
+		const size_t size = 0x40 << (round % 10);
+
+		for(size_t allocationIndex = 0; allocationIndex < CYMB_LENGTH(allocations); ++allocationIndex)
+		{
+			allocations[allocationIndex] = cymbArenaAllocate(&arena, size, 1);
+			if(!allocations[allocationIndex])
+			{
+				result = 1;
+				goto end;
+			}
+			memset(allocations[allocationIndex], (unsigned char)allocationIndex, size);
+		}
+
+		for(size_t allocationIndex = 0; allocationIndex < CYMB_LENGTH(allocations); ++allocationIndex)
+		{
+			for(size_t index = 0; index < size; ++index)
+			{
+				if(allocations[allocationIndex][index] != (unsigned char)allocationIndex)
+				{
+					result = 1;
+				}
+			}
+		}
+
+		cymbArenaClear(&arena);
+		cymbArenaTrim(&arena, (CymbRetention){});
+	}
+
+	end:
+	cymbArenaFree(&arena);
+
+	return result;
+}
+
+static void cymbTestRegionPool(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	CymbRegionPool pool;
+	if(cymbRegionPoolCreate(&pool, 0x1000000) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to create the pool.");
+		cymbContextPop(context);
+		return;
+	}
+
+	CymbArena first;
+	cymbArenaCreatePooled(&first, &pool);
+	CymbArena second;
+	cymbArenaCreatePooled(&second, &pool);
+
+	thrd_t threads[4];
+	size_t threadCount = 0;
+
+	const void* const allocation = cymbArenaAllocate(&first, 0x100, 1);
+	if(!allocation || !cymbArenaAllocate(&first, 0x20000, 1))
+	{
+		cymbFail(context, "Failed to allocate.");
+		goto end;
+	}
+
+	// Clearing keeps the regions, trimming returns them to the pool.
+	cymbArenaClear(&first);
+	if(first.start != first.end || first.large)
+	{
+		cymbFail(context, "Regions should be kept.");
+	}
+	cymbArenaTrim(&first, (CymbRetention){});
+	if(first.start || first.large || atomic_load(&pool.size) == 0)
+	{
+		cymbFail(context, "Regions should be returned.");
+	}
+
+	// Another arena reuses them.
+	if(cymbArenaAllocate(&second, 0x100, 1) != allocation)
+	{
+		cymbFail(context, "Regions should be reused.");
+	}
+
+	// Regions past the maximum size are freed.
+	if(!cymbArenaAllocate(&second, 0x2000000, 1))
+	{
+		cymbFail(context, "Failed to allocate.");
+		goto end;
+	}
+	cymbArenaFree(&second);
+	if(atomic_load(&pool.size) > pool.maxSize)
+	{
+		cymbFail(context, "Pool should be bounded.");
+	}
+
+	for(; threadCount < CYMB_LENGTH(threads); ++threadCount)
+	{
+		if(thrd_create(&threads[threadCount], cymbTestPoolThread, &pool) != thrd_success)
+		{
+			cymbFail(context, "Failed to create a thread.");
+			break;
+		}
+	}
+
+	for(size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+	{
+		cymbContextSetIndex(context, threadIndex);
+
+		int threadResult;
+		if(thrd_join(threads[threadIndex], &threadResult) != thrd_success || threadResult != 0)
+		{
+			cymbFail(context, "Failed to use pooled arena.");
+		}
+	}
+
+	// Trimming the pool frees the regions past the retained size, smaller ones first.
+	cymbRegionPoolTrim(&pool, 0x10000);
+	if(atomic_load(&pool.size) > 0x10000 || !pool.classes[0])
+	{
+		cymbFail(context, "Failed to trim the pool.");
+	}
+
+	cymbRegionPoolTrim(&pool, 0);
+	if(atomic_load(&pool.size) != 0)
+	{
+		cymbFail(context, "Failed to empty the pool.");
+	}
+
+	end:
+	cymbArenaFree(&first);
+	cymbArenaFree(&second);
+	cymbRegionPoolFree(&pool);
+
+	cymbContextPop(context);
+}
+
+static void cymbTestArray(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	CymbArray array;
+	cymbArrayCreate(&array, sizeof(uint32_t));
+
+	// Grow well past the size at which arrays are mapped.
+	constexpr uint32_t count = 0x40000;
+	for(uint32_t value = 0; value < count; ++value)
+	{
+		uint32_t* const element = cymbArrayPush(&array, 1);
+		if(!element)
+		{
+			cymbFail(context, "Failed to push.");
+			goto end;
+		}
+		*element = value;
+	}
+
+	if(array.count != count || array.capacity < count)
+	{
+		cymbFail(context, "Wrong count.");
+	}
+
+	for(uint32_t value = 0; value < count; ++value)
+	{
+		if(((const uint32_t*)array.data)[value] != value)
+		{
+			cymbFail(context, "Wrong element.");
+			break;
+		}
+	}
+
+	if(cymbArrayReserve(&array, count * 4) != CYMB_SUCCESS || array.capacity < count * 4 || ((const uint32_t*)array.data)[count - 1] != count - 1)
+	{
+		cymbFail(context, "Failed to reserve.");
+	}
+
+	end:
+	cymbArrayFree(&array);
+	if(array.data || array.count != 0 || array.elementSize != sizeof(uint32_t))
+	{
+		cymbFail(context, "Failed to free.");
+	}
+
+	cymbContextPop(context);
+}
+
 static void cymbTestMap(CymbTestContext* const context)
 {
 	const CymbArenaSave save = cymbArenaSave(&context->arena);
@@ -433,6 +1109,33 @@ static void cymbTestMap(CymbTestContext* const context)
 		goto error;
 	}
 
+	// Remove every other key, which shifts back the keys probed past them.
+	for(unsigned int offset = 0; offset < 26 * 26; offset += 2)
+	{
+		const CymbStringView key = {keys + offset * 2, 2};
+
+		if(!cymbMapRemove(&map, key) || cymbMapRemove(&map, key))
+		{
+			goto error;
+		}
+	}
+
+	if(map.count != 26 * 26 / 2)
+	{
+		goto error;
+	}
+
+	for(unsigned int offset = 0; offset < 26 * 26; ++offset)
+	{
+		const CymbStringView key = {keys + offset * 2, 2};
+
+		const unsigned int* const result = cymbMapRead(&map, key);
+		if(offset % 2 == 0 ? result != nullptr : !result || *result != offset)
+		{
+			goto error;
+		}
+	}
+
 	goto end;
 
 	error:
@@ -443,6 +1146,63 @@ static void cymbTestMap(CymbTestContext* const context)
 	cymbArenaRestore(&context->arena, save);
 }
 
+static void cymbTestInterner(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	CymbInterner interner;
+	if(cymbInternerCreate(&interner, &context->arena) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to create interner.");
+		goto end;
+	}
+
+	// The source buffer is overwritten to check the interned strings are copies.
+	char source[] = "main loop main";
+
+	uint32_t symbols[3];
+	const CymbStringView keys[] = {{source, 4}, {source + 5, 4}, {source + 10, 4}};
+	for(size_t keyIndex = 0; keyIndex < CYMB_LENGTH(keys); ++keyIndex)
+	{
+		cymbContextSetIndex(context, keyIndex);
+
+		if(cymbIntern(&interner, keys[keyIndex], &symbols[keyIndex]) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Failed to intern.");
+			goto clear;
+		}
+	}
+
+	if(symbols[0] != 0 || symbols[1] != 1 || symbols[2] != 0 || interner.count != 2)
+	{
+		cymbFail(context, "Wrong symbols.");
+	}
+
+	memset(source, '-', sizeof(source) - 1);
+
+	const CymbStringView name = cymbInternerString(&interner, symbols[1]);
+	if(name.length != 4 || strcmp(name.string, "loop") != 0)
+	{
+		cymbFail(context, "Wrong name.");
+	}
+
+	uint32_t symbol;
+	if(!cymbInternerFind(&interner, (CymbStringView)CYMB_STRING("main"), &symbol) || symbol != 0)
+	{
+		cymbFail(context, "Failed to find symbol.");
+	}
+	if(cymbInternerFind(&interner, (CymbStringView)CYMB_STRING("mai"), &symbol))
+	{
+		cymbFail(context, "Found missing symbol.");
+	}
+
+	clear:
+	cymbInternerFree(&interner);
+
+	end:
+	cymbContextPop(context);
+}
+
 int main(void)
 {
 	CymbTestContext context = {.passed = true};
@@ -450,14 +1210,21 @@ int main(void)
 	cymbDiagnosticListCreate(&context.diagnostics, &context.arena, "cymb_test", 4);
 
 	cymbTestTab(&context);
+	cymbTestLocate(&context);
+	cymbTestRender(&context);
 
 	cymbTestFind(&context);
 
 	cymbTestArguments(&context);
 
 	cymbTestMurmur3(&context);
+	cymbTestHash(&context);
 
+	cymbTestArena(&context);
+	cymbTestRegionPool(&context);
+	cymbTestArray(&context);
 	cymbTestMap(&context);
+	cymbTestInterner(&context);
 
 	cymbTestLexs(&context);
 	cymbTestTrees(&context);
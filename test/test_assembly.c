@@ -31,7 +31,7 @@ static void cymbDoAssemblyTest(const CymbAssemblyTest* const test, CymbTestConte
 			cymbFail(context, "Wrong result.");
 		}
 
-		free(codes);
+		cymbArrayDataFree(codes);
 
 		goto end;
 	}
@@ -14,6 +14,7 @@ typedef struct CymbLexTest
 	const char* string;
 	CymbResult result;
 	CymbToken solution;
+	CymbConstant constant;
 	CymbDiagnosticList diagnostics;
 	CymbReader reader;
 } CymbLexTest;
@@ -36,26 +37,30 @@ void cymbCompareDiagnosticInfo(const CymbDiagnosticInfo* const first, const Cymb
 	}
 }
 
-static void cymbCompareTokens(const CymbToken* const first, const CymbToken* const second, CymbTestContext* const context)
+static void cymbCompareConstants(const CymbConstant* const first, const CymbConstant* const second, CymbTestContext* const context)
 {
 	if(first->type != second->type)
 	{
-		cymbFail(context, "Wrong token type.");
+		cymbFail(context, "Wrong constant type.");
 	}
-	else if(first->type == CYMB_TOKEN_CONSTANT)
+
+	if(first->value != second->value)
 	{
-		if(first->constant.type != second->constant.type)
-		{
-			cymbFail(context, "Wrong constant type.");
-		}
+		cymbFail(context, "Wrong constant value.");
+	}
+}
 
-		if(first->constant.value != second->constant.value)
-		{
-			cymbFail(context, "Wrong constant value.");
-		}
+static void cymbCompareTokens(const CymbToken* const first, const CymbToken* const second, CymbTestContext* const context)
+{
+	if(first->type != second->type)
+	{
+		cymbFail(context, "Wrong token type.");
 	}
 
-	cymbCompareDiagnosticInfo(&first->info, &second->info, context);
+	if(first->offset != second->offset || first->length != second->length)
+	{
+		cymbFail(context, "Wrong token bounds.");
+	}
 }
 
 void cymbCompareDiagnostics(const CymbDiagnosticList* const first, const CymbDiagnosticList* const second, CymbTestContext* const context)
@@ -103,18 +108,15 @@ static void cymbDoLexTest(const CymbLexTest* const test, const CymbLexFunction t
 {
 	const CymbArenaSave save = cymbArenaSave(&context->arena);
 
+	cymbDiagnosticListSetSource(&context->diagnostics, test->string);
+
 	CymbReader reader;
 	cymbReaderCreate(test->string, context->diagnostics.tabWidth, &reader);
 
-	CymbToken token = {
-		.info = {
-			.position = reader.position,
-			.line = reader.line,
-			.hint.string = reader.string
-		}
-	};
+	CymbToken token = {};
+	CymbConstant constant = {};
 
-	const CymbResult result = testFunction(&reader, &token, &context->diagnostics);
+	const CymbResult result = testFunction(&reader, &token, &constant, &context->diagnostics);
 
 	if(result != test->result)
 	{
@@ -146,6 +148,10 @@ static void cymbDoLexTest(const CymbLexTest* const test, const CymbLexFunction t
 	}
 
 	cymbCompareTokens(&token, &test->solution, context);
+	if(token.type == CYMB_TOKEN_CONSTANT)
+	{
+		cymbCompareConstants(&constant, &test->constant, context);
+	}
 	cymbCompareDiagnostics(&context->diagnostics, &test->diagnostics, context);
 
 	end:
@@ -180,11 +186,8 @@ static void cymbTestStrings(CymbTestContext* const context)
 		}},
 		{.string = "\"string\"", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_STRING,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[4].string, 8},
-				.hint = {tests[4].string, 8}
-			}
+			.offset = 0,
+			.length = 8
 		}, .reader = {
 			.string = tests[4].string + 8,
 			.position = {1, 9},
@@ -192,11 +195,8 @@ static void cymbTestStrings(CymbTestContext* const context)
 		}},
 		{.string = "\"st\x01ri\nng\"", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_STRING,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[5].string, 6},
-				.hint = {tests[5].string, 6}
-			}
+			.offset = 0,
+			.length = 6
 		}, .diagnostics = {}, .reader = {
 			.string = tests[5].string + 6,
 			.position = {1, 7},
@@ -204,11 +204,8 @@ static void cymbTestStrings(CymbTestContext* const context)
 		}},
 		{.string = "\"string\\\"", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_STRING,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[6].string, 9},
-				.hint = {tests[6].string, 9}
-			}
+			.offset = 0,
+			.length = 9
 		}, .diagnostics = {}, .reader = {
 			.string = tests[6].string + 9,
 			.position = {1, 10},
@@ -292,32 +289,18 @@ static void cymbTestCharacters(CymbTestContext* const context)
 		}},
 		{.string = "'c'", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {
-				.type = CYMB_CONSTANT_INT,
-				.value = 'c'
-			},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[5].string, 3},
-				.hint = {tests[5].string, 3}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 3
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 'c'}, .reader = {
 			.string = tests[5].string + 3,
 			.position = {1, 4},
 			.line = {tests[5].string, 3}
 		}},
 		{.string = "'a\n'", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {
-				.type = CYMB_CONSTANT_INT,
-				.value = 'a'
-			},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[6].string, 2},
-				.hint = {tests[6].string, 2}
-			}
-		}, .diagnostics = {}, .reader = {
+			.offset = 0,
+			.length = 2
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 'a'}, .diagnostics = {}, .reader = {
 			.string = tests[6].string + 2,
 			.position = {1, 3},
 			.line = {tests[6].string, 2}
@@ -359,11 +342,8 @@ static void cymbTestPunctuators(CymbTestContext* const context)
 		}},
 		{.string = "+=", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_PLUS_EQUAL,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[1].string, 2},
-				.hint = {tests[1].string, 2}
-			}
+			.offset = 0,
+			.length = 2
 		}, .reader = {
 			.string = tests[1].string + 2,
 			.position = {1, 3},
@@ -371,11 +351,8 @@ static void cymbTestPunctuators(CymbTestContext* const context)
 		}},
 		{.string = "+++", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_PLUS_PLUS,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[2].string, 3},
-				.hint = {tests[2].string, 2}
-			}
+			.offset = 0,
+			.length = 2
 		}, .reader = {
 			.string = tests[2].string + 2,
 			.position = {1, 3},
@@ -383,11 +360,8 @@ static void cymbTestPunctuators(CymbTestContext* const context)
 		}},
 		{.string = "+-", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_PLUS,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[3].string, 2},
-				.hint = {tests[3].string, 1}
-			}
+			.offset = 0,
+			.length = 1
 		}, .reader = {
 			.string = tests[3].string + 1,
 			.position = {1, 2},
@@ -395,11 +369,8 @@ static void cymbTestPunctuators(CymbTestContext* const context)
 		}},
 		{.string = "[{()}]", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_OPEN_BRACKET,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[4].string, 6},
-				.hint = {tests[4].string, 1}
-			}
+			.offset = 0,
+			.length = 1
 		}, .reader = {
 			.string = tests[4].string + 1,
 			.position = {1, 2},
@@ -424,6 +395,51 @@ static void cymbTestPunctuators(CymbTestContext* const context)
 			.string = tests[8].string,
 			.position = {1, 1},
 			.line = {tests[8].string, 3}
+		}},
+		{.string = "<<=", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_LEFT_SHIFT_EQUAL,
+			.offset = 0,
+			.length = 3
+		}, .reader = {
+			.string = tests[9].string + 3,
+			.position = {1, 4},
+			.line = {tests[9].string, 3}
+		}},
+		{.string = ">>x", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_RIGHT_SHIFT,
+			.offset = 0,
+			.length = 2
+		}, .reader = {
+			.string = tests[10].string + 2,
+			.position = {1, 3},
+			.line = {tests[10].string, 3}
+		}},
+		{.string = "->>", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_ARROW,
+			.offset = 0,
+			.length = 2
+		}, .reader = {
+			.string = tests[11].string + 2,
+			.position = {1, 3},
+			.line = {tests[11].string, 3}
+		}},
+		{.string = "<=<", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_LESS_EQUAL,
+			.offset = 0,
+			.length = 2
+		}, .reader = {
+			.string = tests[12].string + 2,
+			.position = {1, 3},
+			.line = {tests[12].string, 3}
+		}},
+		{.string = "!!", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_EXCLAMATION,
+			.offset = 0,
+			.length = 1
+		}, .reader = {
+			.string = tests[13].string + 1,
+			.position = {1, 2},
+			.line = {tests[13].string, 2}
 		}}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
@@ -438,6 +454,51 @@ static void cymbTestPunctuators(CymbTestContext* const context)
 	cymbContextPop(context);
 }
 
+static void cymbTestPunctuatorTable(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	// Each character is followed by each punctuator, so that every lookahead of up to two characters is checked against the table.
+	for(unsigned int character = 1; character <= UCHAR_MAX; ++character)
+	{
+		cymbContextSetIndex(context, character);
+
+		for(size_t suffixIndex = 0; suffixIndex <= cymbPunctuatorCount; ++suffixIndex)
+		{
+			char string[8];
+			snprintf(string, sizeof(string), "%c%s", (char)character, suffixIndex == cymbPunctuatorCount ? "" : cymbPunctuators[suffixIndex].string.string);
+
+			const CymbPunctuator* solution = nullptr;
+			for(size_t punctuatorIndex = 0; punctuatorIndex < cymbPunctuatorCount; ++punctuatorIndex)
+			{
+				if(strncmp(string, cymbPunctuators[punctuatorIndex].string.string, cymbPunctuators[punctuatorIndex].string.length) == 0)
+				{
+					solution = &cymbPunctuators[punctuatorIndex];
+					break;
+				}
+			}
+
+			CymbReader reader;
+			cymbReaderCreate(string, 4, &reader);
+			CymbToken token = {};
+			const CymbResult result = cymbParsePunctuator(&reader, &token, nullptr, &context->diagnostics);
+
+			if(result != (solution ? CYMB_SUCCESS : CYMB_NO_MATCH))
+			{
+				cymbFail(context, "Wrong result.");
+				continue;
+			}
+
+			if(solution && (token.type != solution->type || token.length != solution->string.length || reader.string != string + solution->string.length))
+			{
+				cymbFail(context, "Wrong punctuator.");
+			}
+		}
+	}
+
+	cymbContextPop(context);
+}
+
 static void cymbTestConstants(CymbTestContext* const context)
 {
 	cymbContextPush(context, __func__);
@@ -460,52 +521,36 @@ static void cymbTestConstants(CymbTestContext* const context)
 		}},
 		{.string = "57", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 57},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[3].string, 2},
-				.hint = {tests[3].string, 2}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 2
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 57}, .reader = {
 			.string = tests[3].string + 2,
 			.position = {1, 3},
 			.line = {tests[3].string, 2}
 		}},
 		{.string = "57llu", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG, .value = 57},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[4].string, 5},
-				.hint = {tests[4].string, 5}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 5
+		}, .constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG, .value = 57}, .reader = {
 			.string = tests[4].string + 5,
 			.position = {1, 6},
 			.line = {tests[4].string, 5}
 		}},
 		{.string = "0x42L", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_LONG, .value = 0x42},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[5].string, 5},
-				.hint = {tests[5].string, 5}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 5
+		}, .constant = {.type = CYMB_CONSTANT_LONG, .value = 0x42}, .reader = {
 			.string = tests[5].string + 5,
 			.position = {1, 6},
 			.line = {tests[5].string, 5}
 		}},
 		{.string = "0 a", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 0},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[6].string, 3},
-				.hint = {tests[6].string, 1}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 1
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 0}, .reader = {
 			.string = tests[6].string + 1,
 			.position = {1, 2},
 			.line = {tests[6].string, 3}
@@ -517,65 +562,45 @@ static void cymbTestConstants(CymbTestContext* const context)
 		}},
 		{.string = "0xyz", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 0},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[8].string, 4},
-				.hint = {tests[8].string, 4}
-			}
-		}, .diagnostics = {}, .reader = {
+			.offset = 0,
+			.length = 4
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 0}, .diagnostics = {}, .reader = {
 			.string = tests[8].string + 4,
 			.position = {1, 5},
 			.line = {tests[8].string, 4}
 		}},
 		{.string = "0'1'23'4", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 01234},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[9].string, 8},
-				.hint = {tests[9].string, 8}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 8
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 01234}, .reader = {
 			.string = tests[9].string + 8,
 			.position = {1, 9},
 			.line = {tests[9].string, 8}
 		}},
 		{.string = "0x'12''3'''4'\n", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 0x1234},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[10].string, 13},
-				.hint = {tests[10].string, 13}
-			}
-		}, .diagnostics = {}, .reader = {
+			.offset = 0,
+			.length = 13
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 0x1234}, .diagnostics = {}, .reader = {
 			.string = tests[10].string + 13,
 			.position = {1, 14},
 			.line = {tests[10].string, 13}
 		}},
 		{.string = "0b'''101'''lu", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG, .value = 0b101},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[11].string, 13},
-				.hint = {tests[11].string, 13}
-			}
-		}, .diagnostics = {}, .reader = {
+			.offset = 0,
+			.length = 13
+		}, .constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG, .value = 0b101}, .diagnostics = {}, .reader = {
 			.string = tests[11].string + 13,
 			.position = {1, 14},
 			.line = {tests[11].string, 13}
 		}},
 		{.string = "0b''", .result = CYMB_INVALID, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 0},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[12].string, 4},
-				.hint = {tests[12].string, 2}
-			}
-		}, .diagnostics = {}, .reader = {
+			.offset = 0,
+			.length = 2
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 0}, .diagnostics = {}, .reader = {
 			.string = tests[12].string + 2,
 			.position = {1, 3},
 			.line = {tests[12].string, 4}
@@ -586,21 +611,43 @@ static void cymbTestConstants(CymbTestContext* const context)
 			.line = {tests[13].string, 3}
 		}},
 		{.result = CYMB_INVALID, .solution = {
-			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {CYMB_CONSTANT_INT, 0}
-		}},
+			.type = CYMB_TOKEN_CONSTANT
+		}, .constant = {CYMB_CONSTANT_INT, 0}},
 		{.string = "011", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_CONSTANT,
-			.constant = {.type = CYMB_CONSTANT_INT, .value = 9},
-			.info = {
-				.position = {1, 1},
-				.line = {tests[15].string, 3},
-				.hint = {tests[15].string, 3}
-			}
-		}, .reader = {
+			.offset = 0,
+			.length = 3
+		}, .constant = {.type = CYMB_CONSTANT_INT, .value = 9}, .reader = {
 			.string = tests[15].string + 3,
 			.position = {1, 4},
 			.line = {tests[15].string, 3}
+		}},
+		{.string = "12345678901234567;", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_CONSTANT,
+			.offset = 0,
+			.length = 17
+		}, .constant = {.type = CYMB_CONSTANT_LONG, .value = 12345678901234567}, .reader = {
+			.string = tests[16].string + 17,
+			.position = {1, 18},
+			.line = {tests[16].string, 18}
+		}},
+		{.string = "0xDEADbeef01234567", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_CONSTANT,
+			.offset = 0,
+			.length = 18
+		}, .constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG, .value = 0xDEADBEEF01234567}, .reader = {
+			.string = tests[17].string + 18,
+			.position = {1, 19},
+			.line = {tests[17].string, 18}
+		}},
+		{.string = "0xaBcDeF'0123456789", .result = CYMB_SUCCESS, .solution = {
+			.type = CYMB_TOKEN_CONSTANT,
+			.offset = 0,
+			.length = 19
+		}, .constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG_LONG, .value = 0xABCDEF0123456789}, .reader = {
+			.string = tests[18].string + 19,
+			.position = {1, 20},
+			.line = {tests[18].string, 19}
 		}}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
@@ -726,11 +773,7 @@ static void cymbTestConstants(CymbTestContext* const context)
 		goto clear;
 	}
 	tests[14].string = string14;
-	tests[14].solution.info = (CymbDiagnosticInfo){
-		.position = {1, 1},
-		.line = {string14, length14},
-		.hint = {string14, length14}
-	};
+	tests[14].solution.length = length14;
 	tests[14].reader = (CymbReader){
 		.string = string14 + length14,
 		.position = {1, length14 + 1},
@@ -774,11 +817,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "int", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_INT,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[1].string, 3},
-				.hint = {tests[1].string, 3}
-			}
+			.offset = 0,
+			.length = 3
 		}, .reader = {
 			.string = tests[1].string + 3,
 			.position = {1, 4},
@@ -786,11 +826,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "int5a", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_IDENTIFIER,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[2].string, 5},
-				.hint = {tests[2].string, 5},
-			}
+			.offset = 0,
+			.length = 5
 		}, .reader = {
 			.string = tests[2].string + 5,
 			.position = {1, 6},
@@ -798,11 +835,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "int_t", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_IDENTIFIER,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[3].string, 5},
-				.hint = {tests[3].string, 5},
-			}
+			.offset = 0,
+			.length = 5
 		}, .reader = {
 			.string = tests[3].string + 5,
 			.position = {1, 6},
@@ -820,11 +854,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "_my_var_", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_IDENTIFIER,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[6].string, 8},
-				.hint = {tests[6].string, 8},
-			}
+			.offset = 0,
+			.length = 8
 		}, .reader = {
 			.string = tests[6].string + 8,
 			.position = {1, 9},
@@ -837,11 +868,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "fl;oat", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_IDENTIFIER,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[8].string, 6},
-				.hint = {tests[8].string, 2},
-			}
+			.offset = 0,
+			.length = 2
 		}, .reader = {
 			.string = tests[8].string + 2,
 			.position = {1, 3},
@@ -849,11 +877,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "float{}", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_FLOAT,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[9].string, 7},
-				.hint = {tests[9].string, 5}
-			}
+			.offset = 0,
+			.length = 5
 		}, .reader = {
 			.string = tests[9].string + 5,
 			.position = {1, 6},
@@ -861,11 +886,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "do int", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_DO,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[10].string, 6},
-				.hint = {tests[10].string, 2}
-			}
+			.offset = 0,
+			.length = 2
 		}, .reader = {
 			.string = tests[10].string + 2,
 			.position = {1, 3},
@@ -873,11 +895,8 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 		}},
 		{.string = "double", .result = CYMB_SUCCESS, .solution = {
 			.type = CYMB_TOKEN_DOUBLE,
-			.info = {
-				.position = {1, 1},
-				.line = {tests[11].string, 6},
-				.hint = {tests[11].string, 6}
-			}
+			.offset = 0,
+			.length = 6
 		}, .reader = {
 			.string = tests[11].string + 6,
 			.position = {1, 7},
@@ -896,6 +915,116 @@ static void cymbTestIdentifiers(CymbTestContext* const context)
 	cymbContextPop(context);
 }
 
+static void cymbTestKeywords(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const struct
+	{
+		const char* string;
+		CymbTokenType type;
+		CymbStandard standard;
+	} tests[] = {
+		{"void", CYMB_TOKEN_VOID, CYMB_C90},
+		{"_Bool", CYMB_TOKEN__BOOL, CYMB_C99},
+		{"bool", CYMB_TOKEN_BOOL, CYMB_C23},
+		{"false", CYMB_TOKEN_FALSE, CYMB_C23},
+		{"true", CYMB_TOKEN_TRUE, CYMB_C23},
+		{"char", CYMB_TOKEN_CHAR, CYMB_C90},
+		{"short", CYMB_TOKEN_SHORT, CYMB_C90},
+		{"int", CYMB_TOKEN_INT, CYMB_C90},
+		{"long", CYMB_TOKEN_LONG, CYMB_C90},
+		{"float", CYMB_TOKEN_FLOAT, CYMB_C90},
+		{"double", CYMB_TOKEN_DOUBLE, CYMB_C90},
+		{"_Decimal32", CYMB_TOKEN__DECIMAL_32, CYMB_C23},
+		{"_Decimal64", CYMB_TOKEN__DECIMAL_64, CYMB_C23},
+		{"_Decimal128", CYMB_TOKEN__DECIMAL_128, CYMB_C23},
+		{"_Complex", CYMB_TOKEN__COMPLEX, CYMB_C99},
+		{"_Imaginary", CYMB_TOKEN__IMAGINARY, CYMB_C99},
+		{"signed", CYMB_TOKEN_SIGNED, CYMB_C90},
+		{"unsigned", CYMB_TOKEN_UNSIGNED, CYMB_C90},
+		{"const", CYMB_TOKEN_CONST, CYMB_C90},
+		{"constexpr", CYMB_TOKEN_CONSTEXPR, CYMB_C23},
+		{"volatile", CYMB_TOKEN_VOLATILE, CYMB_C90},
+		{"static", CYMB_TOKEN_STATIC, CYMB_C90},
+		{"extern", CYMB_TOKEN_EXTERN, CYMB_C90},
+		{"auto", CYMB_TOKEN_AUTO, CYMB_C90},
+		{"register", CYMB_TOKEN_REGISTER, CYMB_C90},
+		{"restrict", CYMB_TOKEN_RESTRICT, CYMB_C99},
+		{"typedef", CYMB_TOKEN_TYPEDEF, CYMB_C90},
+		{"typeof", CYMB_TOKEN_TYPEOF, CYMB_C23},
+		{"typeof_unqual", CYMB_TOKEN_TYPEOF_UNQUAL, CYMB_C23},
+		{"struct", CYMB_TOKEN_STRUCT, CYMB_C90},
+		{"union", CYMB_TOKEN_UNION, CYMB_C90},
+		{"enum", CYMB_TOKEN_ENUM, CYMB_C90},
+		{"_Atomic", CYMB_TOKEN__ATOMIC, CYMB_C11},
+		{"_Generic", CYMB_TOKEN__GENERIC, CYMB_C11},
+		{"_BitInt", CYMB_TOKEN__BIT_INT, CYMB_C23},
+		{"_Thread_local", CYMB_TOKEN__THREAD_LOCAL, CYMB_C11},
+		{"thread_local", CYMB_TOKEN_THREAD_LOCAL, CYMB_C23},
+		{"return", CYMB_TOKEN_RETURN, CYMB_C90},
+		{"_Static_assert", CYMB_TOKEN__STATIC_ASSERT, CYMB_C11},
+		{"static_assert", CYMB_TOKEN_STATIC_ASSERT, CYMB_C23},
+		{"sizeof", CYMB_TOKEN_SIZEOF, CYMB_C90},
+		{"_Alignas", CYMB_TOKEN__ALIGNAS, CYMB_C11},
+		{"alignas", CYMB_TOKEN_ALIGNAS, CYMB_C23},
+		{"_Alignof", CYMB_TOKEN__ALIGNOF, CYMB_C11},
+		{"alignof", CYMB_TOKEN_ALIGNOF, CYMB_C23},
+		{"if", CYMB_TOKEN_IF, CYMB_C90},
+		{"else", CYMB_TOKEN_ELSE, CYMB_C90},
+		{"switch", CYMB_TOKEN_SWITCH, CYMB_C90},
+		{"case", CYMB_TOKEN_CASE, CYMB_C90},
+		{"default", CYMB_TOKEN_DEFAULT, CYMB_C90},
+		{"while", CYMB_TOKEN_WHILE, CYMB_C90},
+		{"do", CYMB_TOKEN_DO, CYMB_C90},
+		{"for", CYMB_TOKEN_FOR, CYMB_C90},
+		{"break", CYMB_TOKEN_BREAK, CYMB_C90},
+		{"continue", CYMB_TOKEN_CONTINUE, CYMB_C90},
+		{"goto", CYMB_TOKEN_GOTO, CYMB_C90}
+	};
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	const CymbStandard standards[] = {CYMB_C90, CYMB_C95, CYMB_C99, CYMB_C11, CYMB_C17, CYMB_C23};
+	constexpr size_t standardCount = CYMB_LENGTH(standards);
+
+	CymbInterner interner;
+	if(cymbInternerCreate(&interner, &context->arena) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to create interner.");
+		goto end;
+	}
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		for(size_t standardIndex = 0; standardIndex < standardCount; ++standardIndex)
+		{
+			CymbTokenList tokens;
+			const CymbResult result = cymbLex(tests[testIndex].string, standards[standardIndex], &interner, &tokens, &context->diagnostics);
+			if(result != CYMB_SUCCESS || tokens.count != 1)
+			{
+				cymbFail(context, "Wrong result.");
+				cymbFreeTokenList(&tokens);
+				continue;
+			}
+
+			const CymbTokenType type = standards[standardIndex] >= tests[testIndex].standard ? tests[testIndex].type : CYMB_TOKEN_IDENTIFIER;
+			if(tokens.tokens[0].type != type)
+			{
+				cymbFail(context, "Wrong token type.");
+			}
+
+			cymbFreeTokenList(&tokens);
+		}
+	}
+
+	cymbInternerFree(&interner);
+
+	end:
+	cymbContextPop(context);
+}
+
 static void cymbTestLex(CymbTestContext* const context)
 {
 	cymbContextPush(context, __func__);
@@ -915,27 +1044,18 @@ static void cymbTestLex(CymbTestContext* const context)
 			.tokens = (CymbToken[]){
 				{
 					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = {tests[1].string, 5},
-						.hint = {tests[1].string, 1}
-					}
+					.offset = 0,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 3},
-						.line = {tests[1].string, 5},
-						.hint = {tests[1].string + 2, 1}
-					}
+					.offset = 2,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = {tests[1].string, 5},
-						.hint = {tests[1].string + 4, 1}
-					}
+					.offset = 4,
+					.length = 1
 				}
 			},
 			.count = 3
@@ -944,134 +1064,154 @@ static void cymbTestLex(CymbTestContext* const context)
 			.tokens = (CymbToken[]){
 				{
 					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string, 1}
-					}
+					.offset = 0,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_MINUS,
-					.info = {
-						.position = {1, 2},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 1, 1}
-					}
+					.offset = 1,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_STAR_EQUAL,
-					.info = {
-						.position = {1, 3},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 2, 2}
-					}
+					.offset = 2,
+					.length = 2
 				},
 				{
 					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 4, 1}
-					}
+					.offset = 4,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_OPEN_BRACKET,
-					.info = {
-						.position = {1, 6},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 5, 1}
-					}
+					.offset = 5,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_STRING,
-					.info = {
-						.position = {1, 7},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 6, 3}
-					}
+					.offset = 6,
+					.length = 3
 				},
 				{
 					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {.type = CYMB_CONSTANT_INT, .value = 'c'},
-					.info = {
-						.position = {1, 10},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 9, 3}
-					}
+					.offset = 9,
+					.length = 3,
+					.constant = 0
 				},
 				{
 					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {.type = CYMB_CONSTANT_UNSIGNED_LONG, .value = 5},
-					.info = {
-						.position = {1, 13},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 12, 3}
-					}
+					.offset = 12,
+					.length = 3,
+					.constant = 1
 				},
 				{
 					.type = CYMB_TOKEN_SLASH,
-					.info = {
-						.position = {1, 16},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 15, 1}
-					}
+					.offset = 15,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 17},
-						.line = {tests[2].string, 17},
-						.hint = {tests[2].string + 16, 1}
-					}
+					.offset = 16,
+					.length = 1
 				}
 			},
-			.count = 10
+			.count = 10,
+			.constants = (CymbConstant[]){{.type = CYMB_CONSTANT_INT, .value = 'c'}, {.type = CYMB_CONSTANT_UNSIGNED_LONG, .value = 5}}
 		}, .valid = true},
 		{.string = "int a = 0xyz;", .tokens = {
 			.tokens = (CymbToken[]){
 				{
 					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 1},
-						.line = {tests[3].string, 13},
-						.hint = {tests[3].string, 3}
-					}
+					.offset = 0,
+					.length = 3
 				},
 				{
 					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = {tests[3].string, 13},
-						.hint = {tests[3].string + 4, 1}
-					}
+					.offset = 4,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_EQUAL,
-					.info = {
-						.position = {1, 7},
-						.line = {tests[3].string, 13},
-						.hint = {tests[3].string + 6, 1}
-					}
+					.offset = 6,
+					.length = 1
 				},
 				{
 					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {.type = CYMB_CONSTANT_INT, .value = 0},
-					.info = {
-						.position = {1, 9},
-						.line = {tests[3].string, 13},
-						.hint = {tests[3].string + 8, 4}
-					}
+					.offset = 8,
+					.length = 4,
+					.constant = 0
 				},
 				{
 					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 13},
-						.line = {tests[3].string, 13},
-						.hint = {tests[3].string + 12, 1}
-					}
+					.offset = 12,
+					.length = 1
+				}
+			},
+			.count = 5,
+			.constants = (CymbConstant[]){{.type = CYMB_CONSTANT_INT, .value = 0}}
+		}, .valid = false, .diagnostics = {}},
+		{.string = "a\n\tb @\nc", .tokens = {
+			.tokens = (CymbToken[]){
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 0,
+					.length = 1
+				},
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 3,
+					.length = 1
+				},
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 7,
+					.length = 1
+				}
+			},
+			.count = 3
+		}, .valid = false, .diagnostics = {}},
+		{.string = "a// x /* y\n/* z\n*/b/c/**/ //", .tokens = {
+			.tokens = (CymbToken[]){
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 0,
+					.length = 1
+				},
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 18,
+					.length = 1
+				},
+				{
+					.type = CYMB_TOKEN_SLASH,
+					.offset = 19,
+					.length = 1
+				},
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 20,
+					.length = 1
 				}
 			},
-			.count = 5
+			.count = 4
+		}, .valid = true},
+		{.string =
+			"x /* a * b ** c ****************************** d */ \n"
+			"\r\v\f                                        y /* never closed *",
+		.tokens = {
+			.tokens = (CymbToken[]){
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 0,
+					.length = 1
+				},
+				{
+					.type = CYMB_TOKEN_IDENTIFIER,
+					.offset = 96,
+					.length = 1
+				}
+			},
+			.count = 2
 		}, .valid = false, .diagnostics = {}}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
@@ -1088,14 +1228,45 @@ static void cymbTestLex(CymbTestContext* const context)
 	};
 	tests[3].diagnostics.start = diagnostics3;
 
+	CymbDiagnostic diagnostics4[] = {
+		{
+			.type = CYMB_UNKNOWN_TOKEN,
+			.info = {
+				.position = {2, 7},
+				.line = {tests[4].string + 2, 4},
+				.hint = {tests[4].string + 5, 1}
+			}
+		}
+	};
+	tests[4].diagnostics.start = diagnostics4;
+
+	CymbDiagnostic diagnostics6[] = {
+		{
+			.type = CYMB_UNFINISHED_COMMENT,
+			.info = {
+				.position = {2, 46},
+				.line = {tests[6].string + 53, 62},
+				.hint = {tests[6].string + 98, 2}
+			}
+		}
+	};
+	tests[6].diagnostics.start = diagnostics6;
+
 	const CymbArenaSave save = cymbArenaSave(&context->arena);
 
 	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
 	{
 		cymbContextSetIndex(context, testIndex);
 
+		CymbInterner interner;
+		if(cymbInternerCreate(&interner, &context->arena) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Failed to create interner.");
+			goto next;
+		}
+
 		CymbTokenList tokens;
-		const CymbResult result = cymbLex(tests[testIndex].string, &tokens, &context->diagnostics);
+		const CymbResult result = cymbLex(tests[testIndex].string, CYMB_C23, &interner, &tokens, &context->diagnostics);
 
 		if((tests[testIndex].valid && result != CYMB_SUCCESS) || (!tests[testIndex].valid && result != CYMB_INVALID))
 		{
@@ -1108,7 +1279,7 @@ static void cymbTestLex(CymbTestContext* const context)
 		if(tokens.count != tests[testIndex].tokens.count)
 		{
 			cymbFail(context, "Wrong token count.");
-			free(tokens.tokens);
+			cymbFreeTokenList(&tokens);
 			goto next;
 		}
 
@@ -1118,7 +1289,14 @@ static void cymbTestLex(CymbTestContext* const context)
 		{
 			cymbContextSetIndex(context, tokenIndex);
 
-			cymbCompareTokens(&tokens.tokens[tokenIndex], &tests[testIndex].tokens.tokens[tokenIndex], context);
+			const CymbToken* const token = &tokens.tokens[tokenIndex];
+			const CymbToken* const solution = &tests[testIndex].tokens.tokens[tokenIndex];
+
+			cymbCompareTokens(token, solution, context);
+			if(token->type == CYMB_TOKEN_CONSTANT && solution->type == CYMB_TOKEN_CONSTANT)
+			{
+				cymbCompareConstants(&tokens.constants[token->constant], &tests[testIndex].tokens.constants[solution->constant], context);
+			}
 		}
 		
 		cymbContextPop(context);
@@ -1126,6 +1304,7 @@ static void cymbTestLex(CymbTestContext* const context)
 		cymbFreeTokenList(&tokens);
 
 		next:
+		cymbInternerFree(&interner);
 		cymbArenaRestore(&context->arena, save);
 		cymbDiagnosticListFree(&context->diagnostics);
 	}
@@ -1133,12 +1312,380 @@ static void cymbTestLex(CymbTestContext* const context)
 	cymbContextPop(context);
 }
 
+static void cymbTestLexNext(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const char* const string = "a @ 12";
+
+	const struct
+	{
+		CymbResult result;
+		CymbToken token;
+	} tests[] = {
+		{CYMB_SUCCESS, {.type = CYMB_TOKEN_IDENTIFIER, .offset = 0, .length = 1}},
+		{CYMB_INVALID, {.type = CYMB_TOKEN_CONSTANT, .offset = 4, .length = 2}},
+		{CYMB_NO_MATCH, {}}
+	};
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	CymbDiagnostic diagnostics[] = {
+		{
+			.type = CYMB_UNKNOWN_TOKEN,
+			.info = {
+				.position = {1, 3},
+				.line = {string, 6},
+				.hint = {string + 2, 1}
+			}
+		}
+	};
+	const CymbDiagnosticList solution = {.start = diagnostics};
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbInterner interner;
+	if(cymbInternerCreate(&interner, &context->arena) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to create interner.");
+		goto end;
+	}
+
+	CymbLexer lexer;
+	cymbLexerCreate(&lexer, string, CYMB_C23, &interner, &context->diagnostics);
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		CymbToken token;
+		CymbConstant constant;
+		const CymbResult result = cymbLexNext(&lexer, &token, &constant);
+		if(result != tests[testIndex].result)
+		{
+			cymbFail(context, "Wrong result.");
+			continue;
+		}
+
+		if(result != CYMB_NO_MATCH)
+		{
+			cymbCompareTokens(&token, &tests[testIndex].token, context);
+		}
+	}
+
+	if(!lexer.invalid)
+	{
+		cymbFail(context, "Lexer should be invalid.");
+	}
+
+	cymbCompareDiagnostics(&context->diagnostics, &solution, context);
+
+	cymbInternerFree(&interner);
+
+	end:
+	cymbArenaRestore(&context->arena, save);
+	cymbDiagnosticListFree(&context->diagnostics);
+
+	cymbContextPop(context);
+}
+
+static void cymbTestLexParallel(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	// Comments, strings and invalid tokens are spread so that chunks start in all kinds of places.
+	const CymbStringView fragments[] = {
+		CYMB_STRING("int value = 0x1F'FF;\n"),
+		CYMB_STRING("/* comment\n * spanning \"lines\" with 'c' @\n */\n"),
+		CYMB_STRING("a = b + c * 12345678901234567; // trailing\n"),
+		CYMB_STRING("x @ y\n"),
+		CYMB_STRING("\"unfinished\n"),
+		CYMB_STRING("'ab' 0xyz\n"),
+		CYMB_STRING("s = \"text /* not a comment */\";\n"),
+		CYMB_STRING("/*/ tricky */ p /**/q\n"),
+		CYMB_STRING("\t\t  \n")
+	};
+	constexpr size_t fragmentCount = CYMB_LENGTH(fragments);
+
+	// A comment longer than a chunk, filled with what would be invalid tokens.
+	const CymbStringView longComment = CYMB_STRING("@ \"x\n");
+	constexpr size_t longCommentRepetitions = 0x10000;
+	constexpr size_t fragmentRepetitions = 0x8000;
+
+	const size_t capacity = fragmentRepetitions * 64 + longCommentRepetitions * longComment.length + 16;
+	char* const string = malloc(capacity);
+	if(!string)
+	{
+		cymbFail(context, "Failed to allocate the source.");
+		goto end;
+	}
+
+	size_t length = 0;
+	uint32_t random = 1;
+	for(size_t repetition = 0; repetition < fragmentRepetitions; ++repetition)
+	{
+		random = random * 1664525 + 1013904223;
+		const CymbStringView fragment = fragments[(random >> 16) % fragmentCount];
+		memcpy(string + length, fragment.string, fragment.length);
+		length += fragment.length;
+
+		if(repetition == fragmentRepetitions / 3)
+		{
+			memcpy(string + length, "/*", 2);
+			length += 2;
+			for(size_t commentRepetition = 0; commentRepetition < longCommentRepetitions; ++commentRepetition)
+			{
+				memcpy(string + length, longComment.string, longComment.length);
+				length += longComment.length;
+			}
+			memcpy(string + length, "*/", 2);
+			length += 2;
+		}
+	}
+	memcpy(string + length, "/* end", sizeof("/* end"));
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbDiagnosticList serialDiagnostics;
+	cymbDiagnosticListCreate(&serialDiagnostics, &context->arena, "cymb_test", 4);
+
+	CymbInterner serialInterner;
+	if(cymbInternerCreate(&serialInterner, &context->arena) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to create interner.");
+		goto restore;
+	}
+
+	CymbTokenList serialTokens;
+	const CymbResult serialResult = cymbLex(string, CYMB_C23, &serialInterner, &serialTokens, &serialDiagnostics);
+	if(serialResult != CYMB_INVALID)
+	{
+		cymbFail(context, "Wrong serial result.");
+		goto clear;
+	}
+
+	const unsigned int threadCounts[] = {2, 3, 8};
+	constexpr size_t testCount = CYMB_LENGTH(threadCounts);
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		CymbInterner interner;
+		if(cymbInternerCreate(&interner, &context->arena) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Failed to create interner.");
+			continue;
+		}
+
+		CymbTokenList tokens;
+		const CymbResult result = cymbLexParallel(string, CYMB_C23, threadCounts[testIndex], &interner, &tokens, &context->diagnostics);
+		if(result != serialResult)
+		{
+			cymbFail(context, "Wrong result.");
+			goto next;
+		}
+
+		cymbCompareDiagnostics(&context->diagnostics, &serialDiagnostics, context);
+
+		if(tokens.count != serialTokens.count)
+		{
+			cymbFail(context, "Wrong token count.");
+			goto next;
+		}
+
+		for(size_t tokenIndex = 0; tokenIndex < tokens.count; ++tokenIndex)
+		{
+			const CymbToken* const token = &tokens.tokens[tokenIndex];
+			const CymbToken* const solution = &serialTokens.tokens[tokenIndex];
+
+			if(token->type != solution->type || token->offset != solution->offset || token->length != solution->length)
+			{
+				cymbFail(context, "Wrong token.");
+				break;
+			}
+
+			if(token->type == CYMB_TOKEN_IDENTIFIER && token->symbol != solution->symbol)
+			{
+				cymbFail(context, "Wrong symbol.");
+				break;
+			}
+
+			if(token->type == CYMB_TOKEN_CONSTANT)
+			{
+				cymbCompareConstants(&tokens.constants[token->constant], &serialTokens.constants[solution->constant], context);
+			}
+		}
+
+		next:
+		cymbFreeTokenList(&tokens);
+		cymbInternerFree(&interner);
+		cymbDiagnosticListFree(&context->diagnostics);
+	}
+
+	clear:
+	cymbFreeTokenList(&serialTokens);
+	cymbInternerFree(&serialInterner);
+
+	restore:
+	cymbArenaRestore(&context->arena, save);
+	free(string);
+
+	end:
+	cymbContextPop(context);
+}
+
+static void cymbTestSymbols(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const char* const string = "a bb a _c int bb";
+
+	const struct
+	{
+		uint32_t symbol;
+		CymbStringView name;
+	} tests[] = {
+		{0, CYMB_STRING("a")},
+		{1, CYMB_STRING("bb")},
+		{0, CYMB_STRING("a")},
+		{2, CYMB_STRING("_c")},
+		{1, CYMB_STRING("bb")}
+	};
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbInterner interner;
+	if(cymbInternerCreate(&interner, &context->arena) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Failed to create interner.");
+		goto end;
+	}
+
+	CymbTokenList tokens;
+	if(cymbLex(string, CYMB_C23, &interner, &tokens, &context->diagnostics) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Wrong result.");
+		goto clear;
+	}
+
+	size_t testIndex = 0;
+	for(size_t tokenIndex = 0; tokenIndex < tokens.count; ++tokenIndex)
+	{
+		const CymbToken* const token = &tokens.tokens[tokenIndex];
+		if(token->type != CYMB_TOKEN_IDENTIFIER)
+		{
+			continue;
+		}
+
+		if(testIndex == testCount)
+		{
+			cymbFail(context, "Too many identifiers.");
+			break;
+		}
+
+		cymbContextSetIndex(context, testIndex);
+
+		if(token->symbol != tests[testIndex].symbol)
+		{
+			cymbFail(context, "Wrong symbol.");
+		}
+
+		const CymbStringView name = cymbInternerString(&interner, token->symbol);
+		if(name.length != tests[testIndex].name.length || memcmp(name.string, tests[testIndex].name.string, name.length) != 0)
+		{
+			cymbFail(context, "Wrong name.");
+		}
+
+		++testIndex;
+	}
+
+	if(interner.count != 3)
+	{
+		cymbFail(context, "Wrong symbol count.");
+	}
+
+	cymbFreeTokenList(&tokens);
+
+	clear:
+	cymbInternerFree(&interner);
+
+	end:
+	cymbArenaRestore(&context->arena, save);
+	cymbDiagnosticListFree(&context->diagnostics);
+
+	cymbContextPop(context);
+}
+
+static void cymbTestBrackets(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const char* const string = "f(a[1], {b}) ) ( [ ] {";
+
+	const struct
+	{
+		size_t index;
+		uint32_t partner;
+	} tests[] = {
+		{1, 9},
+		{3, 2},
+		{5, 2},
+		{7, 2},
+		{9, 2},
+		{10, 9},
+		{11, 0},
+		{12, 0},
+		{13, 1},
+		{14, 1},
+		{15, 0}
+	};
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	CymbTokenList tokens;
+	if(cymbLex(string, CYMB_C23, nullptr, &tokens, &context->diagnostics) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Wrong result.");
+		goto end;
+	}
+
+	if(tokens.count != 16)
+	{
+		cymbFail(context, "Wrong token count.");
+		goto clear;
+	}
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		if(tokens.tokens[tests[testIndex].index].partner != tests[testIndex].partner)
+		{
+			cymbFail(context, "Wrong partner.");
+		}
+	}
+
+	clear:
+	cymbFreeTokenList(&tokens);
+
+	end:
+	cymbDiagnosticListFree(&context->diagnostics);
+
+	cymbContextPop(context);
+}
+
 void cymbTestLexs(CymbTestContext* const context)
 {
 	cymbTestStrings(context);
 	cymbTestCharacters(context);
 	cymbTestPunctuators(context);
+	cymbTestPunctuatorTable(context);
 	cymbTestConstants(context);
 	cymbTestIdentifiers(context);
+	cymbTestKeywords(context);
 	cymbTestLex(context);
+	cymbTestLexNext(context);
+	cymbTestLexParallel(context);
+	cymbTestSymbols(context);
+	cymbTestBrackets(context);
 }
@@ -1,34 +1,67 @@
 #include "test.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "cymb/tree.h"
 
+typedef struct CymbTestTree
+{
+	const CymbNode* nodes;
+	const CymbNodeIndex* children;
+	CymbNodeIndex root;
+} CymbTestTree;
+
 typedef struct CymbTreeTest
 {
 	CymbTokenList tokens;
 	CymbResult result;
-	CymbTree solution;
+	CymbTestTree solution;
 	CymbDiagnosticList diagnostics;
 	size_t endTokensOffset;
+	const char* source;
 } CymbTreeTest;
 
-static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const second, CymbTestContext* const context, size_t* const nodeCount)
+static void cymbCompareNodes(const CymbTestTree* firstTree, CymbNodeIndex firstIndex, const CymbTestTree* secondTree, CymbNodeIndex secondIndex, CymbTestContext* context, size_t* nodeCount);
+
+static void cymbCompareChildren(const CymbTestTree* const first, const CymbNodeSpan firstSpan, const CymbTestTree* const second, const CymbNodeSpan secondSpan, CymbTestContext* const context, size_t* const nodeCount)
+{
+	for(uint32_t childIndex = 0; childIndex < firstSpan.count; ++childIndex)
+	{
+		if(childIndex == secondSpan.count)
+		{
+			cymbFail(context, "Unexpected child node.");
+			return;
+		}
+
+		cymbCompareNodes(first, first->children[firstSpan.start + childIndex], second, second->children[secondSpan.start + childIndex], context, nodeCount);
+	}
+
+	if(secondSpan.count > firstSpan.count)
+	{
+		cymbFail(context, "Missing child node.");
+	}
+}
+
+static void cymbCompareNodes(const CymbTestTree* const firstTree, const CymbNodeIndex firstIndex, const CymbTestTree* const secondTree, const CymbNodeIndex secondIndex, CymbTestContext* const context, size_t* const nodeCount)
 {
 	++*nodeCount;
 	cymbContextSetIndex(context, *nodeCount);
 
-	if(!first && !second)
+	if(firstIndex == 0 && secondIndex == 0)
 	{
 		return;
 	}
 
-	if(!first || !second)
+	if(firstIndex == 0 || secondIndex == 0)
 	{
 		cymbFail(context, "Node is null.");
 		return;
 	}
 
+	const CymbNode* const first = &firstTree->nodes[firstIndex];
+	const CymbNode* const second = &secondTree->nodes[secondIndex];
 
 	if(first->type != second->type)
 	{
@@ -36,7 +69,10 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 		return;
 	}
 
-	cymbCompareDiagnosticInfo(&first->info, &second->info, context);
+	if(first->token != second->token)
+	{
+		cymbFail(context, "Wrong node token.");
+	}
 
 	switch(first->type)
 	{
@@ -60,7 +96,7 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 			{
 				cymbFail(context, "Wrong unary operator type.");
 			}
-			cymbCompareNodes(first->unaryOperatorNode.node, second->unaryOperatorNode.node, context, nodeCount);
+			cymbCompareNodes(firstTree, first->unaryOperatorNode.node, secondTree, second->unaryOperatorNode.node, context, nodeCount);
 			break;
 		}
 
@@ -70,44 +106,22 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 			{
 				cymbFail(context, "Wrong binary operator type.");
 			}
-			cymbCompareNodes(first->binaryOperatorNode.leftNode, second->binaryOperatorNode.leftNode, context, nodeCount);
-			cymbCompareNodes(first->binaryOperatorNode.rightNode, second->binaryOperatorNode.rightNode, context, nodeCount);
+			cymbCompareNodes(firstTree, first->binaryOperatorNode.leftNode, secondTree, second->binaryOperatorNode.leftNode, context, nodeCount);
+			cymbCompareNodes(firstTree, first->binaryOperatorNode.rightNode, secondTree, second->binaryOperatorNode.rightNode, context, nodeCount);
 			break;
 		}
 
 		case CYMB_NODE_FUNCTION_CALL:
 		{
-			cymbCompareNodes(first->functionCallNode.name, second->functionCallNode.name, context, nodeCount);
-
-			const CymbNodeChild* firstArgument = first->functionCallNode.arguments;
-			const CymbNodeChild* secondArgument = second->functionCallNode.arguments;
-
-			while(firstArgument)
-			{
-				if(!secondArgument)
-				{
-					cymbFail(context, "Unexpected argument node.");
-					return;
-				}
-
-				cymbCompareNodes(firstArgument->node, secondArgument->node, context, nodeCount);
-
-				firstArgument = firstArgument->next;
-				secondArgument = secondArgument->next;
-			}
-
-			if(secondArgument)
-			{
-				cymbFail(context, "Missing argument node.");
-			}
-
+			cymbCompareNodes(firstTree, first->functionCallNode.name, secondTree, second->functionCallNode.name, context, nodeCount);
+			cymbCompareChildren(firstTree, first->functionCallNode.arguments, secondTree, second->functionCallNode.arguments, context, nodeCount);
 			break;
 		}
 
 		case CYMB_NODE_ARRAY_SUBSCRIPT:
 		{
-			cymbCompareNodes(first->arraySubscriptNode.name, second->arraySubscriptNode.name, context, nodeCount);
-			cymbCompareNodes(first->arraySubscriptNode.expression, second->arraySubscriptNode.expression, context, nodeCount);
+			cymbCompareNodes(firstTree, first->arraySubscriptNode.name, secondTree, second->arraySubscriptNode.name, context, nodeCount);
+			cymbCompareNodes(firstTree, first->arraySubscriptNode.expression, secondTree, second->arraySubscriptNode.expression, context, nodeCount);
 
 			break;
 		}
@@ -119,8 +133,8 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 				cymbFail(context, "Wrong member access type.");
 			}
 
-			cymbCompareNodes(first->memberAccessNode.name, second->memberAccessNode.name, context, nodeCount);
-			cymbCompareNodes(first->memberAccessNode.member, second->memberAccessNode.member, context, nodeCount);
+			cymbCompareNodes(firstTree, first->memberAccessNode.name, secondTree, second->memberAccessNode.name, context, nodeCount);
+			cymbCompareNodes(firstTree, first->memberAccessNode.member, secondTree, second->memberAccessNode.member, context, nodeCount);
 
 			break;
 		}
@@ -132,43 +146,21 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 				cymbFail(context, "Wrong postfix operator.");
 			}
 
-			cymbCompareNodes(first->postfixOperatorNode.node, second->postfixOperatorNode.node, context, nodeCount);
+			cymbCompareNodes(firstTree, first->postfixOperatorNode.node, secondTree, second->postfixOperatorNode.node, context, nodeCount);
 
 			break;
 		}
 
 		case CYMB_NODE_WHILE:
 		{
-			cymbCompareNodes(first->whileNode.expression, second->whileNode.expression, context, nodeCount);
-
-			const CymbNodeChild* firstChild = first->whileNode.body;
-			const CymbNodeChild* secondChild = second->whileNode.body;
-
-			while(firstChild)
-			{
-				if(!secondChild)
-				{
-					cymbFail(context, "Unexpected child node.");
-					return;
-				}
-
-				cymbCompareNodes(firstChild->node, secondChild->node, context, nodeCount);
-
-				firstChild = firstChild->next;
-				secondChild = secondChild->next;
-			}
-
-			if(secondChild)
-			{
-				cymbFail(context, "Missing child node.");
-			}
-
+			cymbCompareNodes(firstTree, first->whileNode.expression, secondTree, second->whileNode.expression, context, nodeCount);
+			cymbCompareChildren(firstTree, first->whileNode.body, secondTree, second->whileNode.body, context, nodeCount);
 			break;
 		}
 
 		case CYMB_NODE_RETURN:
 		{
-			cymbCompareNodes(first->returnNode, second->returnNode, context, nodeCount);
+			cymbCompareNodes(firstTree, first->returnNode, secondTree, second->returnNode, context, nodeCount);
 			break;
 		}
 
@@ -191,7 +183,7 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 
 		case CYMB_NODE_POINTER:
 		{
-			cymbCompareNodes(first->pointerNode.pointedNode, second->pointerNode.pointedNode, context, nodeCount);
+			cymbCompareNodes(firstTree, first->pointerNode.pointedNode, secondTree, second->pointerNode.pointedNode, context, nodeCount);
 			if(first->pointerNode.isConst != second->pointerNode.isConst)
 			{
 				cymbFail(context, "Wrong pointer const.");
@@ -205,117 +197,30 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 
 		case CYMB_NODE_FUNCTION_TYPE:
 		{
-			cymbCompareNodes(first->functionTypeNode.returnType, second->functionTypeNode.returnType, context, nodeCount);
-
-			const CymbNodeChild* firstChild = first->functionTypeNode.parameterTypes;
-			const CymbNodeChild* secondChild = second->functionTypeNode.parameterTypes;
-
-			while(firstChild)
-			{
-				if(!secondChild)
-				{
-					cymbFail(context, "Unexpected child node.");
-					return;
-				}
-
-				cymbCompareNodes(firstChild->node, secondChild->node, context, nodeCount);
-
-				firstChild = firstChild->next;
-				secondChild = secondChild->next;
-			}
-
-			if(secondChild)
-			{
-				cymbFail(context, "Missing child node.");
-			}
-
+			cymbCompareNodes(firstTree, first->functionTypeNode.returnType, secondTree, second->functionTypeNode.returnType, context, nodeCount);
+			cymbCompareChildren(firstTree, first->functionTypeNode.parameterTypes, secondTree, second->functionTypeNode.parameterTypes, context, nodeCount);
 			break;
 		}
 
 		case CYMB_NODE_DECLARATION:
 		{
-			cymbCompareNodes(first->declarationNode.identifier, second->declarationNode.identifier, context, nodeCount);
-			cymbCompareNodes(first->declarationNode.type, second->declarationNode.type, context, nodeCount);
-			cymbCompareNodes(first->declarationNode.initializer, second->declarationNode.initializer, context, nodeCount);
+			cymbCompareNodes(firstTree, first->declarationNode.identifier, secondTree, second->declarationNode.identifier, context, nodeCount);
+			cymbCompareNodes(firstTree, first->declarationNode.type, secondTree, second->declarationNode.type, context, nodeCount);
+			cymbCompareNodes(firstTree, first->declarationNode.initializer, secondTree, second->declarationNode.initializer, context, nodeCount);
 			break;
 		}
 
 		case CYMB_NODE_FUNCTION:
 		{
-			cymbCompareNodes(first->functionNode.name, second->functionNode.name, context, nodeCount);
-			cymbCompareNodes(first->functionNode.type, second->functionNode.type, context, nodeCount);
-
-			const CymbNodeChild* firstChild = first->functionNode.parameters;
-			const CymbNodeChild* secondChild = second->functionNode.parameters;
-
-			while(firstChild)
-			{
-				if(!secondChild)
-				{
-					cymbFail(context, "Unexpected child node.");
-					return;
-				}
-
-				cymbCompareNodes(firstChild->node, secondChild->node, context, nodeCount);
-
-				firstChild = firstChild->next;
-				secondChild = secondChild->next;
-			}
-
-			if(secondChild)
-			{
-				cymbFail(context, "Missing child node.");
-			}
-
-			firstChild = first->functionNode.statements;
-			secondChild = second->functionNode.statements;
-
-			while(firstChild)
-			{
-				if(!secondChild)
-				{
-					cymbFail(context, "Unexpected child node.");
-					return;
-				}
-
-				cymbCompareNodes(firstChild->node, secondChild->node, context, nodeCount);
-
-				firstChild = firstChild->next;
-				secondChild = secondChild->next;
-			}
-
-			if(secondChild)
-			{
-				cymbFail(context, "Missing child node.");
-			}
-
+			cymbCompareNodes(firstTree, first->functionNode.name, secondTree, second->functionNode.name, context, nodeCount);
+			cymbCompareNodes(firstTree, first->functionNode.type, secondTree, second->functionNode.type, context, nodeCount);
+			cymbCompareChildren(firstTree, first->functionNode.children, secondTree, second->functionNode.children, context, nodeCount);
 			break;
 		}
 
 		case CYMB_NODE_PROGRAM:
 		{
-			const CymbNodeChild* firstChild = first->programNode.children;
-			const CymbNodeChild* secondChild = second->programNode.children;
-
-			while(firstChild)
-			{
-				if(!secondChild)
-				{
-					cymbFail(context, "Unexpected child node.");
-					return;
-				}
-
-				cymbCompareNodes(firstChild->node, secondChild->node, context, nodeCount);
-
-				firstChild = firstChild->next;
-				secondChild = secondChild->next;
-			}
-
-			if(secondChild)
-			{
-				cymbFail(context, "Missing child node.");
-			}
-
+			cymbCompareChildren(firstTree, first->programNode.children, secondTree, second->programNode.children, context, nodeCount);
 			break;
 		}
 
@@ -327,23 +232,24 @@ static void cymbCompareNodes(const CymbNode* const first, const CymbNode* const
 	}
 }
 
-static void cymbCompareTrees(const CymbTree* const first, const CymbTree* const second, CymbTestContext* const context)
+static void cymbCompareTrees(const CymbTestTree* const first, const CymbTestTree* const second, CymbTestContext* const context)
 {
 	cymbContextPush(context, "node");
 
 	size_t nodeCount = 0;
-	cymbCompareNodes(first->root, second->root, context, &nodeCount);
+	cymbCompareNodes(first, first->root, second, second->root, context, &nodeCount);
 
 	cymbContextPop(context);
 }
 
 static void cymbDoTreeTest(const CymbTreeTest* const test, const CymbTreeFunction function, CymbTestContext* const context)
 {
-	const CymbArenaSave save = cymbArenaSave(&context->arena);
-
-	CymbTree tree = {.arena = &context->arena};
+	CymbTree tree;
+	cymbTreeCreate(&tree, test->tokens.tokens);
 
 	CymbTokenList tokens = test->tokens;
+	cymbMatchBrackets(tokens.tokens, tokens.count);
+	cymbDiagnosticListSetSource(&context->diagnostics, test->source);
 
 	const CymbResult result = function(&tree, &tokens, &context->diagnostics);
 	if(result != test->result)
@@ -359,10 +265,10 @@ static void cymbDoTreeTest(const CymbTreeTest* const test, const CymbTreeFunctio
 		cymbFail(context, "Wrong end tokens.");
 	}
 
-	cymbCompareTrees(&tree, &test->solution, context);
+	cymbCompareTrees(&(CymbTestTree){tree.nodes.data, tree.children.data, tree.root}, &test->solution, context);
 
 	end:
-	cymbArenaRestore(&context->arena, save);
+	cymbFreeTree(&tree);
 	cymbDiagnosticListFree(&context->diagnostics);
 }
 
@@ -370,6 +276,11 @@ static void cymbTestParentheses(CymbTestContext* const context)
 {
 	cymbContextPush(context, __func__);
 
+	const CymbConstString test1String = CYMB_STRING("  \t a (!");
+	const CymbConstString test2String = CYMB_STRING(")");
+	const CymbConstString test5String = CYMB_STRING(" ) ()");
+	const CymbConstString test6String = CYMB_STRING("() ( ");
+
 	struct
 	{
 		CymbTokenList tokens;
@@ -378,83 +289,56 @@ static void cymbTestParentheses(CymbTestContext* const context)
 		size_t startIndex;
 		size_t endIndex;
 		CymbDiagnosticList diagnostics;
+		const char* source;
 	} tests[] = {
 		{{
 			.tokens = (CymbToken[]){
 				{.type = CYMB_TOKEN_PLUS}
 			},
 			.count = 1
-		}, CYMB_DIRECTION_FORWARD, CYMB_NO_MATCH, 0, 0, {}},
+		}, CYMB_DIRECTION_FORWARD, CYMB_NO_MATCH, 0, 0, {}, nullptr},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {8, 8},
-						.line = CYMB_STRING("  \t a (!"),
-						.hint = CYMB_STRING("(")
-					}
-				}
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 6, .length = 1}
 			},
 			.count = 1
-		}, CYMB_DIRECTION_FORWARD, CYMB_INVALID, 0, 0, {}},
+		}, CYMB_DIRECTION_FORWARD, CYMB_INVALID, 0, 0, {}, test1String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 1},
-						.line = CYMB_STRING("("),
-						.hint = CYMB_STRING("(")
-					}
-				}
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 0, .length = 1}
 			},
 			.count = 1
-		}, CYMB_DIRECTION_BACKWARD, CYMB_INVALID, 0, 0, {}},
+		}, CYMB_DIRECTION_BACKWARD, CYMB_INVALID, 0, 0, {}, test2String.string},
 		{{
 			.tokens = (CymbToken[]){
 				{.type = CYMB_TOKEN_OPEN_PARENTHESIS},
 				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS}
 			},
 			.count = 2
-		}, CYMB_DIRECTION_FORWARD, CYMB_SUCCESS, 0, 1, {}},
+		}, CYMB_DIRECTION_FORWARD, CYMB_SUCCESS, 0, 1, {}, nullptr},
 		{{
 			.tokens = (CymbToken[]){
 				{.type = CYMB_TOKEN_OPEN_PARENTHESIS},
 				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS}
 			},
 			.count = 2
-		}, CYMB_DIRECTION_BACKWARD, CYMB_SUCCESS, 1, 0, {}},
+		}, CYMB_DIRECTION_BACKWARD, CYMB_SUCCESS, 1, 0, {}, nullptr},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {2, 2},
-						.line = CYMB_STRING(" ) "),
-						.hint = CYMB_STRING(")")
-					}
-				},
-				{.type = CYMB_TOKEN_OPEN_PARENTHESIS},
-				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS}
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 1, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 3, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 4, .length = 1}
 			},
 			.count = 3
-		}, CYMB_DIRECTION_FORWARD, CYMB_INVALID, 0, 0, {}},
+		}, CYMB_DIRECTION_FORWARD, CYMB_INVALID, 0, 0, {}, test5String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{.type = CYMB_TOKEN_OPEN_PARENTHESIS},
-				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {3, 3},
-						.line = CYMB_STRING(" ( "),
-						.hint = CYMB_STRING("(")
-					}
-				}
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 0, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 1, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 3, .length = 1}
 			},
 			.count = 3
-		}, CYMB_DIRECTION_BACKWARD, CYMB_INVALID, 2, 2, {}},
+		}, CYMB_DIRECTION_BACKWARD, CYMB_INVALID, 2, 2, {}, test6String.string},
 		{{
 			.tokens = (CymbToken[]){
 				{.type = CYMB_TOKEN_OPEN_PARENTHESIS},
@@ -467,7 +351,7 @@ static void cymbTestParentheses(CymbTestContext* const context)
 				{.type = CYMB_TOKEN_PLUS}
 			},
 			.count = 8
-		}, CYMB_DIRECTION_FORWARD, CYMB_SUCCESS, 0, 6, {}},
+		}, CYMB_DIRECTION_FORWARD, CYMB_SUCCESS, 0, 6, {}, nullptr},
 		{{
 			.tokens = (CymbToken[]){
 				{.type = CYMB_TOKEN_PLUS},
@@ -480,14 +364,18 @@ static void cymbTestParentheses(CymbTestContext* const context)
 				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS}
 			},
 			.count = 8
-		}, CYMB_DIRECTION_BACKWARD, CYMB_SUCCESS, 7, 1, {}}
+		}, CYMB_DIRECTION_BACKWARD, CYMB_SUCCESS, 7, 1, {}, nullptr}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
 	CymbDiagnostic diagnostics1[] = {
 		{
 			.type = CYMB_UNMATCHED_PARENTHESIS,
-			.info = tests[1].tokens.tokens[0].info
+			.info = {
+				.position = {1, 8},
+				.line = test1String,
+				.hint = {test1String.string + 6, 1}
+			}
 		}
 	};
 	tests[1].diagnostics.start = diagnostics1;
@@ -495,7 +383,11 @@ static void cymbTestParentheses(CymbTestContext* const context)
 	CymbDiagnostic diagnostics2[] = {
 		{
 			.type = CYMB_UNMATCHED_PARENTHESIS,
-			.info = tests[2].tokens.tokens[0].info
+			.info = {
+				.position = {1, 1},
+				.line = test2String,
+				.hint = {test2String.string, 1}
+			}
 		}
 	};
 	tests[2].diagnostics.start = diagnostics2;
@@ -503,7 +395,11 @@ static void cymbTestParentheses(CymbTestContext* const context)
 	CymbDiagnostic diagnostics5[] = {
 		{
 			.type = CYMB_UNMATCHED_PARENTHESIS,
-			.info = tests[5].tokens.tokens[0].info
+			.info = {
+				.position = {1, 2},
+				.line = test5String,
+				.hint = {test5String.string + 1, 1}
+			}
 		}
 	};
 	tests[5].diagnostics.start = diagnostics5;
@@ -511,7 +407,11 @@ static void cymbTestParentheses(CymbTestContext* const context)
 	CymbDiagnostic diagnostics6[] = {
 		{
 			.type = CYMB_UNMATCHED_PARENTHESIS,
-			.info = tests[6].tokens.tokens[2].info
+			.info = {
+				.position = {1, 4},
+				.line = test6String,
+				.hint = {test6String.string + 3, 1}
+			}
 		}
 	};
 	tests[6].diagnostics.start = diagnostics6;
@@ -523,6 +423,10 @@ static void cymbTestParentheses(CymbTestContext* const context)
 
 		cymbContextSetIndex(context, testIndex);
 
+		cymbDiagnosticListSetSource(&context->diagnostics, tests[testIndex].source);
+
+		cymbMatchBrackets(tests[testIndex].tokens.tokens, tests[testIndex].tokens.count);
+
 		size_t tokenIndex = tests[testIndex].startIndex;
 		const CymbResult result = cymbSkipParentheses(&tests[testIndex].tokens, tests[testIndex].direction, &tokenIndex, &context->diagnostics);
 
@@ -564,1877 +468,925 @@ static void cymbTestExpressions(CymbTestContext* const context)
 	CymbTreeTest tests[] = {
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 1},
-						.line = test0String,
-						.hint = {test0String.string, 1}
-					}
-				},
-				{.type = CYMB_TOKEN_PLUS}
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 0, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_PLUS, .offset = 2, .length = 1}
 			},
-			.count = 2
-		}, CYMB_INVALID, {}, {}, 0},
+			.count = 2,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 5}}
+		}, CYMB_INVALID, {}, {}, 0, test0String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = test1String,
-						.hint = test1String
-					}
-				}
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 0, .length = 1}
 			},
 			.count = 1
-		}, CYMB_SUCCESS, {}, {}, 1},
+		}, CYMB_SUCCESS, {}, {}, 1, test1String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 1},
-						.line = test2String,
-						.hint = {test2String.string + 0, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 2},
-						.line = test2String,
-						.hint = {test2String.string + 1, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 3},
-						.line = test2String,
-						.hint = {test2String.string + 2, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 5},
-						.line = test2String,
-						.hint = {test2String.string + 4, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 7},
-						.line = test2String,
-						.hint = {test2String.string + 6, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 26},
-					.info = {
-						.position = {1, 8},
-						.line = test2String,
-						.hint = {test2String.string + 7, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 11},
-						.line = test2String,
-						.hint = {test2String.string + 10, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 27},
-					.info = {
-						.position = {1, 13},
-						.line = test2String,
-						.hint = {test2String.string + 12, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 16},
-						.line = test2String,
-						.hint = {test2String.string + 15, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 28},
-					.info = {
-						.position = {1, 18},
-						.line = test2String,
-						.hint = {test2String.string + 17, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 21},
-						.line = test2String,
-						.hint = {test2String.string + 20, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 29},
-					.info = {
-						.position = {1, 23},
-						.line = test2String,
-						.hint = {test2String.string + 22, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 25},
-						.line = test2String,
-						.hint = {test2String.string + 24, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 27},
-						.line = test2String,
-						.hint = {test2String.string + 26, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 37},
-					.info = {
-						.position = {1, 29},
-						.line = test2String,
-						.hint = {test2String.string + 28, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 31},
-						.line = test2String,
-						.hint = {test2String.string + 30, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 32},
-						.line = test2String,
-						.hint = {test2String.string + 31, 1}
-					}
-				}
-			},
-			.count = 17
-		}, CYMB_SUCCESS, {}, {}, 17},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 0, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 1, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 2, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_STAR, .offset = 4, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 6, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 7, .length = 2, .constant = 1},
+				{.type = CYMB_TOKEN_PLUS, .offset = 10, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 12, .length = 2, .constant = 2},
+				{.type = CYMB_TOKEN_STAR, .offset = 15, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 17, .length = 2, .constant = 3},
+				{.type = CYMB_TOKEN_PLUS, .offset = 20, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 22, .length = 2, .constant = 4},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 24, .length = 1},
+				{.type = CYMB_TOKEN_PLUS, .offset = 26, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 28, .length = 2, .constant = 5},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 30, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 31, .length = 1}
+			},
+			.count = 17,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 5}, {CYMB_CONSTANT_INT, 26}, {CYMB_CONSTANT_INT, 27}, {CYMB_CONSTANT_INT, 28}, {CYMB_CONSTANT_INT, 29}, {CYMB_CONSTANT_INT, 37}}
+		}, CYMB_SUCCESS, {}, {}, 17, test2String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 0},
-					.info = {
-						.position = {1, 1},
-						.line = test3String,
-						.hint = {test3String.string + 0, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_AMPERSAND,
-					.info = {
-						.position = {1, 3},
-						.line = test3String,
-						.hint = {test3String.string + 2, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 5},
-						.line = test3String,
-						.hint = {test3String.string + 4, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_LEFT_SHIFT,
-					.info = {
-						.position = {1, 7},
-						.line = test3String,
-						.hint = {test3String.string + 6, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 10},
-						.line = test3String,
-						.hint = {test3String.string + 9, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_EQUAL_EQUAL,
-					.info = {
-						.position = {1, 12},
-						.line = test3String,
-						.hint = {test3String.string + 11, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 3},
-					.info = {
-						.position = {1, 15},
-						.line = test3String,
-						.hint = {test3String.string + 14, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 17},
-						.line = test3String,
-						.hint = {test3String.string + 16, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 4},
-					.info = {
-						.position = {1, 19},
-						.line = test3String,
-						.hint = {test3String.string + 18, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 21},
-						.line = test3String,
-						.hint = {test3String.string + 20, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 23},
-						.line = test3String,
-						.hint = {test3String.string + 22, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_BAR_BAR,
-					.info = {
-						.position = {1, 25},
-						.line = test3String,
-						.hint = {test3String.string + 24, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 6},
-					.info = {
-						.position = {1, 28},
-						.line = test3String,
-						.hint = {test3String.string + 27, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CARET,
-					.info = {
-						.position = {1, 30},
-						.line = test3String,
-						.hint = {test3String.string + 29, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 7},
-					.info = {
-						.position = {1, 32},
-						.line = test3String,
-						.hint = {test3String.string + 31, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_LESS,
-					.info = {
-						.position = {1, 34},
-						.line = test3String,
-						.hint = {test3String.string + 33, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 8},
-					.info = {
-						.position = {1, 36},
-						.line = test3String,
-						.hint = {test3String.string + 35, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RIGHT_SHIFT,
-					.info = {
-						.position = {1, 38},
-						.line = test3String,
-						.hint = {test3String.string + 37, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 9},
-					.info = {
-						.position = {1, 41},
-						.line = test3String,
-						.hint = {test3String.string + 40, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SLASH,
-					.info = {
-						.position = {1, 43},
-						.line = test3String,
-						.hint = {test3String.string + 42, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 10},
-					.info = {
-						.position = {1, 45},
-						.line = test3String,
-						.hint = {test3String.string + 44, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_AMPERSAND_AMPERSAND,
-					.info = {
-						.position = {1, 48},
-						.line = test3String,
-						.hint = {test3String.string + 47, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 11},
-					.info = {
-						.position = {1, 51},
-						.line = test3String,
-						.hint = {test3String.string + 50, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_MINUS,
-					.info = {
-						.position = {1, 54},
-						.line = test3String,
-						.hint = {test3String.string + 53, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 12},
-					.info = {
-						.position = {1, 56},
-						.line = test3String,
-						.hint = {test3String.string + 55, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_GREATER_EQUAL,
-					.info = {
-						.position = {1, 59},
-						.line = test3String,
-						.hint = {test3String.string + 58, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 13},
-					.info = {
-						.position = {1, 62},
-						.line = test3String,
-						.hint = {test3String.string + 61, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_NOT_EQUAL,
-					.info = {
-						.position = {1, 65},
-						.line = test3String,
-						.hint = {test3String.string + 64, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 14},
-					.info = {
-						.position = {1, 68},
-						.line = test3String,
-						.hint = {test3String.string + 67, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_LESS_EQUAL,
-					.info = {
-						.position = {1, 71},
-						.line = test3String,
-						.hint = {test3String.string + 70, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 15},
-					.info = {
-						.position = {1, 74},
-						.line = test3String,
-						.hint = {test3String.string + 73, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_BAR,
-					.info = {
-						.position = {1, 77},
-						.line = test3String,
-						.hint = {test3String.string + 76, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 16},
-					.info = {
-						.position = {1, 79},
-						.line = test3String,
-						.hint = {test3String.string + 78, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_GREATER,
-					.info = {
-						.position = {1, 82},
-						.line = test3String,
-						.hint = {test3String.string + 81, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 17},
-					.info = {
-						.position = {1, 84},
-						.line = test3String,
-						.hint = {test3String.string + 83, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PERCENT,
-					.info = {
-						.position = {1, 87},
-						.line = test3String,
-						.hint = {test3String.string + 86, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 18},
-					.info = {
-						.position = {1, 89},
-						.line = test3String,
-						.hint = {test3String.string + 88, 2}
-					}
-				}
-			},
-			.count = 37
-		}, CYMB_SUCCESS, {}, {}, 37},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 0, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_AMPERSAND, .offset = 2, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 4, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_LEFT_SHIFT, .offset = 6, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 9, .length = 1, .constant = 2},
+				{.type = CYMB_TOKEN_EQUAL_EQUAL, .offset = 11, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 14, .length = 1, .constant = 3},
+				{.type = CYMB_TOKEN_PLUS, .offset = 16, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 18, .length = 1, .constant = 4},
+				{.type = CYMB_TOKEN_STAR, .offset = 20, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 22, .length = 1, .constant = 5},
+				{.type = CYMB_TOKEN_BAR_BAR, .offset = 24, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 27, .length = 1, .constant = 6},
+				{.type = CYMB_TOKEN_CARET, .offset = 29, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 31, .length = 1, .constant = 7},
+				{.type = CYMB_TOKEN_LESS, .offset = 33, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 35, .length = 1, .constant = 8},
+				{.type = CYMB_TOKEN_RIGHT_SHIFT, .offset = 37, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 40, .length = 1, .constant = 9},
+				{.type = CYMB_TOKEN_SLASH, .offset = 42, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 44, .length = 2, .constant = 10},
+				{.type = CYMB_TOKEN_AMPERSAND_AMPERSAND, .offset = 47, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 50, .length = 2, .constant = 11},
+				{.type = CYMB_TOKEN_MINUS, .offset = 53, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 55, .length = 2, .constant = 12},
+				{.type = CYMB_TOKEN_GREATER_EQUAL, .offset = 58, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 61, .length = 2, .constant = 13},
+				{.type = CYMB_TOKEN_NOT_EQUAL, .offset = 64, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 67, .length = 2, .constant = 14},
+				{.type = CYMB_TOKEN_LESS_EQUAL, .offset = 70, .length = 2},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 73, .length = 2, .constant = 15},
+				{.type = CYMB_TOKEN_BAR, .offset = 76, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 78, .length = 1, .constant = 16},
+				{.type = CYMB_TOKEN_GREATER, .offset = 81, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 83, .length = 2, .constant = 17},
+				{.type = CYMB_TOKEN_PERCENT, .offset = 86, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 88, .length = 2, .constant = 18}
+			},
+			.count = 37,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 0}, {CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 2}, {CYMB_CONSTANT_INT, 3}, {CYMB_CONSTANT_INT, 4}, {CYMB_CONSTANT_INT, 5}, {CYMB_CONSTANT_INT, 6}, {CYMB_CONSTANT_INT, 7}, {CYMB_CONSTANT_INT, 8}, {CYMB_CONSTANT_INT, 9}, {CYMB_CONSTANT_INT, 10}, {CYMB_CONSTANT_INT, 11}, {CYMB_CONSTANT_INT, 12}, {CYMB_CONSTANT_INT, 13}, {CYMB_CONSTANT_INT, 14}, {CYMB_CONSTANT_INT, 15}, {CYMB_CONSTANT_INT, 16}, {CYMB_CONSTANT_INT, 17}, {CYMB_CONSTANT_INT, 18}}
+		}, CYMB_SUCCESS, {}, {}, 37, test3String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_MINUS,
-					.info = {
-						.position = {1, 1},
-						.line = test4String,
-						.hint = {test4String.string + 0, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_TILDE,
-					.info = {
-						.position = {1, 2},
-						.line = test4String,
-						.hint = {test4String.string + 1, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 0},
-					.info = {
-						.position = {1, 3},
-						.line = test4String,
-						.hint = {test4String.string + 2, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 5},
-						.line = test4String,
-						.hint = {test4String.string + 4, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 7},
-						.line = test4String,
-						.hint = {test4String.string + 6, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 8},
-						.line = test4String,
-						.hint = {test4String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_AMPERSAND,
-					.info = {
-						.position = {1, 9},
-						.line = test4String,
-						.hint = {test4String.string + 8, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 10},
-						.line = test4String,
-						.hint = {test4String.string + 9, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_MINUS,
-					.info = {
-						.position = {1, 12},
-						.line = test4String,
-						.hint = {test4String.string + 11, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS_PLUS,
-					.info = {
-						.position = {1, 14},
-						.line = test4String,
-						.hint = {test4String.string + 13, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_EXCLAMATION,
-					.info = {
-						.position = {1, 16},
-						.line = test4String,
-						.hint = {test4String.string + 15, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 17},
-						.line = test4String,
-						.hint = {test4String.string + 16, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_MINUS_MINUS,
-					.info = {
-						.position = {1, 18},
-						.line = test4String,
-						.hint = {test4String.string + 17, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 20},
-						.line = test4String,
-						.hint = {test4String.string + 19, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 21},
-						.line = test4String,
-						.hint = {test4String.string + 20, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 21},
-						.line = test4String,
-						.hint = {test4String.string + 20, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 22},
-						.line = test4String,
-						.hint = {test4String.string + 21, 1}
-					}
-				}
-			},
-			.count = 17
-		}, CYMB_SUCCESS, {}, {}, 17},
+				{.type = CYMB_TOKEN_MINUS, .offset = 0, .length = 1},
+				{.type = CYMB_TOKEN_TILDE, .offset = 1, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 2, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_STAR, .offset = 4, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 6, .length = 1},
+				{.type = CYMB_TOKEN_STAR, .offset = 7, .length = 1},
+				{.type = CYMB_TOKEN_AMPERSAND, .offset = 8, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 9, .length = 1},
+				{.type = CYMB_TOKEN_MINUS, .offset = 11, .length = 1},
+				{.type = CYMB_TOKEN_PLUS_PLUS, .offset = 13, .length = 2},
+				{.type = CYMB_TOKEN_EXCLAMATION, .offset = 15, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 16, .length = 1},
+				{.type = CYMB_TOKEN_MINUS_MINUS, .offset = 17, .length = 2},
+				{.type = CYMB_TOKEN_PLUS, .offset = 19, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 20, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 20, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 21, .length = 1}
+			},
+			.count = 17,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 0}}
+		}, CYMB_SUCCESS, {}, {}, 17, test4String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = test5String,
-						.hint = {test5String.string + 0, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS_EQUAL,
-					.info = {
-						.position = {1, 3},
-						.line = test5String,
-						.hint = {test5String.string + 2, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 6},
-						.line = test5String,
-						.hint = {test5String.string + 5, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 8},
-						.line = test5String,
-						.hint = {test5String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 10},
-						.line = test5String,
-						.hint = {test5String.string + 9, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 12},
-						.line = test5String,
-						.hint = {test5String.string + 11, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 3},
-					.info = {
-						.position = {1, 14},
-						.line = test5String,
-						.hint = {test5String.string + 13, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_EQUAL,
-					.info = {
-						.position = {1, 16},
-						.line = test5String,
-						.hint = {test5String.string + 15, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 18},
-						.line = test5String,
-						.hint = {test5String.string + 17, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 20},
-						.line = test5String,
-						.hint = {test5String.string + 19, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 22},
-						.line = test5String,
-						.hint = {test5String.string + 21, 1}
-					}
-				}
-			},
-			.count = 11
-		}, CYMB_SUCCESS, {}, {}, 11},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 0, .length = 1},
+				{.type = CYMB_TOKEN_PLUS_EQUAL, .offset = 2, .length = 2},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 5, .length = 1},
+				{.type = CYMB_TOKEN_STAR, .offset = 7, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 9, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_STAR, .offset = 11, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 13, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_EQUAL, .offset = 15, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 17, .length = 1, .constant = 2},
+				{.type = CYMB_TOKEN_PLUS, .offset = 19, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 21, .length = 1, .constant = 3}
+			},
+			.count = 11,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 5}, {CYMB_CONSTANT_INT, 3}, {CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 2}}
+		}, CYMB_SUCCESS, {}, {}, 11, test5String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = test6String,
-						.hint = {test6String.string + 0, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 3},
-						.line = test6String,
-						.hint = {test6String.string + 2, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 5},
-						.line = test6String,
-						.hint = {test6String.string + 4, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 6},
-						.line = test6String,
-						.hint = {test6String.string + 5, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 8},
-						.line = test6String,
-						.hint = {test6String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 10},
-						.line = test6String,
-						.hint = {test6String.string + 9, 1}
-					}
-				}
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 0, .length = 1},
+				{.type = CYMB_TOKEN_STAR, .offset = 2, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 4, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 5, .length = 1},
+				{.type = CYMB_TOKEN_PLUS, .offset = 7, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 9, .length = 1}
 			},
 			.count = 6
-		}, CYMB_INVALID, {}, {}, 6},
+		}, CYMB_INVALID, {}, {}, 6, test6String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = test7String,
-						.hint = {test7String.string + 0, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 7},
-						.line = test7String,
-						.hint = {test7String.string + 6, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 8},
-						.line = test7String,
-						.hint = {test7String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 9},
-						.line = test7String,
-						.hint = {test7String.string + 8, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 11},
-						.line = test7String,
-						.hint = {test7String.string + 10, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 13},
-						.line = test7String,
-						.hint = {test7String.string + 12, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 14},
-						.line = test7String,
-						.hint = {test7String.string + 13, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 17},
-						.line = test7String,
-						.hint = {test7String.string + 16, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 18},
-						.line = test7String,
-						.hint = {test7String.string + 17, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_COMMA,
-					.info = {
-						.position = {1, 19},
-						.line = test7String,
-						.hint = {test7String.string + 18, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 21},
-						.line = test7String,
-						.hint = {test7String.string + 20, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 22},
-						.line = test7String,
-						.hint = {test7String.string + 21, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_MINUS,
-					.info = {
-						.position = {1, 24},
-						.line = test7String,
-						.hint = {test7String.string + 23, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 26},
-						.line = test7String,
-						.hint = {test7String.string + 25, 10}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 36},
-						.line = test7String,
-						.hint = {test7String.string + 35, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 37},
-						.line = test7String,
-						.hint = {test7String.string + 36, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_COMMA,
-					.info = {
-						.position = {1, 38},
-						.line = test7String,
-						.hint = {test7String.string + 37, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 40},
-						.line = test7String,
-						.hint = {test7String.string + 39, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_COMMA,
-					.info = {
-						.position = {1, 41},
-						.line = test7String,
-						.hint = {test7String.string + 40, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 3},
-					.info = {
-						.position = {1, 43},
-						.line = test7String,
-						.hint = {test7String.string + 42, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_COMMA,
-					.info = {
-						.position = {1, 44},
-						.line = test7String,
-						.hint = {test7String.string + 43, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 46},
-						.line = test7String,
-						.hint = {test7String.string + 45, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 47},
-						.line = test7String,
-						.hint = {test7String.string + 46, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 48},
-						.line = test7String,
-						.hint = {test7String.string + 47, 1}
-					}
-				},
-			},
-			.count = 24
-		}, CYMB_SUCCESS, {}, {}, 24},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 0, .length = 6},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 6, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 7, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 8, .length = 1},
+				{.type = CYMB_TOKEN_STAR, .offset = 10, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 12, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 13, .length = 3},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 16, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 17, .length = 1},
+				{.type = CYMB_TOKEN_COMMA, .offset = 18, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 20, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 21, .length = 1},
+				{.type = CYMB_TOKEN_MINUS, .offset = 23, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 25, .length = 10},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 35, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 36, .length = 1, .constant = 2},
+				{.type = CYMB_TOKEN_COMMA, .offset = 37, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 39, .length = 1},
+				{.type = CYMB_TOKEN_COMMA, .offset = 40, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 42, .length = 1, .constant = 3},
+				{.type = CYMB_TOKEN_COMMA, .offset = 43, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 45, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 46, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 47, .length = 1},
+			},
+			.count = 24,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 5}, {CYMB_CONSTANT_INT, 2}, {CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 3}}
+		}, CYMB_SUCCESS, {}, {}, 24, test7String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 1},
-						.line = test8String,
-						.hint = {test8String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACKET,
-					.info = {
-						.position = {1, 6},
-						.line = test8String,
-						.hint = {test8String.string + 5, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 0},
-					.info = {
-						.position = {1, 7},
-						.line = test8String,
-						.hint = {test8String.string + 6, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACKET,
-					.info = {
-						.position = {1, 8},
-						.line = test8String,
-						.hint = {test8String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACKET,
-					.info = {
-						.position = {1, 9},
-						.line = test8String,
-						.hint = {test8String.string + 8, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 10},
-						.line = test8String,
-						.hint = {test8String.string + 9, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACKET,
-					.info = {
-						.position = {1, 15},
-						.line = test8String,
-						.hint = {test8String.string + 14, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 16},
-						.line = test8String,
-						.hint = {test8String.string + 15, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACKET,
-					.info = {
-						.position = {1, 17},
-						.line = test8String,
-						.hint = {test8String.string + 16, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 18},
-						.line = test8String,
-						.hint = {test8String.string + 17, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 19},
-						.line = test8String,
-						.hint = {test8String.string + 18, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_COMMA,
-					.info = {
-						.position = {1, 20},
-						.line = test8String,
-						.hint = {test8String.string + 19, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 3},
-					.info = {
-						.position = {1, 22},
-						.line = test8String,
-						.hint = {test8String.string + 21, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 23},
-						.line = test8String,
-						.hint = {test8String.string + 22, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACKET,
-					.info = {
-						.position = {1, 24},
-						.line = test8String,
-						.hint = {test8String.string + 23, 1}
-					}
-				}
-			},
-			.count = 15
-		}, CYMB_SUCCESS, {}, {}, 15}
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_OPEN_BRACKET, .offset = 5, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 6, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_CLOSE_BRACKET, .offset = 7, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACKET, .offset = 8, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 9, .length = 5},
+				{.type = CYMB_TOKEN_OPEN_BRACKET, .offset = 14, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 15, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACKET, .offset = 16, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 17, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 18, .length = 1, .constant = 2},
+				{.type = CYMB_TOKEN_COMMA, .offset = 19, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 21, .length = 1, .constant = 3},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 22, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACKET, .offset = 23, .length = 1}
+			},
+			.count = 15,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 0}, {CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 2}, {CYMB_CONSTANT_INT, 3}}
+		}, CYMB_SUCCESS, {}, {}, 15, test8String.string}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
 	CymbNode nodes0[] = {
+		{},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[0].tokens.tokens[0].constant,
-			.info = tests[0].tokens.tokens[0].info
+			.constantNode = {CYMB_CONSTANT_INT, 5},
+			.token = 0
 		}
 	};
-	tests[0].solution.root = nodes0 + 0;
+	tests[0].solution = (CymbTestTree){nodes0, nullptr, 1};
 	CymbDiagnostic diagnostics0[] = {
 		{
 			.type = CYMB_EXPECTED_EXPRESSION,
-			.info = tests[0].tokens.tokens[1].info
+			.info = {
+				.position = {1, 3},
+				.line = test0String,
+				.hint = {test0String.string + 2, 1}
+			}
 		}
 	};
 	tests[0].diagnostics.start = diagnostics0;
 
 	CymbNode nodes1[] = {
+		{},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[1].tokens.tokens[0].info
+			.token = 0
 		}
 	};
-	tests[1].solution.root = nodes1 + 0;
+	tests[1].solution = (CymbTestTree){nodes1, nullptr, 1};
 
 	CymbNode nodes2[] = {
+		{},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 5},
-			.info = tests[2].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 26},
-			.info = tests[2].tokens.tokens[5].info
+			.token = 5
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 27},
-			.info = tests[2].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 28},
-			.info = tests[2].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = &nodes2[2],
-				.rightNode = &nodes2[3]
+				.leftNode = 3,
+				.rightNode = 4
 			},
-			.info = tests[2].tokens.tokens[8].info
+			.token = 8
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes2[1],
-				.rightNode = &nodes2[4]
+				.leftNode = 2,
+				.rightNode = 5
 			},
-			.info = tests[2].tokens.tokens[6].info
+			.token = 6
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 29},
-			.info = tests[2].tokens.tokens[11].info
+			.token = 11
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes2[5],
-				.rightNode = &nodes2[6]
+				.leftNode = 6,
+				.rightNode = 7
 			},
-			.info = tests[2].tokens.tokens[10].info
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = &nodes2[0],
-				.rightNode = &nodes2[7]
+				.leftNode = 1,
+				.rightNode = 8
 			},
-			.info = tests[2].tokens.tokens[3].info
+			.token = 3
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 37},
-			.info = tests[2].tokens.tokens[14].info
+			.token = 14
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes2[8],
-				.rightNode = &nodes2[9]
+				.leftNode = 9,
+				.rightNode = 10
 			},
-			.info = tests[2].tokens.tokens[13].info
+			.token = 13
 		}
 	};
-	tests[2].solution.root = nodes2 + 10;
+	tests[2].solution = (CymbTestTree){nodes2, nullptr, 11};
 
 	CymbNode nodes3[] = {
+		{},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 0},
-			.info = tests[3].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 1},
-			.info = tests[3].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 2},
-			.info = tests[3].tokens.tokens[4].info
+			.token = 4
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_LESSFT_SHIFT,
-				.leftNode = &nodes3[1],
-				.rightNode = &nodes3[2]
+				.leftNode = 2,
+				.rightNode = 3
 			},
-			.info = tests[3].tokens.tokens[3].info
+			.token = 3
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 3},
-			.info = tests[3].tokens.tokens[6].info
+			.token = 6
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 4},
-			.info = tests[3].tokens.tokens[8].info
+			.token = 8
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 5},
-			.info = tests[3].tokens.tokens[10].info
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = &nodes3[5],
-				.rightNode = &nodes3[6]
+				.leftNode = 6,
+				.rightNode = 7
 			},
-			.info = tests[3].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes3[4],
-				.rightNode = &nodes3[7]
+				.leftNode = 5,
+				.rightNode = 8
 			},
-			.info = tests[3].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_EQUAL,
-				.leftNode = &nodes3[3],
-				.rightNode = &nodes3[8]
+				.leftNode = 4,
+				.rightNode = 9
 			},
-			.info = tests[3].tokens.tokens[5].info
+			.token = 5
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_BITWISE_AND,
-				.leftNode = &nodes3[0],
-				.rightNode = &nodes3[9]
+				.leftNode = 1,
+				.rightNode = 10
 			},
-			.info = tests[3].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 6},
-			.info = tests[3].tokens.tokens[12].info
+			.token = 12
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 7},
-			.info = tests[3].tokens.tokens[14].info
+			.token = 14
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 8},
-			.info = tests[3].tokens.tokens[16].info
+			.token = 16
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 9},
-			.info = tests[3].tokens.tokens[18].info
+			.token = 18
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 10},
-			.info = tests[3].tokens.tokens[20].info
+			.token = 20
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_DIVISION,
-				.leftNode = &nodes3[14],
-				.rightNode = &nodes3[15]
+				.leftNode = 15,
+				.rightNode = 16
 			},
-			.info = tests[3].tokens.tokens[19].info
+			.token = 19
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_RIGHT_SHIFT,
-				.leftNode = &nodes3[13],
-				.rightNode = &nodes3[16]
+				.leftNode = 14,
+				.rightNode = 17
 			},
-			.info = tests[3].tokens.tokens[17].info
+			.token = 17
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_LESS,
-				.leftNode = &nodes3[12],
-				.rightNode = &nodes3[17]
+				.leftNode = 13,
+				.rightNode = 18
 			},
-			.info = tests[3].tokens.tokens[15].info
+			.token = 15
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_BITWISE_EXCLUSIVE_OR,
-				.leftNode = &nodes3[11],
-				.rightNode = &nodes3[18]
+				.leftNode = 12,
+				.rightNode = 19
 			},
-			.info = tests[3].tokens.tokens[13].info
+			.token = 13
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 11},
-			.info = tests[3].tokens.tokens[22].info
+			.token = 22
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 12},
-			.info = tests[3].tokens.tokens[24].info
+			.token = 24
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_SUBTRACTION,
-				.leftNode = &nodes3[20],
-				.rightNode = &nodes3[21]
+				.leftNode = 21,
+				.rightNode = 22
 			},
-			.info = tests[3].tokens.tokens[23].info
+			.token = 23
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 13},
-			.info = tests[3].tokens.tokens[26].info
+			.token = 26
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_GREATER_EQUAL,
-				.leftNode = &nodes3[22],
-				.rightNode = &nodes3[23]
+				.leftNode = 23,
+				.rightNode = 24
 			},
-			.info = tests[3].tokens.tokens[25].info
+			.token = 25
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 14},
-			.info = tests[3].tokens.tokens[28].info
+			.token = 28
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 15},
-			.info = tests[3].tokens.tokens[30].info
+			.token = 30
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_LESS_EQUAL,
-				.leftNode = &nodes3[25],
-				.rightNode = &nodes3[26]
+				.leftNode = 26,
+				.rightNode = 27
 			},
-			.info = tests[3].tokens.tokens[29].info
+			.token = 29
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_NOT_EQUAL,
-				.leftNode = &nodes3[24],
-				.rightNode = &nodes3[27]
+				.leftNode = 25,
+				.rightNode = 28
 			},
-			.info = tests[3].tokens.tokens[27].info
+			.token = 27
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 16},
-			.info = tests[3].tokens.tokens[32].info
+			.token = 32
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 17},
-			.info = tests[3].tokens.tokens[34].info
+			.token = 34
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 18},
-			.info = tests[3].tokens.tokens[36].info
+			.token = 36
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_REMAINDER,
-				.leftNode = &nodes3[30],
-				.rightNode = &nodes3[31]
+				.leftNode = 31,
+				.rightNode = 32
 			},
-			.info = tests[3].tokens.tokens[35].info
+			.token = 35
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_GREATER,
-				.leftNode = &nodes3[29],
-				.rightNode = &nodes3[32]
+				.leftNode = 30,
+				.rightNode = 33
 			},
-			.info = tests[3].tokens.tokens[33].info
+			.token = 33
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_BITWISE_OR,
-				.leftNode = &nodes3[28],
-				.rightNode = &nodes3[33]
+				.leftNode = 29,
+				.rightNode = 34
 			},
-			.info = tests[3].tokens.tokens[31].info
+			.token = 31
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_LOGICAL_AND,
-				.leftNode = &nodes3[19],
-				.rightNode = &nodes3[34]
+				.leftNode = 20,
+				.rightNode = 35
 			},
-			.info = tests[3].tokens.tokens[21].info
+			.token = 21
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_LOGICAL_OR,
-				.leftNode = &nodes3[10],
-				.rightNode = &nodes3[35]
+				.leftNode = 11,
+				.rightNode = 36
 			},
-			.info = tests[3].tokens.tokens[11].info
+			.token = 11
 		}
 	};
-	tests[3].solution.root = nodes3 + 36;
+	tests[3].solution = (CymbTestTree){nodes3, nullptr, 37};
 
 	CymbNode nodes4[] = {
+		{},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.info = tests[4].tokens.tokens[2].info,
-			.constantNode = tests[4].tokens.tokens[2].constant
+			.token = 2,
+			.constantNode = {CYMB_CONSTANT_INT, 0}
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[1].info,
+			.token = 1,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_BITWISE_NOT,
-				.node = &nodes4[0]
+				.node = 1
 			}
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[0].info,
+			.token = 0,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_NEGATIVE,
-				.node = &nodes4[1]
+				.node = 2
 			}
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[4].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[6].info,
+			.token = 6,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_ADDRESS,
-				.node = &nodes4[3]
+				.node = 4
 			}
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[5].info,
+			.token = 5,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_INDIRECTION,
-				.node = &nodes4[4]
+				.node = 5
 			}
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[4].tokens.tokens[14].info
+			.token = 14
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[13].info,
+			.token = 13,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_POSITIVE,
-				.node = &nodes4[6]
+				.node = 7
 			}
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[12].info,
+			.token = 12,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_DECREMENT,
-				.node = &nodes4[7]
+				.node = 8
 			}
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[10].info,
+			.token = 10,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_LOGICAL_NOT,
-				.node = &nodes4[8]
+				.node = 9
 			}
 		},
 		{
 			.type = CYMB_NODE_UNARY_OPERATOR,
-			.info = tests[4].tokens.tokens[9].info,
+			.token = 9,
 			.unaryOperatorNode = {
 				.operator = CYMB_UNARY_OPERATOR_INCREMENT,
-				.node = &nodes4[9]
+				.node = 10
 			}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[4].tokens.tokens[8].info,
+			.token = 8,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_SUBTRACTION,
-				.leftNode = &nodes4[5],
-				.rightNode = &nodes4[10]
+				.leftNode = 6,
+				.rightNode = 11
 			}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[4].tokens.tokens[3].info,
+			.token = 3,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = &nodes4[2],
-				.rightNode = &nodes4[11]
+				.leftNode = 3,
+				.rightNode = 12
 			}
 		}
 	};
-	tests[4].solution.root = nodes4 + 12;
+	tests[4].solution = (CymbTestTree){nodes4, nullptr, 13};
 
 	CymbNode nodes5[] = {
+		{},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[5].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[5].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.info = tests[5].tokens.tokens[4].info,
+			.token = 4,
 			.constantNode = {CYMB_CONSTANT_INT, 5}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[5].tokens.tokens[3].info,
+			.token = 3,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = &nodes5[1],
-				.rightNode = &nodes5[2]
+				.leftNode = 2,
+				.rightNode = 3
 			}
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.info = tests[5].tokens.tokens[6].info,
+			.token = 6,
 			.constantNode = {CYMB_CONSTANT_INT, 3}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[5].tokens.tokens[5].info,
+			.token = 5,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = &nodes5[3],
-				.rightNode = &nodes5[4]
+				.leftNode = 4,
+				.rightNode = 5
 			}
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.info = tests[5].tokens.tokens[8].info,
+			.token = 8,
 			.constantNode = {CYMB_CONSTANT_INT, 1}
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.info = tests[5].tokens.tokens[10].info,
+			.token = 10,
 			.constantNode = {CYMB_CONSTANT_INT, 2}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[5].tokens.tokens[9].info,
+			.token = 9,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes5[6],
-				.rightNode = &nodes5[7]
+				.leftNode = 7,
+				.rightNode = 8
 			}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[5].tokens.tokens[7].info,
+			.token = 7,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ASSIGNMENT,
-				.leftNode = &nodes5[5],
-				.rightNode = &nodes5[8]
+				.leftNode = 6,
+				.rightNode = 9
 			}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[5].tokens.tokens[1].info,
+			.token = 1,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION_ASSIGNMENT,
-				.leftNode = &nodes5[0],
-				.rightNode = &nodes5[9]
+				.leftNode = 1,
+				.rightNode = 10
 			}
 		}
 	};
-	tests[5].solution.root = nodes5 + 10;
+	tests[5].solution = (CymbTestTree){nodes5, nullptr, 11};
 
 	CymbNode nodes6[] = {
+		{},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[3].info
+			.token = 3
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[5].info
+			.token = 5
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes6[1],
-				.rightNode = &nodes6[2]
+				.leftNode = 2,
+				.rightNode = 3
 			},
-			.info = tests[6].tokens.tokens[4].info
+			.token = 4
 		}
 	};
-	tests[6].solution.root = nodes6 + 3;
+	tests[6].solution = (CymbTestTree){nodes6, nullptr, 4};
 	CymbDiagnostic diagnostics6[] = {
 		{
 			.type = CYMB_UNMATCHED_PARENTHESIS,
-			.info = tests[6].tokens.tokens[2].info
+			.info = {
+				.position = {1, 5},
+				.line = test6String,
+				.hint = {test6String.string + 4, 1}
+			}
 		}
 	};
 	tests[6].diagnostics.start = diagnostics6;
 
 	CymbNode nodes7[] = {
+		{},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[7].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[7].tokens.tokens[2].constant,
-			.info = tests[7].tokens.tokens[2].info
+			.constantNode = {CYMB_CONSTANT_INT, 5},
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_CALL,
-			.functionCallNode = {.name = nodes7 + 0},
-			.info = nodes7[0].info
+			.functionCallNode = {.name = 1},
+			.token = nodes7[1].token
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[7].tokens.tokens[6].info
+			.token = 6
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[7].tokens.tokens[8].info
+			.token = 8
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[7].tokens.tokens[10].constant,
-			.info = tests[7].tokens.tokens[10].info
+			.constantNode = {CYMB_CONSTANT_INT, 2},
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_CALL,
-			.functionCallNode = {.name = nodes7 + 3},
-			.info = nodes7[3].info
+			.functionCallNode = {.name = 4},
+			.token = nodes7[4].token
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[7].tokens.tokens[13].info
+			.token = 13
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[7].tokens.tokens[15].constant,
-			.info = tests[7].tokens.tokens[15].info
+			.constantNode = {CYMB_CONSTANT_INT, 1},
+			.token = 15
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[7].tokens.tokens[17].info
+			.token = 17
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[7].tokens.tokens[19].constant,
-			.info = tests[7].tokens.tokens[19].info
+			.constantNode = {CYMB_CONSTANT_INT, 3},
+			.token = 19
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[7].tokens.tokens[21].info
+			.token = 21
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_CALL,
-			.functionCallNode = {.name = nodes7 + 7},
-			.info = nodes7[7].info
+			.functionCallNode = {.name = 8},
+			.token = nodes7[8].token
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_SUBTRACTION,
-				.leftNode = nodes7 + 6,
-				.rightNode = nodes7 + 12
+				.leftNode = 7,
+				.rightNode = 13
 			},
-			.info = tests[7].tokens.tokens[12].info
+			.token = 12
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_MULTIPLICATION,
-				.leftNode = nodes7 + 2,
-				.rightNode = nodes7 + 13
+				.leftNode = 3,
+				.rightNode = 14
 			},
-			.info = tests[7].tokens.tokens[4].info
+			.token = 4
 		}
 	};
-	CymbNodeChild children7[] = {
-		{
-			.node = nodes7 + 1
-		},
-		{
-			.node = nodes7 + 4,
-			.next = children7 + 2
-		},
-		{
-			.node = nodes7 + 5
-		},
-		{
-			.node = nodes7 + 8,
-			.next = children7 + 4
-		},
-		{
-			.node = nodes7 + 9,
-			.next = children7 + 5
-		},
-		{
-			.node = nodes7 + 10,
-			.next = children7 + 6
-		},
-		{
-			.node = nodes7 + 11
-		}
-	};
-	nodes7[2].functionCallNode.arguments = children7 + 0;
-	nodes7[6].functionCallNode.arguments = children7 + 1;
-	nodes7[12].functionCallNode.arguments = children7 + 3;
-	tests[7].solution.root = nodes7 + 14;
+	CymbNodeIndex children7[] = {2, 5, 6, 9, 10, 11, 12};
+	nodes7[3].functionCallNode.arguments = (CymbNodeSpan){0, 1};
+	nodes7[7].functionCallNode.arguments = (CymbNodeSpan){1, 2};
+	nodes7[13].functionCallNode.arguments = (CymbNodeSpan){3, 4};
+	tests[7].solution = (CymbTestTree){nodes7, children7, 15};
 
 	CymbNode nodes8[] = {
+		{},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[8].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[8].tokens.tokens[2].constant,
-			.info = tests[8].tokens.tokens[2].info
+			.constantNode = {CYMB_CONSTANT_INT, 0},
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_ARRAY_SUBSCRIPT,
 			.arraySubscriptNode = {
-				.name = nodes8 + 0,
-				.expression = nodes8 + 1
+				.name = 1,
+				.expression = 2
 			},
-			.info = nodes8[0].info
+			.token = nodes8[1].token
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[8].tokens.tokens[5].info
+			.token = 5
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[8].tokens.tokens[7].constant,
-			.info = tests[8].tokens.tokens[7].info
+			.constantNode = {CYMB_CONSTANT_INT, 1},
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_ARRAY_SUBSCRIPT,
 			.arraySubscriptNode = {
-				.name = nodes8 + 3,
-				.expression = nodes8 + 4
+				.name = 4,
+				.expression = 5
 			},
-			.info = nodes8[3].info
+			.token = nodes8[4].token
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[8].tokens.tokens[10].constant,
-			.info = tests[8].tokens.tokens[10].info
+			.constantNode = {CYMB_CONSTANT_INT, 2},
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
-			.constantNode = tests[8].tokens.tokens[12].constant,
-			.info = tests[8].tokens.tokens[12].info
+			.constantNode = {CYMB_CONSTANT_INT, 3},
+			.token = 12
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_CALL,
-			.functionCallNode = {.name = nodes8 + 5},
-			.info = nodes8[5].info
+			.functionCallNode = {.name = 6},
+			.token = nodes8[6].token
 		},
 		{
 			.type = CYMB_NODE_ARRAY_SUBSCRIPT,
 			.arraySubscriptNode = {
-				.name = nodes8 + 2,
-				.expression = nodes8 + 8
+				.name = 3,
+				.expression = 9
 			},
-			.info = nodes8[2].info
-		}
-	};
-	CymbNodeChild children8[] = {
-		{
-			.node = nodes8 + 6,
-			.next = children8 + 1
-		},
-		{
-			.node = nodes8 + 7
+			.token = nodes8[3].token
 		}
 	};
-	nodes8[8].functionCallNode.arguments = children8 + 0;
-	tests[8].solution.root = nodes8 + 9;
+	CymbNodeIndex children8[] = {7, 8};
+	nodes8[9].functionCallNode.arguments = (CymbNodeSpan){0, 2};
+	tests[8].solution = (CymbTestTree){nodes8, children8, 10};
 
 	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
 	{
@@ -2446,6 +1398,76 @@ static void cymbTestExpressions(CymbTestContext* const context)
 	cymbContextPop(context);
 }
 
+static void cymbTestLongExpressions(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	// Long chains and deep nesting must not exhaust the stack.
+	constexpr size_t depth = 100000;
+	static char string[2 * depth + 2];
+
+	const struct
+	{
+		const char* prefix;
+		const char* suffix;
+		size_t nodeCount;
+	} tests[] = {
+		{"a+", "", 2 * depth + 1},
+		{"a=", "", 2 * depth + 1},
+		{"(", ")", 1},
+		{"!", "", depth + 1}
+	};
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		char* character = string;
+		for(size_t index = 0; index < depth; ++index)
+		{
+			for(const char* prefix = tests[testIndex].prefix; *prefix; ++prefix)
+			{
+				*character++ = *prefix;
+			}
+		}
+		*character++ = 'a';
+		for(size_t index = 0; index < depth && *tests[testIndex].suffix; ++index)
+		{
+			*character++ = *tests[testIndex].suffix;
+		}
+		*character = '\0';
+
+		CymbTokenList tokens;
+		if(cymbLex(string, CYMB_C23, nullptr, &tokens, &context->diagnostics) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Wrong lex result.");
+			goto next;
+		}
+
+		CymbTree tree;
+		cymbTreeCreate(&tree, tokens.tokens);
+
+		CymbTokenList expressionTokens = tokens;
+		if(cymbParseExpression(&tree, &expressionTokens, &context->diagnostics) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Wrong result.");
+		}
+		else if(tree.nodes.count - 1 != tests[testIndex].nodeCount)
+		{
+			cymbFail(context, "Wrong node count.");
+		}
+
+		cymbFreeTree(&tree);
+		cymbFreeTokenList(&tokens);
+
+		next:
+		cymbDiagnosticListFree(&context->diagnostics);
+	}
+
+	cymbContextPop(context);
+}
+
 static void cymbTestTypes(CymbTestContext* const context)
 {
 	cymbContextPush(context, __func__);
@@ -2458,193 +1480,95 @@ static void cymbTestTypes(CymbTestContext* const context)
 	CymbTreeTest tests[] = {
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 1},
-						.line = test0String,
-						.hint = test0String
-					}
-				}
+				{.type = CYMB_TOKEN_INT, .offset = 0, .length = 3}
 			},
 			.count = 1
-		}, CYMB_SUCCESS, {}, {}, 0},
+		}, CYMB_SUCCESS, {}, {}, 0, test0String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_FLOAT,
-					.info = {
-						.position = {1, 1},
-						.line = test1String,
-						.hint = {test1String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 7},
-						.line = test1String,
-						.hint = {test1String.string + 6, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 12},
-						.line = test1String,
-						.hint = {test1String.string + 11, 1}
-					}
-				}
+				{.type = CYMB_TOKEN_FLOAT, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_CONST, .offset = 6, .length = 5},
+				{.type = CYMB_TOKEN_STAR, .offset = 11, .length = 1}
 			},
 			.count = 3
-		}, CYMB_SUCCESS, {}, {}, 0},
+		}, CYMB_SUCCESS, {}, {}, 0, test1String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 1},
-						.line = test2String,
-						.hint = {test2String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CHAR,
-					.info = {
-						.position = {1, 7},
-						.line = test2String,
-						.hint = {test2String.string + 6, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 11},
-						.line = test2String,
-						.hint = {test2String.string + 10, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RESTRICT,
-					.info = {
-						.position = {1, 13},
-						.line = test2String,
-						.hint = {test2String.string + 12, 8}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 21},
-						.line = test2String,
-						.hint = {test2String.string + 20, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 23},
-						.line = test2String,
-						.hint = {test2String.string + 22, 5}
-					}
-				}
+				{.type = CYMB_TOKEN_CONST, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_CHAR, .offset = 6, .length = 4},
+				{.type = CYMB_TOKEN_STAR, .offset = 10, .length = 1},
+				{.type = CYMB_TOKEN_RESTRICT, .offset = 12, .length = 8},
+				{.type = CYMB_TOKEN_STAR, .offset = 20, .length = 1},
+				{.type = CYMB_TOKEN_CONST, .offset = 22, .length = 5}
 			},
 			.count = 6
-		}, CYMB_SUCCESS, {}, {}, 0},
+		}, CYMB_SUCCESS, {}, {}, 0, test2String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 1},
-						.line = test3String,
-						.hint = {test3String.string + 0, 5}
-					}
-				},
-								{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 7},
-						.line = test3String,
-						.hint = {test3String.string + 6, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 13},
-						.line = test3String,
-						.hint = {test3String.string + 12, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 17},
-						.line = test3String,
-						.hint = {test3String.string + 16, 5}
-					}
-				},
-								{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 23},
-						.line = test3String,
-						.hint = {test3String.string + 22, 5}
-					}
-				},
+				{.type = CYMB_TOKEN_CONST, .offset = 0, .length = 5},
+								{.type = CYMB_TOKEN_CONST, .offset = 6, .length = 5},
+				{.type = CYMB_TOKEN_INT, .offset = 12, .length = 3},
+				{.type = CYMB_TOKEN_CONST, .offset = 16, .length = 5},
+								{.type = CYMB_TOKEN_CONST, .offset = 22, .length = 5},
 			},
 			.count = 5
-		}, CYMB_INVALID, {}, {}, 0}
+		}, CYMB_INVALID, {}, {}, 0, test3String.string}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
 	CymbNode nodes0[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[0].tokens.tokens[0].info
+			.token = 0
 		}
 	};
-	tests[0].solution.root = nodes0 + 0;
+	tests[0].solution = (CymbTestTree){nodes0, nullptr, 1};
 
 	CymbNode nodes1[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_FLOAT, .isConst = true},
-			.info = tests[1].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_POINTER,
-			.pointerNode = {.pointedNode = &nodes1[0]},
-			.info = tests[1].tokens.tokens[2].info
+			.pointerNode = {.pointedNode = 1},
+			.token = 2
 		}
 	};
-	tests[1].solution.root = nodes1 + 1;
+	tests[1].solution = (CymbTestTree){nodes1, nullptr, 2};
 
 	CymbNode nodes2[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_CHAR, .isConst = true},
-			.info = tests[2].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_POINTER,
-			.pointerNode = {.pointedNode = &nodes2[0], .isRestrict = true},
-			.info = tests[2].tokens.tokens[2].info
+			.pointerNode = {.pointedNode = 1, .isRestrict = true},
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_POINTER,
-			.pointerNode = {.pointedNode = &nodes2[1], .isConst = true},
-			.info = tests[2].tokens.tokens[4].info
+			.pointerNode = {.pointedNode = 2, .isConst = true},
+			.token = 4
 		}
 	};
-	tests[2].solution.root = nodes2 + 2;
+	tests[2].solution = (CymbTestTree){nodes2, nullptr, 3};
 
 	CymbDiagnostic diagnostics3[] = {
 		{
 			.type = CYMB_MULTIPLE_CONST,
-			.info = tests[3].tokens.tokens[1].info
+			.info = {
+				.position = {1, 7},
+				.line = test3String,
+				.hint = {test3String.string + 6, 5}
+			}
 		}
 	};
 	tests[3].diagnostics.start = diagnostics3;
@@ -2674,628 +1598,307 @@ static void cymbTestStatements(CymbTestContext* const context)
 	CymbTreeTest tests[] = {
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 1},
-						.line = test0String,
-						.hint = test0String
-					}
-				}
+				{.type = CYMB_TOKEN_RETURN, .offset = 0, .length = 6}
 			},
 			.count = 1
-		}, CYMB_INVALID, {}, {}, 0},
+		}, CYMB_INVALID, {}, {}, 0, test0String.string},
 		{{
 			.tokens = (CymbToken[]){
 				{.type = CYMB_TOKEN_SEMICOLON}
 			},
 			.count = 1
-		}, CYMB_SUCCESS, {}, {}, 0},
+		}, CYMB_SUCCESS, {}, {}, 0, nullptr},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 1},
-						.line = test2String,
-						.hint = {test2String.string + 0, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 7},
-						.line = test2String,
-						.hint = {test2String.string + 6, 1}
-					}
-				}
+				{.type = CYMB_TOKEN_RETURN, .offset = 0, .length = 6},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 6, .length = 1}
 			},
 			.count = 2
-		}, CYMB_SUCCESS, {}, {}, 2},
+		}, CYMB_SUCCESS, {}, {}, 2, test2String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 1},
-						.line = test3String,
-						.hint = {test3String.string + 0, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 8},
-						.line = test3String,
-						.hint = {test3String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 10},
-						.line = test3String,
-						.hint = {test3String.string + 9, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 12},
-						.line = test3String,
-						.hint = {test3String.string + 11, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 13},
-						.line = test3String,
-						.hint = {test3String.string + 12, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 3},
-					.info = {
-						.position = {1, 15},
-						.line = test3String,
-						.hint = {test3String.string + 14, 1}
-					}
-				}
-			},
-			.count = 6
-		}, CYMB_SUCCESS, {}, {}, 5},
+				{.type = CYMB_TOKEN_RETURN, .offset = 0, .length = 6},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 7, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_PLUS, .offset = 9, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 11, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 12, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 14, .length = 1, .constant = 2}
+			},
+			.count = 6,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 2}, {CYMB_CONSTANT_INT, 3}}
+		}, CYMB_SUCCESS, {}, {}, 5, test3String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 1},
-						.line = test4String,
-						.hint = {test4String.string + 0, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = test4String,
-						.hint = {test4String.string + 4, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 11},
-						.line = test4String,
-						.hint = {test4String.string + 10, 1}
-					}
-				}
+				{.type = CYMB_TOKEN_INT, .offset = 0, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 4, .length = 6},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 10, .length = 1}
 			},
 			.count = 3,
-		}, CYMB_SUCCESS, {}, {}, 3},
+		}, CYMB_SUCCESS, {}, {}, 3, test4String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 1},
-						.line = test5String,
-						.hint = {test5String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_LONG,
-					.info = {
-						.position = {1, 7},
-						.line = test5String,
-						.hint = {test5String.string + 6, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 12},
-						.line = test5String,
-						.hint = {test5String.string + 11, 9}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_EQUAL,
-					.info = {
-						.position = {1, 22},
-						.line = test5String,
-						.hint = {test5String.string + 21, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 24},
-						.line = test5String,
-						.hint = {test5String.string + 23, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 25},
-						.line = test5String,
-						.hint = {test5String.string + 24, 1}
-					}
-				}
-			},
-			.count = 6
-		}, CYMB_SUCCESS, {}, {}, 6},
+				{.type = CYMB_TOKEN_CONST, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_LONG, .offset = 6, .length = 4},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 11, .length = 9},
+				{.type = CYMB_TOKEN_EQUAL, .offset = 21, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 23, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 24, .length = 1}
+			},
+			.count = 6,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 1}}
+		}, CYMB_SUCCESS, {}, {}, 6, test5String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_WHILE,
-					.info = {
-						.position = {1, 1},
-						.line = test6String,
-						.hint = {test6String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 6},
-						.line = test6String,
-						.hint = {test6String.string + 5, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 7},
-						.line = test6String,
-						.hint = {test6String.string + 6, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_GREATER,
-					.info = {
-						.position = {1, 9},
-						.line = test6String,
-						.hint = {test6String.string + 8, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 11},
-						.line = test6String,
-						.hint = {test6String.string + 10, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 12},
-						.line = test6String,
-						.hint = {test6String.string + 11, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 13},
-						.line = test6String,
-						.hint = {test6String.string + 12, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 14},
-						.line = test6String,
-						.hint = {test6String.string + 13, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 18},
-						.line = test6String,
-						.hint = {test6String.string + 17, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_EQUAL,
-					.info = {
-						.position = {1, 20},
-						.line = test6String,
-						.hint = {test6String.string + 19, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 3},
-					.info = {
-						.position = {1, 22},
-						.line = test6String,
-						.hint = {test6String.string + 21, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 23},
-						.line = test6String,
-						.hint = {test6String.string + 22, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 25},
-						.line = test6String,
-						.hint = {test6String.string + 24, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS_EQUAL,
-					.info = {
-						.position = {1, 27},
-						.line = test6String,
-						.hint = {test6String.string + 26, 2}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 30},
-						.line = test6String,
-						.hint = {test6String.string + 29, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 32},
-						.line = test6String,
-						.hint = {test6String.string + 31, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 5},
-					.info = {
-						.position = {1, 34},
-						.line = test6String,
-						.hint = {test6String.string + 33, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 35},
-						.line = test6String,
-						.hint = {test6String.string + 34, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 36},
-						.line = test6String,
-						.hint = {test6String.string + 35, 1}
-					}
-				}
-			},
-			.count = 19
-		}, CYMB_SUCCESS, {}, {}, 19},
+				{.type = CYMB_TOKEN_WHILE, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 5, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 6, .length = 1},
+				{.type = CYMB_TOKEN_GREATER, .offset = 8, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 10, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 11, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 12, .length = 1},
+				{.type = CYMB_TOKEN_INT, .offset = 13, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 17, .length = 1},
+				{.type = CYMB_TOKEN_EQUAL, .offset = 19, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 21, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 22, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 24, .length = 1},
+				{.type = CYMB_TOKEN_PLUS_EQUAL, .offset = 26, .length = 2},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 29, .length = 1},
+				{.type = CYMB_TOKEN_PLUS, .offset = 31, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 33, .length = 1, .constant = 2},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 34, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 35, .length = 1}
+			},
+			.count = 19,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 5}, {CYMB_CONSTANT_INT, 3}, {CYMB_CONSTANT_INT, 5}}
+		}, CYMB_SUCCESS, {}, {}, 19, test6String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_WHILE,
-					.info = {
-						.position = {1, 1},
-						.line = test7String,
-						.hint = {test7String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 6},
-						.line = test7String,
-						.hint = {test7String.string + 5, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 0},
-					.info = {
-						.position = {1, 7},
-						.line = test7String,
-						.hint = {test7String.string + 6, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 8},
-						.line = test7String,
-						.hint = {test7String.string + 7, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 9},
-						.line = test7String,
-						.hint = {test7String.string + 8, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 15},
-						.line = test7String,
-						.hint = {test7String.string + 14, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 16},
-						.line = test7String,
-						.hint = {test7String.string + 15, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 22},
-						.line = test7String,
-						.hint = {test7String.string + 21, 1}
-					}
-				},
-			},
-			.count = 8
-		}, CYMB_SUCCESS, {}, {}, 6}
+				{.type = CYMB_TOKEN_WHILE, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 5, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 6, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 7, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 8, .length = 6},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 14, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 15, .length = 6},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 21, .length = 1},
+			},
+			.count = 8,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 0}}
+		}, CYMB_SUCCESS, {}, {}, 6, test7String.string}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
 	CymbDiagnostic diagnostics0[] = {
 		{
 			.type = CYMB_EXPECTED_SEMICOLON,
-			.info = tests[0].tokens.tokens[0].info
+			.info = {
+				.position = {1, 1},
+				.line = test0String,
+				.hint = {test0String.string, 6}
+			}
 		}
 	};
 	tests[0].diagnostics.start = diagnostics0;
 
 	CymbNode nodes2[] = {
+		{},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = nullptr,
-			.info = tests[2].tokens.tokens[0].info
+			.returnNode = 0,
+			.token = 0
 		}
 	};
-	tests[2].solution.root = nodes2 + 0;
+	tests[2].solution = (CymbTestTree){nodes2, nullptr, 1};
 
 	CymbNode nodes3[] = {
+		{},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 1},
-			.info = tests[3].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 2},
-			.info = tests[3].tokens.tokens[3].info
+			.token = 3
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes3[0],
-				.rightNode = &nodes3[1]
+				.leftNode = 1,
+				.rightNode = 2
 			},
-			.info = tests[3].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = &nodes3[2],
-			.info = tests[3].tokens.tokens[0].info
+			.returnNode = 3,
+			.token = 0
 		}
 	};
-	tests[3].solution.root = nodes3 + 3;
+	tests[3].solution = (CymbTestTree){nodes3, nullptr, 4};
 
 	CymbNode nodes4[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[4].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[4].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_DECLARATION,
 			.declarationNode = {
-				.type = &nodes4[0],
-				.identifier = &nodes4[1]
+				.type = 1,
+				.identifier = 2
 			},
-			.info = tests[4].tokens.tokens[1].info
+			.token = 1
 		}
 	};
-	tests[4].solution.root = nodes4 + 2;
+	tests[4].solution = (CymbTestTree){nodes4, nullptr, 3};
 
 	CymbNode nodes5[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_LONG, .isConst = true},
-			.info = tests[5].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[5].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 1},
-			.info = tests[5].tokens.tokens[4].info
+			.token = 4
 		},
 		{
 			.type = CYMB_NODE_DECLARATION,
 			.declarationNode = {
-				.type = &nodes5[0],
-				.identifier = &nodes5[1],
-				.initializer = &nodes5[2]
+				.type = 1,
+				.identifier = 2,
+				.initializer = 3
 			},
-			.info = tests[5].tokens.tokens[2].info
+			.token = 2
 		}
 	};
-	tests[5].solution.root = nodes5 + 3;
+	tests[5].solution = (CymbTestTree){nodes5, nullptr, 4};
 
 	CymbNode nodes6[] = {
+		{},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 5},
-			.info = tests[6].tokens.tokens[4].info
+			.token = 4
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_GREATER,
-				.leftNode = &nodes6[0],
-				.rightNode = &nodes6[1]
+				.leftNode = 1,
+				.rightNode = 2
 			},
-			.info = tests[6].tokens.tokens[3].info
+			.token = 3
 		},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[6].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[8].info
+			.token = 8
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 3},
-			.info = tests[6].tokens.tokens[10].info
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_DECLARATION,
 			.declarationNode = {
-				.type = &nodes6[3],
-				.identifier = &nodes6[4],
-				.initializer = &nodes6[5]
+				.type = 4,
+				.identifier = 5,
+				.initializer = 6
 			},
-			.info = tests[6].tokens.tokens[8].info
+			.token = 8
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[12].info
+			.token = 12
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[6].tokens.tokens[14].info
+			.token = 14
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 5},
-			.info = tests[6].tokens.tokens[16].info
+			.token = 16
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[6].tokens.tokens[15].info,
+			.token = 15,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes6[8],
-				.rightNode = &nodes6[9]
+				.leftNode = 9,
+				.rightNode = 10
 			}
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
-			.info = tests[6].tokens.tokens[13].info,
+			.token = 13,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION_ASSIGNMENT,
-				.leftNode = &nodes6[7],
-				.rightNode = &nodes6[10]
+				.leftNode = 8,
+				.rightNode = 11
 			}
 		},
 		{
 			.type = CYMB_NODE_WHILE,
 			.whileNode = {
-				.expression = &nodes6[2]
+				.expression = 3
 			},
-			.info = tests[6].tokens.tokens[0].info
+			.token = 0
 		}
 	};
-	CymbNodeChild children6[] = {
-		{
-			.node = &nodes6[6],
-			.next = &children6[1]
-		},
-		{
-			.node = &nodes6[11]
-		}
-	};
-	nodes6[12].whileNode.body = children6 + 0;
-	tests[6].solution.root = nodes6 + 12;
+	CymbNodeIndex children6[] = {7, 12};
+	nodes6[13].whileNode.body = (CymbNodeSpan){0, 2};
+	tests[6].solution = (CymbTestTree){nodes6, children6, 13};
 
 	CymbNode nodes7[] = {
+		{},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 0},
-			.info = tests[7].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = nullptr,
-			.info = tests[7].tokens.tokens[4].info
+			.returnNode = 0,
+			.token = 4
 		},
 		{
 			.type = CYMB_NODE_WHILE,
 			.whileNode = {
-				.expression = &nodes7[0]
+				.expression = 1
 			},
-			.info = tests[7].tokens.tokens[0].info
+			.token = 0
 		}
 	};
-	CymbNodeChild children7[] = {
-		{
-			.node = &nodes7[1]
-		}
-	};
-	nodes7[2].whileNode.body = children7 + 0;
-	tests[7].solution.root = nodes7 + 2;
+	CymbNodeIndex children7[] = {2};
+	nodes7[3].whileNode.body = (CymbNodeSpan){0, 1};
+	tests[7].solution = (CymbTestTree){nodes7, children7, 3};
 
 	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
 	{
@@ -3319,781 +1922,330 @@ static void cymbTestFunctions(CymbTestContext* const context)
 	CymbTreeTest tests[] = {
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 1},
-						.line = test0String,
-						.hint = {test0String.string + 0, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = test0String,
-						.hint = {test0String.string + 4, 9}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 14},
-						.line = test0String,
-						.hint = {test0String.string + 13, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_VOID,
-					.info = {
-						.position = {1, 15},
-						.line = test0String,
-						.hint = {test0String.string + 14, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 19},
-						.line = test0String,
-						.hint = {test0String.string + 18, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 20},
-						.line = test0String,
-						.hint = {test0String.string + 19, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 21},
-						.line = test0String,
-						.hint = {test0String.string + 20, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 28},
-						.line = test0String,
-						.hint = {test0String.string + 27, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 30},
-						.line = test0String,
-						.hint = {test0String.string + 29, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 32},
-						.line = test0String,
-						.hint = {test0String.string + 31, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 33},
-						.line = test0String,
-						.hint = {test0String.string + 32, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 35},
-						.line = test0String,
-						.hint = {test0String.string + 34, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 41},
-						.line = test0String,
-						.hint = {test0String.string + 40, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 43},
-						.line = test0String,
-						.hint = {test0String.string + 42, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 0},
-					.info = {
-						.position = {1, 50},
-						.line = test0String,
-						.hint = {test0String.string + 49, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 51},
-						.line = test0String,
-						.hint = {test0String.string + 50, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 52},
-						.line = test0String,
-						.hint = {test0String.string + 51, 3}
-					}
-				}
-			},
-			.count = 17
-		}, CYMB_SUCCESS, {}, {}, 17},
+				{.type = CYMB_TOKEN_INT, .offset = 0, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 4, .length = 9},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 13, .length = 1},
+				{.type = CYMB_TOKEN_VOID, .offset = 14, .length = 4},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 18, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 19, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 20, .length = 6},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 27, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_PLUS, .offset = 29, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 31, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 32, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 34, .length = 6},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 40, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 42, .length = 6},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 49, .length = 1, .constant = 2},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 50, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 51, .length = 3}
+			},
+			.count = 17,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 2}, {CYMB_CONSTANT_INT, 0}}
+		}, CYMB_SUCCESS, {}, {}, 17, test0String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 1},
-						.line = test1String,
-						.hint = {test1String.string + 0, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_FLOAT,
-					.info = {
-						.position = {1, 7},
-						.line = test1String,
-						.hint = {test1String.string + 6, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 12},
-						.line = test1String,
-						.hint = {test1String.string + 11, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 14},
-						.line = test1String,
-						.hint = {test1String.string + 13, 15}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 29},
-						.line = test1String,
-						.hint = {test1String.string + 28, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 30},
-						.line = test1String,
-						.hint = {test1String.string + 29, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 31},
-						.line = test1String,
-						.hint = {test1String.string + 30, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 32},
-						.line = test1String,
-						.hint = {test1String.string + 31, 1}
-					}
-				}
+				{.type = CYMB_TOKEN_CONST, .offset = 0, .length = 5},
+				{.type = CYMB_TOKEN_FLOAT, .offset = 6, .length = 5},
+				{.type = CYMB_TOKEN_STAR, .offset = 11, .length = 1},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 13, .length = 15},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 28, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 29, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 30, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 31, .length = 1}
 			},
 			.count = 8
-		}, CYMB_SUCCESS, {}, {}, 8},
+		}, CYMB_SUCCESS, {}, {}, 8, test1String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 1},
-						.line = test2String,
-						.hint = {test2String.string + 0, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = test2String,
-						.hint = {test2String.string + 4, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 9},
-						.line = test2String,
-						.hint = {test2String.string + 8, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 10},
-						.line = test2String,
-						.hint = {test2String.string + 9, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 11},
-						.line = test2String,
-						.hint = {test2String.string + 10, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 12},
-						.line = test2String,
-						.hint = {test2String.string + 11, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 18},
-						.line = test2String,
-						.hint = {test2String.string + 17, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 22},
-						.line = test2String,
-						.hint = {test2String.string + 21, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_EQUAL,
-					.info = {
-						.position = {1, 24},
-						.line = test2String,
-						.hint = {test2String.string + 23, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 26},
-						.line = test2String,
-						.hint = {test2String.string + 25, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 27},
-						.line = test2String,
-						.hint = {test2String.string + 26, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 29},
-						.line = test2String,
-						.hint = {test2String.string + 28, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 36},
-						.line = test2String,
-						.hint = {test2String.string + 35, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_PLUS,
-					.info = {
-						.position = {1, 38},
-						.line = test2String,
-						.hint = {test2String.string + 37, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 2},
-					.info = {
-						.position = {1, 40},
-						.line = test2String,
-						.hint = {test2String.string + 39, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 41},
-						.line = test2String,
-						.hint = {test2String.string + 40, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 42},
-						.line = test2String,
-						.hint = {test2String.string + 41, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 41},
-						.line = test2String,
-						.hint = {test2String.string + 42, 1}
-					}
-				}
-			},
-			.count = 18
-		}, CYMB_SUCCESS, {}, {}, 17},
+				{.type = CYMB_TOKEN_INT, .offset = 0, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 4, .length = 4},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 8, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 9, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 10, .length = 1},
+				{.type = CYMB_TOKEN_CONST, .offset = 11, .length = 5},
+				{.type = CYMB_TOKEN_INT, .offset = 17, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 21, .length = 1},
+				{.type = CYMB_TOKEN_EQUAL, .offset = 23, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 25, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 26, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 28, .length = 6},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 35, .length = 1},
+				{.type = CYMB_TOKEN_PLUS, .offset = 37, .length = 1},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 39, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 40, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 41, .length = 1},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 42, .length = 1}
+			},
+			.count = 18,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 2}}
+		}, CYMB_SUCCESS, {}, {}, 17, test2String.string},
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_VOID,
-					.info = {
-						.position = {1, 1},
-						.line = test3String,
-						.hint = {test3String.string + 0, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 6},
-						.line = test3String,
-						.hint = {test3String.string + 5, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 11},
-						.line = test3String,
-						.hint = {test3String.string + 10, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 12},
-						.line = test3String,
-						.hint = {test3String.string + 11, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 18},
-						.line = test3String,
-						.hint = {test3String.string + 17, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_STAR,
-					.info = {
-						.position = {1, 19},
-						.line = test3String,
-						.hint = {test3String.string + 18, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONST,
-					.info = {
-						.position = {1, 21},
-						.line = test3String,
-						.hint = {test3String.string + 20, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 27},
-						.line = test3String,
-						.hint = {test3String.string + 26, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_COMMA,
-					.info = {
-						.position = {1, 28},
-						.line = test3String,
-						.hint = {test3String.string + 27, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_FLOAT,
-					.info = {
-						.position = {1, 30},
-						.line = test3String,
-						.hint = {test3String.string + 29, 5}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 36},
-						.line = test3String,
-						.hint = {test3String.string + 35, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 37},
-						.line = test3String,
-						.hint = {test3String.string + 36, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 38},
-						.line = test3String,
-						.hint = {test3String.string + 37, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 39},
-						.line = test3String,
-						.hint = {test3String.string + 38, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 45},
-						.line = test3String,
-						.hint = {test3String.string + 44, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 46},
-						.line = test3String,
-						.hint = {test3String.string + 45, 1}
-					}
-				}
+				{.type = CYMB_TOKEN_VOID, .offset = 0, .length = 4},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 5, .length = 3},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 10, .length = 1},
+				{.type = CYMB_TOKEN_CONST, .offset = 11, .length = 5},
+				{.type = CYMB_TOKEN_INT, .offset = 17, .length = 3},
+				{.type = CYMB_TOKEN_STAR, .offset = 18, .length = 1},
+				{.type = CYMB_TOKEN_CONST, .offset = 20, .length = 5},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 26, .length = 1},
+				{.type = CYMB_TOKEN_COMMA, .offset = 27, .length = 1},
+				{.type = CYMB_TOKEN_FLOAT, .offset = 29, .length = 5},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 35, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 36, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 37, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 38, .length = 6},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 44, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 45, .length = 1}
 			},
 			.count = 16
-		}, CYMB_SUCCESS, {}, {}, 16}
+		}, CYMB_SUCCESS, {}, {}, 16, test3String.string}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
 	CymbNode nodes0[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[0].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_TYPE,
 			.functionTypeNode = {
-				.returnType = &nodes0[0]
+				.returnType = 1
 			},
-			.info = tests[0].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[0].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 1},
-			.info = tests[0].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 2},
-			.info = tests[0].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes0[3],
-				.rightNode = &nodes0[4]
+				.leftNode = 4,
+				.rightNode = 5
 			},
-			.info = tests[0].tokens.tokens[8].info
+			.token = 8
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = &nodes0[5],
-			.info = tests[0].tokens.tokens[6].info
+			.returnNode = 6,
+			.token = 6
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = nullptr,
-			.info = tests[0].tokens.tokens[11].info
+			.returnNode = 0,
+			.token = 11
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 0},
-			.info = tests[0].tokens.tokens[14].info
+			.token = 14
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = &nodes0[8],
-			.info = tests[0].tokens.tokens[13].info
+			.returnNode = 9,
+			.token = 13
 		},
 		{
 			.type = CYMB_NODE_FUNCTION,
 			.functionNode = {
-				.type = &nodes0[1],
-				.name = &nodes0[2]
+				.type = 2,
+				.name = 3
 			},
-			.info = tests[0].tokens.tokens[1].info
+			.token = 1
 		}
 	};
-	CymbNodeChild children0[] = {
-		{
-			.node = &nodes0[6],
-			.next = &children0[1]
-		},
-		{
-			.node = &nodes0[7],
-			.next = &children0[2]
-		},
-		{
-			.node = &nodes0[9]
-		}
-	};
-	nodes0[10].functionNode.statements = children0 + 0;
-	tests[0].solution.root = nodes0 + 10;
+	CymbNodeIndex children0[] = {7, 8, 10};
+	nodes0[11].functionNode.children = (CymbNodeSpan){0, 3};
+	tests[0].solution = (CymbTestTree){nodes0, children0, 11};
 
 	CymbNode nodes1[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_FLOAT, .isConst = true},
-			.info = tests[1].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_POINTER,
 			.pointerNode = {
-				.pointedNode = &nodes1[0]
+				.pointedNode = 1
 			},
-			.info = tests[1].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_TYPE,
 			.functionTypeNode = {
-				.returnType = &nodes1[1]
+				.returnType = 2
 			},
-			.info = tests[1].tokens.tokens[2].info
+			.token = 2
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[1].tokens.tokens[3].info
+			.token = 3
 		},
 		{
 			.type = CYMB_NODE_FUNCTION,
 			.functionNode = {
-				.type = &nodes1[2],
-				.name = &nodes1[3]
+				.type = 3,
+				.name = 4
 			},
-			.info = tests[1].tokens.tokens[3].info
+			.token = 3
 		}
 	};
-	tests[1].solution.root = nodes1 + 4;
+	tests[1].solution = (CymbTestTree){nodes1, nullptr, 5};
 
 	CymbNode nodes2[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[2].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_TYPE,
 			.functionTypeNode = {
-				.returnType = &nodes2[0]
+				.returnType = 1
 			},
-			.info = tests[2].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[2].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT, .isConst = true},
-			.info = tests[2].tokens.tokens[6].info
+			.token = 6
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[2].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 1},
-			.info = tests[2].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_DECLARATION,
 			.declarationNode = {
-				.type = &nodes2[3],
-				.identifier = &nodes2[4],
-				.initializer = &nodes2[5]
+				.type = 4,
+				.identifier = 5,
+				.initializer = 6
 			},
-			.info = tests[2].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[2].tokens.tokens[12].info
+			.token = 12
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 2},
-			.info = tests[2].tokens.tokens[14].info
+			.token = 14
 		},
 		{
 			.type = CYMB_NODE_BINARY_OPERATOR,
 			.binaryOperatorNode = {
 				.operator = CYMB_BINARY_OPERATOR_ADDITION,
-				.leftNode = &nodes2[7],
-				.rightNode = &nodes2[8]
+				.leftNode = 8,
+				.rightNode = 9
 			},
-			.info = tests[2].tokens.tokens[13].info
+			.token = 13
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = &nodes2[9],
-			.info = tests[2].tokens.tokens[11].info
+			.returnNode = 10,
+			.token = 11
 		},
 		{
 			.type = CYMB_NODE_FUNCTION,
 			.functionNode = {
-				.type = &nodes2[1],
-				.name = &nodes2[2]
+				.type = 2,
+				.name = 3
 			},
-			.info = tests[2].tokens.tokens[1].info
+			.token = 1
 		}
 	};
-	CymbNodeChild children2[] = {
-		{
-			.node = &nodes2[6],
-			.next = &children2[1]
-		},
-		{
-			.node = &nodes2[10]
-		}
-	};
-	nodes2[11].functionNode.statements = children2 + 0;
-	tests[2].solution.root = nodes2 + 11;
+	CymbNodeIndex children2[] = {7, 11};
+	nodes2[12].functionNode.children = (CymbNodeSpan){0, 2};
+	tests[2].solution = (CymbTestTree){nodes2, children2, 12};
 
 	CymbNode nodes3[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_VOID},
-			.info = tests[3].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT, .isConst = true},
-			.info = tests[3].tokens.tokens[4].info
+			.token = 4
 		},
 		{
 			.type = CYMB_NODE_POINTER,
-			.pointerNode = {.pointedNode = &nodes3[1], .isConst = true},
-			.info = tests[3].tokens.tokens[5].info
+			.pointerNode = {.pointedNode = 2, .isConst = true},
+			.token = 5
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[3].tokens.tokens[7].info
+			.token = 7
 		},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_FLOAT},
-			.info = tests[3].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[3].tokens.tokens[10].info
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_TYPE,
 			.functionTypeNode = {
-				.returnType = &nodes3[0]
+				.returnType = 1
 			},
-			.info = tests[3].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[3].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = nullptr,
-			.info = tests[3].tokens.tokens[13].info
+			.returnNode = 0,
+			.token = 13
 		},
 		{
 			.type = CYMB_NODE_FUNCTION,
 			.functionNode = {
-				.type = &nodes3[6],
-				.name = &nodes3[7]
+				.type = 7,
+				.name = 8
 			},
-			.info = tests[3].tokens.tokens[1].info
+			.token = 1
 		}
 	};
-	CymbNodeChild children3[] = {
-		{
-			.node = &nodes3[2],
-			.next = &children3[1]
-		},
-		{
-			.node = &nodes3[4]
-		},
-		{
-			.node = &nodes3[3],
-			.next = &children3[3]
-		},
-		{
-			.node = &nodes3[5]
-		},
-		{
-			.node = &nodes3[8]
-		}
-	};
-	nodes3[6].functionTypeNode.parameterTypes = children3 + 0;
-	nodes3[9].functionNode.parameters = children3 + 2;
-	nodes3[9].functionNode.statements = children3 + 4;
-	tests[3].solution.root = nodes3 + 9;
+	CymbNodeIndex children3[] = {3, 5, 4, 6, 9};
+	nodes3[7].functionTypeNode.parameterTypes = (CymbNodeSpan){0, 2};
+	nodes3[10].functionNode.children = (CymbNodeSpan){2, 3};
+	tests[3].solution = (CymbTestTree){nodes3, children3, 10};
 
 	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
 	{
@@ -4114,267 +2266,533 @@ static void cymbTestProgram(CymbTestContext* const context)
 	CymbTreeTest tests[] = {
 		{{
 			.tokens = (CymbToken[]){
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 1},
-						.line = test0String,
-						.hint = {test0String.string + 0, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 5},
-						.line = test0String,
-						.hint = {test0String.string + 4, 9}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 14},
-						.line = test0String,
-						.hint = {test0String.string + 13, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 15},
-						.line = test0String,
-						.hint = {test0String.string + 14, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 16},
-						.line = test0String,
-						.hint = {test0String.string + 15, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 17},
-						.line = test0String,
-						.hint = {test0String.string + 16, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 1},
-					.info = {
-						.position = {1, 24},
-						.line = test0String,
-						.hint = {test0String.string + 23, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 25},
-						.line = test0String,
-						.hint = {test0String.string + 24, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 26},
-						.line = test0String,
-						.hint = {test0String.string + 25, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_INT,
-					.info = {
-						.position = {1, 28},
-						.line = test0String,
-						.hint = {test0String.string + 27, 3}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_IDENTIFIER,
-					.info = {
-						.position = {1, 32},
-						.line = test0String,
-						.hint = {test0String.string + 31, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_PARENTHESIS,
-					.info = {
-						.position = {1, 36},
-						.line = test0String,
-						.hint = {test0String.string + 35, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_VOID,
-					.info = {
-						.position = {1, 37},
-						.line = test0String,
-						.hint = {test0String.string + 36, 4}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_PARENTHESIS,
-					.info = {
-						.position = {1, 41},
-						.line = test0String,
-						.hint = {test0String.string + 40, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_OPEN_BRACE,
-					.info = {
-						.position = {1, 42},
-						.line = test0String,
-						.hint = {test0String.string + 41, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_RETURN,
-					.info = {
-						.position = {1, 43},
-						.line = test0String,
-						.hint = {test0String.string + 42, 6}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CONSTANT,
-					.constant = {CYMB_CONSTANT_INT, 0},
-					.info = {
-						.position = {1, 50},
-						.line = test0String,
-						.hint = {test0String.string + 49, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_SEMICOLON,
-					.info = {
-						.position = {1, 51},
-						.line = test0String,
-						.hint = {test0String.string + 50, 1}
-					}
-				},
-				{
-					.type = CYMB_TOKEN_CLOSE_BRACE,
-					.info = {
-						.position = {1, 52},
-						.line = test0String,
-						.hint = {test0String.string + 51, 1}
-					}
-				}
-			},
-			.count = 19
-		}, CYMB_SUCCESS, {}, {}, 19}
+				{.type = CYMB_TOKEN_INT, .offset = 0, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 4, .length = 9},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 13, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 14, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 15, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 16, .length = 6},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 23, .length = 1, .constant = 0},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 24, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 25, .length = 1},
+				{.type = CYMB_TOKEN_INT, .offset = 27, .length = 3},
+				{.type = CYMB_TOKEN_IDENTIFIER, .offset = 31, .length = 4},
+				{.type = CYMB_TOKEN_OPEN_PARENTHESIS, .offset = 35, .length = 1},
+				{.type = CYMB_TOKEN_VOID, .offset = 36, .length = 4},
+				{.type = CYMB_TOKEN_CLOSE_PARENTHESIS, .offset = 40, .length = 1},
+				{.type = CYMB_TOKEN_OPEN_BRACE, .offset = 41, .length = 1},
+				{.type = CYMB_TOKEN_RETURN, .offset = 42, .length = 6},
+				{.type = CYMB_TOKEN_CONSTANT, .offset = 49, .length = 1, .constant = 1},
+				{.type = CYMB_TOKEN_SEMICOLON, .offset = 50, .length = 1},
+				{.type = CYMB_TOKEN_CLOSE_BRACE, .offset = 51, .length = 1}
+			},
+			.count = 19,
+			.constants = (CymbConstant[]){{CYMB_CONSTANT_INT, 1}, {CYMB_CONSTANT_INT, 0}}
+		}, CYMB_SUCCESS, {}, {}, 19, test0String.string}
 	};
 	constexpr size_t testCount = CYMB_LENGTH(tests);
 
 	CymbNode nodes0[] = {
+		{},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[0].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_TYPE,
 			.functionTypeNode = {
-				.returnType = &nodes0[0]
+				.returnType = 1
 			},
-			.info = tests[0].tokens.tokens[0].info
+			.token = 0
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[0].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 1},
-			.info = tests[0].tokens.tokens[6].info
+			.token = 6
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = &nodes0[3],
-			.info = tests[0].tokens.tokens[5].info
+			.returnNode = 4,
+			.token = 5
 		},
 		{
 			.type = CYMB_NODE_FUNCTION,
 			.functionNode = {
-				.type = &nodes0[1],
-				.name = &nodes0[2]
+				.type = 2,
+				.name = 3
 			},
-			.info = tests[0].tokens.tokens[1].info
+			.token = 1
 		},
 		{
 			.type = CYMB_NODE_TYPE,
 			.typeNode = {.type = CYMB_TYPE_INT},
-			.info = tests[0].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_FUNCTION_TYPE,
 			.functionTypeNode = {
-				.returnType = &nodes0[6]
+				.returnType = 7
 			},
-			.info = tests[0].tokens.tokens[9].info
+			.token = 9
 		},
 		{
 			.type = CYMB_NODE_IDENTIFIER,
-			.info = tests[0].tokens.tokens[10].info
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_CONSTANT,
 			.constantNode = {CYMB_CONSTANT_INT, 0},
-			.info = tests[0].tokens.tokens[16].info
+			.token = 16
 		},
 		{
 			.type = CYMB_NODE_RETURN,
-			.returnNode = &nodes0[9],
-			.info = tests[0].tokens.tokens[15].info
+			.returnNode = 10,
+			.token = 15
 		},
 		{
 			.type = CYMB_NODE_FUNCTION,
 			.functionNode = {
-				.type = &nodes0[7],
-				.name = &nodes0[8]
+				.type = 8,
+				.name = 9
 			},
-			.info = tests[0].tokens.tokens[10].info
+			.token = 10
 		},
 		{
 			.type = CYMB_NODE_PROGRAM,
 			.programNode = {}
 		}
 	};
-	CymbNodeChild children0[] = {
+	CymbNodeIndex children0[] = {5, 11, 6, 12};
+	nodes0[6].functionNode.children = (CymbNodeSpan){0, 1};
+	nodes0[12].functionNode.children = (CymbNodeSpan){1, 1};
+	nodes0[13].programNode.children = (CymbNodeSpan){2, 2};
+	tests[0].solution = (CymbTestTree){nodes0, children0, 13};
+
+	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
+	{
+		cymbContextSetIndex(context, testIndex);
+
+		cymbDoTreeTest(&tests[testIndex], cymbParseProgram, context);
+	}
+
+	cymbContextPop(context);
+}
+
+static void cymbTestParseParallel(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	constexpr size_t functionCount = 4000;
+	constexpr size_t functionCapacity = 160;
+
+	// A valid program, one with an invalid function in the middle and one whose last function is unmatched.
+	const struct
+	{
+		const char* broken;
+		size_t brokenIndex;
+		CymbResult result;
+	} sources[] = {
+		{nullptr, 0, CYMB_SUCCESS},
+		{"int broken(int a)\n{\n\ta = ;\n}\n", functionCount / 2, CYMB_INVALID},
+		{"int broken(int a)\n{\n\treturn a;\n", functionCount - 1, CYMB_INVALID}
+	};
+	constexpr size_t sourceCount = CYMB_LENGTH(sources);
+
+	const unsigned int threadCounts[] = {2, 3, 8};
+	constexpr size_t threadCountCount = CYMB_LENGTH(threadCounts);
+
+	char* const string = malloc(functionCount * functionCapacity + 1);
+	if(!string)
+	{
+		cymbFail(context, "Failed to allocate the source.");
+		goto end;
+	}
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbDiagnosticList serialDiagnostics;
+	cymbDiagnosticListCreate(&serialDiagnostics, &context->arena, "cymb_test", 4);
+
+	for(size_t sourceIndex = 0; sourceIndex < sourceCount; ++sourceIndex)
+	{
+		size_t length = 0;
+		for(size_t functionIndex = 0; functionIndex < functionCount; ++functionIndex)
 		{
-			.node = &nodes0[4]
-		},
+			if(sources[sourceIndex].broken && functionIndex == sources[sourceIndex].brokenIndex)
+			{
+				length += snprintf(string + length, functionCapacity, "%s", sources[sourceIndex].broken);
+				continue;
+			}
+
+			length += snprintf(
+				string + length,
+				functionCapacity,
+				"int f%zu(int a, char* b)\n{\n\tint c = a * %zu + b[a];\n\twhile(c > 0) c -= f%zu(a, b);\n\treturn -c;\n}\n",
+				functionIndex, functionIndex, functionIndex / 2
+			);
+		}
+
+		cymbDiagnosticListSetSource(&serialDiagnostics, string);
+		cymbDiagnosticListSetSource(&context->diagnostics, string);
+
+		CymbTokenList tokens;
+		if(cymbLex(string, CYMB_C23, nullptr, &tokens, &context->diagnostics) != CYMB_SUCCESS)
 		{
-			.node = &nodes0[10]
-		},
+			cymbFail(context, "Wrong lex result.");
+			cymbDiagnosticListFree(&context->diagnostics);
+			continue;
+		}
+
+		CymbTree serialTree;
+		const CymbResult serialResult = cymbParse(&tokens, &serialTree, &serialDiagnostics);
+		if(serialResult != sources[sourceIndex].result)
 		{
-			.node = &nodes0[5],
-			.next = &children0[3]
-		},
+			cymbFail(context, "Wrong serial result.");
+			goto next;
+		}
+
+		for(size_t threadIndex = 0; threadIndex < threadCountCount; ++threadIndex)
 		{
-			.node = &nodes0[11]
+			cymbContextSetIndex(context, sourceIndex * threadCountCount + threadIndex);
+
+			CymbTree tree;
+			const CymbResult result = cymbParseParallel(&tokens, threadCounts[threadIndex], &tree, &context->diagnostics);
+			if(result != serialResult)
+			{
+				cymbFail(context, "Wrong result.");
+			}
+			else if(result == CYMB_SUCCESS)
+			{
+				if(tree.nodes.count != serialTree.nodes.count || tree.children.count != serialTree.children.count || tree.nodeCount != serialTree.nodeCount)
+				{
+					cymbFail(context, "Wrong node count.");
+				}
+				else
+				{
+					cymbCompareTrees(&(CymbTestTree){tree.nodes.data, tree.children.data, tree.root}, &(CymbTestTree){serialTree.nodes.data, serialTree.children.data, serialTree.root}, context);
+				}
+
+				cymbFreeTree(&tree);
+			}
+
+			cymbCompareDiagnostics(&context->diagnostics, &serialDiagnostics, context);
+			cymbDiagnosticListFree(&context->diagnostics);
 		}
+
+		cymbFreeTree(&serialTree);
+
+		next:
+		cymbDiagnosticListFree(&serialDiagnostics);
+		cymbFreeTokenList(&tokens);
+	}
+
+	cymbArenaRestore(&context->arena, save);
+	free(string);
+
+	end:
+	cymbContextPop(context);
+}
+
+static void cymbTestReparse(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	const char* const source =
+		"int a(int x)\n{\n\treturn x + 1;\n}\n\n"
+		"unsigned int b(void)\n{\n\tint y = 2;\n\treturn y;\n}\n\n"
+		"int c(int z)\n{\n\twhile(z) z = z - 1;\n\treturn z;\n}\n";
+
+	// Each edit replaces a part of the source, reduced to the characters which change.
+	const struct
+	{
+		const char* target;
+		const char* replacement;
+	} tests[] = {
+		{"x + 1", "x + 23"},
+		{"int y", "int yy"},
+		{"int y = 2;", "int y = 2;\n\ty = y * 3;"},
+		{"}\n\nunsigned", "}\n\nint n(void)\n{\n\treturn 0;\n}\n\nunsigned"},
+		{"unsigned int b(void)\n{\n\tint y = 2;\n\treturn y;\n}\n\n", ""},
+		{"int a", "  int a"},
+		{"return z;\n}\n", "return z;\n}\nint d(void)\n{\n\treturn 4;\n}\n"},
+		{"return y;", "return y +;"},
+		{"return x + 1;\n}", "return x + 1;\n"},
+		{"int c(int z)", "/* int c(int z)"},
+		{"int y = 2;", "int y = 2; /*"},
+		{"int b(void)\n{\n\tint y = 2;\n\treturn y;\n}", ""}
 	};
-	nodes0[5].functionNode.statements = children0 + 0;
-	nodes0[11].functionNode.statements = children0 + 1;
-	nodes0[12].programNode.children = children0 + 2;
-	tests[0].solution.root = nodes0 + 12;
+	constexpr size_t testCount = CYMB_LENGTH(tests);
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbDiagnosticList solutionDiagnostics;
+	cymbDiagnosticListCreate(&solutionDiagnostics, &context->arena, "cymb_test", 4);
 
 	for(size_t testIndex = 0; testIndex < testCount; ++testIndex)
 	{
 		cymbContextSetIndex(context, testIndex);
 
-		cymbDoTreeTest(&tests[testIndex], cymbParseProgram, context);
+		const char* const target = strstr(source, tests[testIndex].target);
+		const size_t targetLength = strlen(tests[testIndex].target);
+		const size_t replacementLength = strlen(tests[testIndex].replacement);
+
+		char string[256];
+		snprintf(string, sizeof(string), "%.*s%s%s", (int)(target - source), source, tests[testIndex].replacement, target + targetLength);
+
+		size_t prefix = 0;
+		while(prefix < targetLength && prefix < replacementLength && target[prefix] == tests[testIndex].replacement[prefix])
+		{
+			++prefix;
+		}
+		size_t suffix = 0;
+		while(suffix < targetLength - prefix && suffix < replacementLength - prefix && target[targetLength - suffix - 1] == tests[testIndex].replacement[replacementLength - suffix - 1])
+		{
+			++suffix;
+		}
+		const CymbEdit edit = {
+			.offset = target - source + prefix,
+			.removedLength = targetLength - prefix - suffix,
+			.insertedLength = replacementLength - prefix - suffix
+		};
+
+		CymbTokenList tokens;
+		CymbTree tree;
+		if(cymbLex(source, CYMB_C23, nullptr, &tokens, &context->diagnostics) != CYMB_SUCCESS || cymbParse(&tokens, &tree, &context->diagnostics) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Wrong previous result.");
+			goto end;
+		}
+
+		CymbTokenList solutionTokens;
+		CymbTree solutionTree = {};
+		CymbResult solutionResult = cymbLex(string, CYMB_C23, nullptr, &solutionTokens, &solutionDiagnostics);
+		const CymbResult parseResult = cymbParse(&solutionTokens, &solutionTree, &solutionDiagnostics);
+		if(parseResult != CYMB_SUCCESS)
+		{
+			solutionResult = parseResult;
+		}
+
+		const CymbResult result = cymbReparse(string, CYMB_C23, &edit, nullptr, &tokens, &tree, &context->diagnostics);
+		if(result != solutionResult)
+		{
+			cymbFail(context, "Wrong result.");
+			goto next;
+		}
+
+		cymbCompareDiagnostics(&context->diagnostics, &solutionDiagnostics, context);
+
+		if(tokens.count != solutionTokens.count)
+		{
+			cymbFail(context, "Wrong token count.");
+			goto next;
+		}
+
+		for(size_t tokenIndex = 0; tokenIndex < tokens.count; ++tokenIndex)
+		{
+			const CymbToken* const token = &tokens.tokens[tokenIndex];
+			const CymbToken* const solution = &solutionTokens.tokens[tokenIndex];
+
+			// Constants reuse the slots of the replaced ones, so only their values are compared.
+			if(token->type != solution->type || token->offset != solution->offset || token->length != solution->length || (token->type != CYMB_TOKEN_CONSTANT && token->partner != solution->partner))
+			{
+				cymbFail(context, "Wrong token.");
+				break;
+			}
+
+			if(token->type == CYMB_TOKEN_CONSTANT && tokens.constants[token->constant].value != solutionTokens.constants[solution->constant].value)
+			{
+				cymbFail(context, "Wrong constant.");
+				break;
+			}
+		}
+
+		if(tree.root != solutionTree.root || tree.nodes.count != solutionTree.nodes.count || tree.children.count != solutionTree.children.count || tree.nodeCount != solutionTree.nodeCount)
+		{
+			cymbFail(context, "Wrong node count.");
+		}
+		else if(result == CYMB_SUCCESS)
+		{
+			cymbCompareTrees(&(CymbTestTree){tree.nodes.data, tree.children.data, tree.root}, &(CymbTestTree){solutionTree.nodes.data, solutionTree.children.data, solutionTree.root}, context);
+		}
+
+		next:
+		cymbFreeTree(&solutionTree);
+		cymbFreeTokenList(&solutionTokens);
+		cymbFreeTree(&tree);
+		cymbFreeTokenList(&tokens);
+		cymbDiagnosticListFree(&solutionDiagnostics);
+		cymbDiagnosticListFree(&context->diagnostics);
+	}
+
+	end:
+	cymbDiagnosticListFree(&context->diagnostics);
+	cymbArenaRestore(&context->arena, save);
+
+	cymbContextPop(context);
+}
+
+static void cymbTestReparseKeystrokes(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	char string[256] =
+		"int a(int x)\n{\n\treturn x + 1;\n}\n\n"
+		"int b(void)\n{\n\treturn 2 * a(3);\n}\n";
+	const size_t offset = strstr(string, "1;") - string + 1;
+	const char* const typed = "234567";
+	const size_t typedLength = strlen(typed);
+
+	CymbTokenList tokens;
+	CymbTree tree = {};
+	CymbTokenList solutionTokens = {};
+	CymbTree solutionTree = {};
+	if(cymbLex(string, CYMB_C23, nullptr, &tokens, &context->diagnostics) != CYMB_SUCCESS || cymbParse(&tokens, &tree, &context->diagnostics) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Wrong previous result.");
+		goto end;
+	}
+
+	// Digits are typed one at a time and then erased, each edit reusing the result of the previous one.
+	for(size_t step = 0; step < 2 * typedLength; ++step)
+	{
+		cymbContextSetIndex(context, step);
+
+		const bool typing = step < typedLength;
+		const size_t position = typing ? offset + step : offset + 2 * typedLength - step - 1;
+		memmove(string + position + typing, string + position + !typing, strlen(string + position + !typing) + 1);
+		if(typing)
+		{
+			string[position] = typed[step];
+		}
+
+		const CymbEdit edit = {
+			.offset = position,
+			.removedLength = !typing,
+			.insertedLength = typing
+		};
+		if(cymbReparse(string, CYMB_C23, &edit, nullptr, &tokens, &tree, &context->diagnostics) != CYMB_SUCCESS)
+		{
+			cymbFail(context, "Wrong result.");
+			goto end;
+		}
 	}
 
+	if(cymbLex(string, CYMB_C23, nullptr, &solutionTokens, &context->diagnostics) != CYMB_SUCCESS || cymbParse(&solutionTokens, &solutionTree, &context->diagnostics) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Wrong solution result.");
+		goto end;
+	}
+
+	// The constants of the edited function are replaced in place rather than appended.
+	if(tokens.count != solutionTokens.count || tokens.constantCount != solutionTokens.constantCount)
+	{
+		cymbFail(context, "Wrong token count.");
+	}
+	else if(tree.nodes.count != solutionTree.nodes.count || tree.children.count != solutionTree.children.count)
+	{
+		cymbFail(context, "Wrong node count.");
+	}
+	else
+	{
+		cymbCompareTrees(&(CymbTestTree){tree.nodes.data, tree.children.data, tree.root}, &(CymbTestTree){solutionTree.nodes.data, solutionTree.children.data, solutionTree.root}, context);
+	}
+
+	end:
+	cymbFreeTree(&solutionTree);
+	cymbFreeTokenList(&solutionTokens);
+	cymbFreeTree(&tree);
+	cymbFreeTokenList(&tokens);
+	cymbDiagnosticListFree(&context->diagnostics);
+
+	cymbContextPop(context);
+}
+
+static void cymbTestReparseInvalid(CymbTestContext* const context)
+{
+	cymbContextPush(context, __func__);
+
+	char string[] =
+		"int a(void)\n{\n\treturn @1;\n}\n\n"
+		"int b(void)\n{\n\treturn 2;\n}\n";
+	const size_t offset = strstr(string, "2;") - string;
+	const char* const typed = "345";
+
+	const CymbArenaSave save = cymbArenaSave(&context->arena);
+
+	CymbDiagnosticList solutionDiagnostics;
+	cymbDiagnosticListCreate(&solutionDiagnostics, &context->arena, "cymb_test", 4);
+
+	CymbTokenList tokens;
+	CymbTree tree = {};
+	CymbTokenList solutionTokens = {};
+	CymbTree solutionTree = {};
+	if(cymbLex(string, CYMB_C23, nullptr, &tokens, &context->diagnostics) != CYMB_INVALID || cymbParse(&tokens, &tree, &context->diagnostics) != CYMB_SUCCESS)
+	{
+		cymbFail(context, "Wrong previous result.");
+		goto end;
+	}
+	cymbDiagnosticListFree(&context->diagnostics);
+
+	// The constant of the second function is edited repeatedly, the error of the first one having to be reported each time.
+	for(size_t step = 0; typed[step] != '\0'; ++step)
+	{
+		cymbContextSetIndex(context, step);
+
+		string[offset] = typed[step];
+
+		const CymbEdit edit = {
+			.offset = offset,
+			.removedLength = 1,
+			.insertedLength = 1
+		};
+		const CymbResult result = cymbReparse(string, CYMB_C23, &edit, nullptr, &tokens, &tree, &context->diagnostics);
+
+		CymbResult solutionResult = cymbLex(string, CYMB_C23, nullptr, &solutionTokens, &solutionDiagnostics);
+		const CymbResult parseResult = cymbParse(&solutionTokens, &solutionTree, &solutionDiagnostics);
+		if(parseResult != CYMB_SUCCESS)
+		{
+			solutionResult = parseResult;
+		}
+
+		if(result != solutionResult)
+		{
+			cymbFail(context, "Wrong result.");
+		}
+		else
+		{
+			cymbCompareDiagnostics(&context->diagnostics, &solutionDiagnostics, context);
+		}
+
+		if(tokens.count != solutionTokens.count)
+		{
+			cymbFail(context, "Wrong token count.");
+		}
+		else if(tree.nodes.count != solutionTree.nodes.count || tree.children.count != solutionTree.children.count)
+		{
+			cymbFail(context, "Wrong node count.");
+		}
+		else
+		{
+			cymbCompareTrees(&(CymbTestTree){tree.nodes.data, tree.children.data, tree.root}, &(CymbTestTree){solutionTree.nodes.data, solutionTree.children.data, solutionTree.root}, context);
+		}
+
+		cymbFreeTree(&solutionTree);
+		cymbFreeTokenList(&solutionTokens);
+		cymbDiagnosticListFree(&solutionDiagnostics);
+		cymbDiagnosticListFree(&context->diagnostics);
+	}
+
+	end:
+	cymbFreeTree(&tree);
+	cymbFreeTokenList(&tokens);
+	cymbDiagnosticListFree(&context->diagnostics);
+	cymbArenaRestore(&context->arena, save);
+
 	cymbContextPop(context);
 }
 
@@ -4382,8 +2800,13 @@ void cymbTestTrees(CymbTestContext* const context)
 {
 	cymbTestParentheses(context);
 	cymbTestExpressions(context);
+	cymbTestLongExpressions(context);
 	cymbTestTypes(context);
 	cymbTestStatements(context);
 	cymbTestFunctions(context);
 	cymbTestProgram(context);
+	cymbTestParseParallel(context);
+	cymbTestReparse(context);
+	cymbTestReparseKeystrokes(context);
+	cymbTestReparseInvalid(context);
 }